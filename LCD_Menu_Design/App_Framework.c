@@ -0,0 +1,161 @@
+/**
+ * @file App_Framework.c
+ *
+ * @brief Source code for the App_Framework module.
+ *
+ * This file contains the function definitions for the App_Framework module.
+ * The acquired peripherals are tracked in a bit mask, so a switch only calls the
+ * acquire and release functions of the peripherals that change hands.
+ */
+
+#include "App_Framework.h"
+#include "Boot_Sequencer.h"
+#include <string.h>
+
+volatile uint32_t App_Switches = 0;
+volatile uint32_t App_Switch_us = 0;
+
+static const App_Peripheral *app_peripherals = 0;
+static uint8_t num_app_peripherals = 0;
+
+static const App *app_table = 0;
+static uint8_t num_apps = 0;
+
+static int8_t current_app = -1;
+
+// Peripherals that have been acquired and not released since
+static uint32_t acquired_peripherals = 0;
+
+// Checks that no two peripherals of the mask own the same pin
+static uint8_t App_Pins_Available(uint32_t peripherals)
+{
+	uint32_t pins = 0;
+
+	for (uint8_t i = 0; i < num_app_peripherals; i++)
+	{
+		if (peripherals & APP_PERIPHERAL(i))
+		{
+			if (pins & app_peripherals[i].pins) return 0;
+
+			pins |= app_peripherals[i].pins;
+		}
+	}
+
+	return 1;
+}
+
+void App_Framework_Init(const App_Peripheral *peripherals, uint8_t num_peripherals,
+                        const App *apps, uint8_t count, uint32_t acquired)
+{
+	if (num_peripherals > APP_MAX_PERIPHERALS)
+	{
+		num_peripherals = APP_MAX_PERIPHERALS;
+	}
+
+	app_peripherals = peripherals;
+	num_app_peripherals = num_peripherals;
+	app_table = apps;
+	num_apps = count;
+	current_app = -1;
+	acquired_peripherals = acquired;
+}
+
+uint8_t App_Framework_Switch(uint8_t index)
+{
+	if (index >= num_apps) return 0;
+
+	const App *next = &app_table[index];
+
+	if (!App_Pins_Available(next->peripherals)) return 0;
+
+	uint32_t start_us = Boot_Micros();
+
+	if ((current_app >= 0) && (app_table[current_app].teardown != 0))
+	{
+		app_table[current_app].teardown();
+	}
+
+	current_app = -1;
+
+	// Release the peripherals that the next application does not use before any
+	// peripheral is acquired, so that the pins that they own are free again
+	uint32_t release = acquired_peripherals & ~next->peripherals;
+
+	for (uint8_t i = 0; i < num_app_peripherals; i++)
+	{
+		if ((release & APP_PERIPHERAL(i)) && (app_peripherals[i].release != 0))
+		{
+			app_peripherals[i].release();
+		}
+	}
+
+	acquired_peripherals &= ~release;
+
+	// Acquire the peripherals that the previous application did not use
+	uint32_t acquire = next->peripherals & ~acquired_peripherals;
+
+	for (uint8_t i = 0; i < num_app_peripherals; i++)
+	{
+		if ((acquire & APP_PERIPHERAL(i)) && (app_peripherals[i].acquire != 0))
+		{
+			app_peripherals[i].acquire();
+		}
+	}
+
+	acquired_peripherals = next->peripherals;
+	current_app = (int8_t)index;
+
+	if (next->init != 0)
+	{
+		next->init();
+	}
+
+	App_Switch_us = Boot_Micros() - start_us;
+	App_Switches++;
+
+	return 1;
+}
+
+int8_t App_Framework_Find(const char *name)
+{
+	for (uint8_t i = 0; i < num_apps; i++)
+	{
+		if (strcmp(app_table[i].name, name) == 0)
+		{
+			return (int8_t)i;
+		}
+	}
+
+	return -1;
+}
+
+int8_t App_Framework_Current(void)
+{
+	return current_app;
+}
+
+const App *App_Framework_App(uint8_t index)
+{
+	return (index < num_apps) ? &app_table[index] : 0;
+}
+
+uint8_t App_Framework_Count(void)
+{
+	return num_apps;
+}
+
+void App_Framework_Run(uint32_t now_ms)
+{
+	if ((current_app >= 0) && (app_table[current_app].run != 0))
+	{
+		app_table[current_app].run(now_ms);
+	}
+}
+
+void App_Framework_Input(const Input_Event *event)
+{
+	if ((current_app >= 0) && (app_table[current_app].input != 0))
+	{
+		app_table[current_app].input(event);
+	}
+}
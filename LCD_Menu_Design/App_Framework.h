@@ -0,0 +1,168 @@
+/**
+ * @file App_Framework.h
+ *
+ * @brief Header file for the App_Framework module.
+ *
+ * This file contains the function definitions for the App_Framework module.
+ * It runs one of several applications at a time on the same hardware, and switches
+ * between them at runtime without a reset.
+ *
+ * The shared hardware is described by a table of peripherals. Each peripheral owns a set
+ * of pins (see APP_PIN values) and has an acquire function, which configures it, and a
+ * release function, which leaves it idle so that its pins can be used by another peripheral.
+ * Two peripherals may own the same pins (e.g. the LCD data lines and the PMOD BTN
+ * both use PA2 to PA5), but an application cannot use both of them.
+ *
+ * Each application declares the peripherals that it uses, and has these hooks:
+ *  - init      Called once the peripherals have been acquired, to draw the first screen
+ *  - run       Called on every pass of the main loop with the current time
+ *  - input     Called with each input event delivered by the Input_Event queue
+ *  - teardown  Called before the peripherals are switched to the next application
+ *
+ * A switch only releases the peripherals that the next application does not use, and
+ * only acquires the ones that the previous application did not use, so the peripherals
+ * shared by both applications keep running untouched.
+ */
+
+#ifndef APP_FRAMEWORK_H
+#define APP_FRAMEWORK_H
+
+#include "TM4C123GH6PM.h"
+#include "Input_Event.h"
+
+// Maximum number of peripherals in the table (one bit of an application's peripheral mask each)
+#define APP_MAX_PERIPHERALS 32
+
+// Pins owned by the peripherals
+#define APP_PINS_PA2_PA5 0x00000001
+#define APP_PIN_PC4      0x00000002
+#define APP_PIN_PC6      0x00000004
+#define APP_PIN_PC7      0x00000008
+#define APP_PIN_PE0      0x00000010
+#define APP_PINS_PB0_PB3 0x00000020
+#define APP_PIN_PB4      0x00000040
+#define APP_PIN_PB7      0x00000080
+#define APP_PIN_PF1      0x00000100
+#define APP_PIN_PF2      0x00000200
+#define APP_PIN_PF3      0x00000400
+#define APP_PIN_PB6      0x00000800
+
+// Bit of a peripheral in an application's peripheral mask, from its index in the table
+#define APP_PERIPHERAL(index) (1UL << (index))
+
+typedef struct
+{
+	const char *name;
+	uint32_t pins;
+	void (*acquire)(void);
+	void (*release)(void);
+} App_Peripheral;
+
+typedef struct
+{
+	const char *name;
+	uint32_t peripherals;
+	void (*init)(void);
+	void (*run)(uint32_t now_ms);
+	void (*input)(const Input_Event *event);
+	void (*teardown)(void);
+} App;
+
+// Number of switches, and the duration of the last one in microseconds
+extern volatile uint32_t App_Switches;
+extern volatile uint32_t App_Switch_us;
+
+/**
+ * @brief Registers the peripherals and the applications.
+ *
+ * No application is running until App_Framework_Switch is called. The tables must stay in memory.
+ *
+ * @param peripherals A pointer to the table of peripherals.
+ *
+ * @param num_peripherals The number of peripherals (up to APP_MAX_PERIPHERALS).
+ *
+ * @param apps A pointer to the table of applications.
+ *
+ * @param num_apps The number of applications.
+ *
+ * @param acquired The peripherals that have already been configured during the boot.
+ *                 They are not acquired again by the first switch.
+ *
+ * @return None
+ */
+void App_Framework_Init(const App_Peripheral *peripherals, uint8_t num_peripherals,
+                        const App *apps, uint8_t num_apps, uint32_t acquired);
+
+/**
+ * @brief Stops the current application and starts another one.
+ *
+ * The current application is torn down, the peripherals that the next application does
+ * not use are released, the peripherals that it needs are acquired, and it is initialized.
+ * This function must be called from the main loop (e.g. from an input hook).
+ *
+ * @param index The index of the application in the table.
+ *
+ * @return 1 if the application was started, or 0 if the index is out of range or
+ *         the application uses two peripherals that own the same pins.
+ */
+uint8_t App_Framework_Switch(uint8_t index);
+
+/**
+ * @brief Finds an application by name.
+ *
+ * @param name The name of the application.
+ *
+ * @return The index of the application, or -1 if there is no such application.
+ */
+int8_t App_Framework_Find(const char *name);
+
+/**
+ * @brief Returns the index of the current application.
+ *
+ * @param None
+ *
+ * @return The index of the application, or -1 if no application has been started.
+ */
+int8_t App_Framework_Current(void);
+
+/**
+ * @brief Returns an application of the table.
+ *
+ * @param index The index of the application.
+ *
+ * @return A pointer to the application, or 0 if the index is out of range.
+ */
+const App *App_Framework_App(uint8_t index);
+
+/**
+ * @brief Returns the number of applications.
+ *
+ * @param None
+ *
+ * @return The number of applications in the table.
+ */
+uint8_t App_Framework_Count(void);
+
+/**
+ * @brief Runs the current application.
+ *
+ * This function is called on every pass of the main loop.
+ *
+ * @param now_ms The current time in milliseconds.
+ *
+ * @return None
+ */
+void App_Framework_Run(uint32_t now_ms);
+
+/**
+ * @brief Delivers an input event to the current application.
+ *
+ * This function can be subscribed to the Input_Event queue.
+ *
+ * @param event A pointer to the event.
+ *
+ * @return None
+ */
+void App_Framework_Input(const Input_Event *event);
+
+#endif
@@ -0,0 +1,166 @@
+/**
+ * @file Audio_Input.c
+ *
+ * @brief Source code for the Audio_Input driver.
+ *
+ * This file contains the function definitions for the Audio_Input driver.
+ * It configures a GPTM timer, ADC0 and the µDMA for continuous sampling, and runs
+ * the Goertzel detector on every completed block.
+ */
+
+#include "Audio_Input.h"
+#include "Goertzel.h"
+#include "uDMA.h"
+#include "GPTM.h"
+#include "Trace_Recorder.h"
+#include "Interrupt_Config.h"
+
+// µDMA channel used by ADC0 sample sequencer 3
+#define AUDIO_DMA_CHANNEL (UDMA_ADC0_SS3 & 0x1F)
+
+// Analog input channel of PE5
+#define AUDIO_AIN 8
+
+static uint16_t audio_buffers[2][AUDIO_BLOCK_SIZE];
+static Goertzel_Detector detector;
+
+// Number of blocks since the last tone change
+static uint32_t blocks_since_change = 0;
+
+volatile uint32_t Audio_Blocks = 0;
+volatile uint32_t Audio_Overruns = 0;
+volatile uint32_t Audio_Cycles_Last = 0;
+volatile uint32_t Audio_Cycles_Max = 0;
+
+static void Audio_Process_Block(const uint16_t *samples)
+{
+	uint32_t start = DWT->CYCCNT;
+
+	uint8_t previous_tone = detector.tone;
+	uint8_t tone = Goertzel_Detect(&detector, samples);
+
+	blocks_since_change++;
+
+	if (tone != previous_tone)
+	{
+		int32_t duration_ms = (int32_t)((blocks_since_change * AUDIO_BLOCK_SIZE * 1000) / AUDIO_SAMPLE_RATE);
+
+		Input_Event_Post(INPUT_SOURCE_AUDIO, AUDIO_TONE, tone ? INPUT_EVENT_PRESS : INPUT_EVENT_RELEASE,
+		                 tone ? 0 : duration_ms);
+
+		blocks_since_change = 0;
+	}
+
+	Audio_Blocks = Audio_Blocks + 1;
+
+	uint32_t cycles = DWT->CYCCNT - start;
+	Audio_Cycles_Last = cycles;
+
+	if (cycles > Audio_Cycles_Max)
+	{
+		Audio_Cycles_Max = cycles;
+	}
+}
+
+static void Audio_Block_Complete(uint8_t channel, uint8_t completed)
+{
+	// A full buffer has already been re-armed by the uDMA driver, and its
+	// samples are processed while the µDMA fills the other buffer
+	if (completed & UDMA_PRIMARY)
+	{
+		Audio_Process_Block(audio_buffers[0]);
+	}
+
+	if (completed & UDMA_ALTERNATE)
+	{
+		Audio_Process_Block(audio_buffers[1]);
+	}
+
+	// The channel was stopped when both buffers were full, so samples were lost
+	if (completed == (UDMA_PRIMARY | UDMA_ALTERNATE))
+	{
+		Audio_Overruns = Audio_Overruns + 1;
+	}
+}
+
+void Audio_Input_Init(uint32_t tone_hz)
+{
+	Goertzel_Init(&detector, tone_hz, AUDIO_SAMPLE_RATE, AUDIO_BLOCK_SIZE);
+
+	// Enable the DWT cycle counter used to measure the processing time
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	// Enable the clocks to ADC0 and Port E
+	SYSCTL->RCGCADC |= 0x01;
+	SYSCTL->RCGCGPIO |= 0x10;
+	while ((SYSCTL->PRADC & 0x01) == 0);
+
+	// Configure PE5 as an analog input by setting Bit 5 in the AFSEL
+	// and AMSEL registers and clearing it in the DIR and DEN registers
+	GPIOE->DIR &= ~0x20;
+	GPIOE->AFSEL |= 0x20;
+	GPIOE->DEN &= ~0x20;
+	GPIOE->AMSEL |= 0x20;
+
+	// Disable sample sequencer 3 by clearing the ASEN3 bit (Bit 3) in the ADCACTSS register
+	ADC0->ACTSS &= ~0x08;
+
+	// Select the timer as the trigger of sample sequencer 3
+	// by writing 0x5 to the EM3 field (Bits 15 to 12) in the ADCEMUX register
+	ADC0->EMUX = (ADC0->EMUX & ~0x0000F000) | 0x00005000;
+
+	// Sample AIN8 and end the sequence after the first sample (END0, Bit 1).
+	// The IE0 bit (Bit 2) makes every conversion request a µDMA transfer.
+	ADC0->SSMUX3 = AUDIO_AIN;
+	ADC0->SSCTL3 = 0x06;
+
+	// Claim channel 17 for ADC0 sample sequencer 3 at high priority, since a lost
+	// request loses a sample, and fill the two buffers in turn from the FIFO
+	uDMA_Claim(UDMA_ADC0_SS3, UDMA_HIGH_PRIORITY, &Audio_Block_Complete);
+	uDMA_Ping_Pong(AUDIO_DMA_CHANNEL, &ADC0->SSFIFO3, audio_buffers[0], audio_buffers[1],
+	               AUDIO_BLOCK_SIZE, UDMA_SIZE_16 | UDMA_SOURCE_FIXED);
+
+	// Enable sample sequencer 3
+	ADC0->ISC = 0x08;
+	ADC0->ACTSS |= 0x08;
+
+	// The µDMA completion interrupt is signalled on the ADC0 sample sequencer 3 vector
+	Interrupt_Config_Enable(INTERRUPT_AUDIO);
+
+	// Trigger the ADC at the sample rate from any free 32-bit periodic timer, without interrupts
+	int8_t timer = GPTM_Allocate(GPTM_CONCATENATE);
+
+	if (timer >= 0)
+	{
+		GPTM_Start_Periodic((uint8_t)timer, AUDIO_SAMPLE_RATE, 0, INTERRUPT_AUDIO);
+		GPTM_Enable_ADC_Trigger((uint8_t)timer);
+	}
+}
+
+void Audio_Input_Set_Tone(uint32_t tone_hz)
+{
+	uint32_t basepri = Interrupt_Lock(INTERRUPT_LEVEL_AUDIO);
+
+	Goertzel_Init(&detector, tone_hz, AUDIO_SAMPLE_RATE, AUDIO_BLOCK_SIZE);
+
+	Interrupt_Unlock(INTERRUPT_LEVEL_AUDIO, basepri);
+}
+
+uint8_t Audio_Input_Tone(void)
+{
+	return detector.tone;
+}
+
+void ADC0SS3_Handler(void)
+{
+	TRACE_ISR_ENTER(ADC0SS3_IRQn);
+
+	// The completion of the µDMA channel is signalled on this vector
+	uDMA_Interrupt(AUDIO_DMA_CHANNEL);
+
+	// Clear the sample sequencer 3 interrupt status
+	ADC0->ISC = 0x08;
+
+	TRACE_ISR_EXIT(ADC0SS3_IRQn);
+}
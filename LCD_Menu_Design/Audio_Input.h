@@ -0,0 +1,84 @@
+/**
+ * @file Audio_Input.h
+ *
+ * @brief Header file for the Audio_Input driver.
+ *
+ * This file contains the function definitions for the Audio_Input driver.
+ * It samples an audio signal with ADC0 and detects a Morse tone in it, so that
+ * an audio key can be decoded like the push buttons.
+ *
+ * The following pin is used:
+ *  - AIN8 (PE5)  Audio input, biased at half of the supply
+ *
+ * A 32-bit timer allocated from the GPTM driver triggers sample sequencer 3 of ADC0 at
+ * AUDIO_SAMPLE_RATE, and µDMA channel 17 moves the conversions into two buffers of
+ * AUDIO_BLOCK_SIZE samples in ping-pong mode, so the CPU does not touch the individual samples. When a buffer is full, the ADC0
+ * sequencer 3 interrupt re-arms it and runs the Goertzel detector on it while the other
+ * buffer is being filled.
+ *
+ * Tone changes are posted to the Input_Event queue from the INPUT_SOURCE_AUDIO source:
+ *  - INPUT_EVENT_PRESS    The tone has started
+ *  - INPUT_EVENT_RELEASE  The tone has stopped (value holds the tone duration in ms)
+ *
+ * The number of CPU cycles spent on each block is measured with the DWT cycle counter.
+ * A block lasts (AUDIO_BLOCK_SIZE * SystemCoreClock / AUDIO_SAMPLE_RATE) cycles, which is
+ * 500000 cycles at 50 MHz.
+ *
+ * @note Refer to Table 9-1 (µDMA Channel Assignments) on page 587 of the
+ * TM4C123G Microcontroller Datasheet for the channel encodings.
+ */
+
+#ifndef AUDIO_INPUT_H
+#define AUDIO_INPUT_H
+
+#include "TM4C123GH6PM.h"
+#include "Input_Event.h"
+
+// Sample rate in Hz, and the number of samples in a block (10 ms)
+#define AUDIO_SAMPLE_RATE 8000
+#define AUDIO_BLOCK_SIZE 80
+
+// Default frequency of the Morse tone in Hz
+#define AUDIO_TONE_HZ 800
+
+// Code of the events posted by the tone detector
+#define AUDIO_TONE 0x01
+
+// Number of blocks processed since reset
+extern volatile uint32_t Audio_Blocks;
+
+// Number of times the µDMA channel stopped because both buffers were full
+extern volatile uint32_t Audio_Overruns;
+
+// CPU cycles spent on the last block and the maximum since reset
+extern volatile uint32_t Audio_Cycles_Last;
+extern volatile uint32_t Audio_Cycles_Max;
+
+/**
+ * @brief Starts sampling the audio input and detecting a tone.
+ *
+ * @param tone_hz The frequency of the Morse tone in Hz.
+ *
+ * @return None
+ */
+void Audio_Input_Init(uint32_t tone_hz);
+
+/**
+ * @brief Changes the frequency of the detected tone.
+ *
+ * @param tone_hz The frequency of the Morse tone in Hz.
+ *
+ * @return None
+ */
+void Audio_Input_Set_Tone(uint32_t tone_hz);
+
+/**
+ * @brief Returns whether the tone is currently present.
+ *
+ * @param None
+ *
+ * @return 1 if the tone is present, or 0 otherwise.
+ */
+uint8_t Audio_Input_Tone(void);
+
+#endif
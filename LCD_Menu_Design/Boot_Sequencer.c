@@ -0,0 +1,90 @@
+/**
+ * @file Boot_Sequencer.c
+ *
+ * @brief Source code for the Boot_Sequencer driver.
+ *
+ * This file contains the function definitions for the Boot_Sequencer driver.
+ * The deadline of each waiting task is kept as a DWT cycle count, which wraps
+ * after 85 seconds at 50 MHz, well after the end of the boot.
+ */
+
+#include "Boot_Sequencer.h"
+
+static uint32_t boot_start = 0;
+static uint32_t cycles_per_us = 1;
+
+volatile uint32_t Boot_First_Input_us = 0;
+volatile uint32_t Boot_First_Frame_us = 0;
+volatile uint32_t Boot_Total_us = 0;
+
+void Boot_Sequencer_Run(const Boot_Task *tasks, uint8_t count)
+{
+	uint8_t steps[BOOT_MAX_TASKS];
+	uint32_t ready[BOOT_MAX_TASKS];
+	uint32_t remaining = 0;
+
+	if (count > BOOT_MAX_TASKS)
+	{
+		count = BOOT_MAX_TASKS;
+	}
+
+	// Start the cycle counter, which is also used by the trace recorder
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	cycles_per_us = SystemCoreClock / 1000000;
+	boot_start = DWT->CYCCNT;
+
+	for (uint8_t i = 0; i < count; i++)
+	{
+		steps[i] = 0;
+		ready[i] = boot_start;
+		remaining |= (1UL << i);
+	}
+
+	while (remaining)
+	{
+		for (uint8_t i = 0; i < count; i++)
+		{
+			if ((remaining & (1UL << i)) == 0) continue;
+
+			// Skip the tasks whose wait has not elapsed
+			if ((int32_t)(DWT->CYCCNT - ready[i]) < 0) continue;
+
+			uint32_t wait_us = tasks[i].step(steps[i]);
+			steps[i]++;
+
+			if (wait_us == BOOT_STEP_DONE)
+			{
+				remaining &= ~(1UL << i);
+			}
+			else
+			{
+				ready[i] = DWT->CYCCNT + (wait_us * cycles_per_us);
+			}
+		}
+	}
+
+	Boot_Total_us = Boot_Micros();
+}
+
+uint32_t Boot_Micros(void)
+{
+	return (DWT->CYCCNT - boot_start) / cycles_per_us;
+}
+
+void Boot_Mark_First_Input(void)
+{
+	if (Boot_First_Input_us == 0)
+	{
+		Boot_First_Input_us = Boot_Micros();
+	}
+}
+
+void Boot_Mark_First_Frame(void)
+{
+	if (Boot_First_Frame_us == 0)
+	{
+		Boot_First_Frame_us = Boot_Micros();
+	}
+}
@@ -0,0 +1,89 @@
+/**
+ * @file Boot_Sequencer.h
+ *
+ * @brief Header file for the Boot_Sequencer driver.
+ *
+ * This file contains the function definitions for the Boot_Sequencer driver.
+ * It runs the initialization of the drivers as a set of tasks, each a small state machine
+ * that runs one step at a time and returns how long to wait before its next step
+ * (e.g. the power-up delay of the LCD). The steps of the other tasks run during that wait,
+ * so the boot takes as long as the longest task instead of the sum of all of them.
+ *
+ * Tasks start in the order of their table. A task that finishes in its first step has
+ * finished before the next task starts, so a task can rely on the ones above it.
+ *
+ * Times are measured in microseconds from the start of Boot_Sequencer_Run with the DWT
+ * cycle counter, and do not include the startup code that runs before main.
+ */
+
+#ifndef BOOT_SEQUENCER_H
+#define BOOT_SEQUENCER_H
+
+#include "TM4C123GH6PM.h"
+
+// Maximum number of tasks in the table
+#define BOOT_MAX_TASKS 16
+
+// Returned by a step that ends its task
+#define BOOT_STEP_DONE 0xFFFFFFFFUL
+
+typedef struct
+{
+	const char *name;
+
+	// Runs the given step (0, 1, 2, ...) and returns the wait in microseconds
+	// before the next step, or BOOT_STEP_DONE
+	uint32_t (*step)(uint8_t step);
+} Boot_Task;
+
+// Time when the input devices started sampling, when the first frame was on the LCD,
+// and when every task had finished
+extern volatile uint32_t Boot_First_Input_us;
+extern volatile uint32_t Boot_First_Frame_us;
+extern volatile uint32_t Boot_Total_us;
+
+/**
+ * @brief Runs the steps of the tasks until every task has finished.
+ *
+ * When every remaining task is waiting, the function waits for the earliest one.
+ *
+ * @param tasks A pointer to the table of tasks.
+ *
+ * @param count The number of tasks (up to BOOT_MAX_TASKS).
+ *
+ * @return None
+ */
+void Boot_Sequencer_Run(const Boot_Task *tasks, uint8_t count);
+
+/**
+ * @brief Returns the time since the start of the boot.
+ *
+ * @param None
+ *
+ * @return The time in microseconds.
+ */
+uint32_t Boot_Micros(void);
+
+/**
+ * @brief Records the time when the input devices start sampling.
+ *
+ * Only the first call is recorded.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Boot_Mark_First_Input(void);
+
+/**
+ * @brief Records the time when the first frame is shown on the LCD.
+ *
+ * Only the first call is recorded.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Boot_Mark_First_Frame(void);
+
+#endif
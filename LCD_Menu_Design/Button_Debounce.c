@@ -0,0 +1,320 @@
+/**
+ * @file Button_Debounce.c
+ *
+ * @brief Source code for the Button_Debounce driver.
+ *
+ * This file contains the function definitions for the Button_Debounce driver.
+ * It debounces push buttons by sampling them from a periodic timer with a 2-bit
+ * vertical counter per port, and turns the debounced transitions into press,
+ * release, long-press, repeat and double-click input events.
+ */
+
+#include "Button_Debounce.h"
+#include "Trace_Recorder.h"
+#include "Interrupt_Config.h"
+
+typedef struct
+{
+	uint8_t source;
+	uint8_t mask;
+	uint8_t (*read)(void);
+	void (*enable_interrupts)(void);
+
+	// Set while the port is being sampled
+	volatile uint8_t sampling;
+
+	// Pins connected to toggle switches instead of push buttons
+	uint8_t switches;
+
+	// Debounced state and the two bits of the vertical counter for each pin
+	uint8_t debounced;
+	uint8_t count0;
+	uint8_t count1;
+
+	// Pins whose long press has been reported during the current press
+	uint8_t long_pressed;
+
+	// Pins whose current press completed a double click
+	uint8_t double_clicked;
+
+	// Pins whose last release can start a double click
+	uint8_t click_armed;
+
+	// Where the edge of the next transition was seen (see Button_Edges), and its DWT cycle count
+	uint8_t edge_state;
+	uint32_t edge_cycles;
+
+	uint32_t press_time[8];
+	uint32_t release_time[8];
+	uint32_t next_repeat_time[8];
+} Button_Port;
+
+// The wake-up interrupt sees the first edge of a press, which then bounces. An edge seen by
+// a sample is forgotten when the next sample matches the debounced state again
+enum Button_Edges
+{
+	BUTTON_EDGE_NONE     = 0x00,
+	BUTTON_EDGE_SAMPLED  = 0x01,
+	BUTTON_EDGE_WOKEN    = 0x02
+};
+
+static Button_Port button_ports[BUTTON_MAX_PORTS];
+static uint8_t num_button_ports = 0;
+
+static void Button_Post_Event(const Button_Port *port, uint8_t pin, uint8_t type, uint32_t duration, uint32_t edge_cycles)
+{
+	Input_Event_Post_Edge(port->source, (uint8_t)(1 << pin), type, (int32_t)duration, edge_cycles);
+}
+
+static Button_Port *Button_Find_Port(uint8_t source)
+{
+	for (uint8_t i = 0; i < num_button_ports; i++)
+	{
+		if (button_ports[i].source == source)
+		{
+			return &button_ports[i];
+		}
+	}
+
+	return 0;
+}
+
+uint8_t Button_Debounce_Add_Port(uint8_t source, uint8_t (*read)(void), uint8_t mask, void (*enable_interrupts)(void))
+{
+	// A port that was removed is registered again in its own slot
+	Button_Port *port = Button_Find_Port(source);
+
+	if (port == 0)
+	{
+		if (num_button_ports >= BUTTON_MAX_PORTS) return 0;
+
+		port = &button_ports[num_button_ports];
+	}
+
+	// The tick interrupt must not sample the port while it is being set up
+	uint32_t basepri = Interrupt_Lock(INTERRUPT_LEVEL_INPUT_TICK);
+
+	port->source = source;
+	port->mask = mask;
+	port->read = read;
+	port->enable_interrupts = enable_interrupts;
+	port->sampling = 1;
+	port->switches = 0;
+
+	// Start from the current level so that buttons held at reset do not generate events
+	port->debounced = read() & mask;
+
+	// The vertical counter is idle when both of its bits are set
+	port->count0 = 0xFF;
+	port->count1 = 0xFF;
+
+	port->long_pressed = 0;
+	port->double_clicked = 0;
+	port->click_armed = 0;
+	port->edge_state = BUTTON_EDGE_NONE;
+
+	if (port == &button_ports[num_button_ports])
+	{
+		num_button_ports++;
+	}
+
+	Interrupt_Unlock(INTERRUPT_LEVEL_INPUT_TICK, basepri);
+
+	return 1;
+}
+
+void Button_Debounce_Remove_Port(uint8_t source)
+{
+	Button_Port *port = Button_Find_Port(source);
+
+	if (port == 0) return;
+
+	uint32_t basepri = Interrupt_Lock(INTERRUPT_LEVEL_INPUT_TICK);
+
+	// The slot stays reserved for the source, and is skipped by the tick until the port is added again
+	port->sampling = 0;
+	port->mask = 0;
+	port->debounced = 0;
+
+	Interrupt_Unlock(INTERRUPT_LEVEL_INPUT_TICK, basepri);
+}
+
+static void Button_Process_Port(Button_Port *port, uint32_t now)
+{
+	// Read all of the pins of the port at once
+	uint8_t delta = (port->read() & port->mask) ^ port->debounced;
+
+	if (delta == 0)
+	{
+		if (port->edge_state == BUTTON_EDGE_SAMPLED)
+		{
+			port->edge_state = BUTTON_EDGE_NONE;
+		}
+	}
+	else if (port->edge_state == BUTTON_EDGE_NONE)
+	{
+		port->edge_cycles = DWT->CYCCNT;
+		port->edge_state = BUTTON_EDGE_SAMPLED;
+	}
+
+	// Advance the vertical counter of every pin that differs from its debounced state,
+	// and reset the counter of every pin that matches it. A pin toggles after
+	// BUTTON_DEBOUNCE_SAMPLES consecutive differing samples.
+	port->count0 = ~(port->count0 & delta);
+	port->count1 = port->count0 ^ (port->count1 & delta);
+	uint8_t toggled = delta & port->count0 & port->count1;
+	port->debounced ^= toggled;
+
+	uint8_t pressed = toggled & port->debounced;
+	uint8_t released = toggled & ~port->debounced;
+
+	// The transitions of this sample are timed from their first edge, and the gestures
+	// detected while a button is held from the current sample
+	uint32_t edge_cycles = port->edge_cycles;
+	uint32_t sample_cycles = DWT->CYCCNT;
+
+	if (toggled)
+	{
+		TRACE_BUTTON_EDGE(port->source, (toggled << 8) | port->debounced);
+		port->edge_state = BUTTON_EDGE_NONE;
+	}
+
+	// Only the pins that changed or are being held need any further work
+	uint8_t active = toggled | port->debounced;
+
+	while (active)
+	{
+		uint8_t pin = (uint8_t)(31 - __CLZ(active));
+		uint8_t bit = (uint8_t)(1 << pin);
+		active &= ~bit;
+
+		if (port->switches & bit)
+		{
+			// Toggle switches only report when they are turned on and off
+			if (pressed & bit)
+			{
+				port->press_time[pin] = now;
+				Button_Post_Event(port, pin, INPUT_EVENT_PRESS, 0, edge_cycles);
+			}
+			else if (released & bit)
+			{
+				Button_Post_Event(port, pin, INPUT_EVENT_RELEASE, now - port->press_time[pin], edge_cycles);
+			}
+		}
+		else if (pressed & bit)
+		{
+			port->press_time[pin] = now;
+			port->next_repeat_time[pin] = now + BUTTON_LONG_PRESS_MS + BUTTON_REPEAT_MS;
+			port->long_pressed &= ~bit;
+			port->double_clicked &= ~bit;
+
+			Button_Post_Event(port, pin, INPUT_EVENT_PRESS, 0, edge_cycles);
+
+			if ((port->click_armed & bit) && ((now - port->release_time[pin]) <= BUTTON_DOUBLE_CLICK_MS))
+			{
+				port->double_clicked |= bit;
+				Button_Post_Event(port, pin, INPUT_EVENT_DOUBLE_CLICK, now - port->release_time[pin], edge_cycles);
+			}
+
+			port->click_armed &= ~bit;
+		}
+		else if (released & bit)
+		{
+			port->release_time[pin] = now;
+
+			// A short press that did not complete a double click can start one
+			if ((port->long_pressed | port->double_clicked) & bit)
+			{
+				port->click_armed &= ~bit;
+			}
+			else
+			{
+				port->click_armed |= bit;
+			}
+
+			Button_Post_Event(port, pin, INPUT_EVENT_RELEASE, now - port->press_time[pin], edge_cycles);
+		}
+		else
+		{
+			// The button is being held
+			uint32_t held = now - port->press_time[pin];
+
+			if (!(port->long_pressed & bit))
+			{
+				if (held >= BUTTON_LONG_PRESS_MS)
+				{
+					port->long_pressed |= bit;
+					Button_Post_Event(port, pin, INPUT_EVENT_LONG_PRESS, held, sample_cycles);
+				}
+			}
+			else if ((int32_t)(now - port->next_repeat_time[pin]) >= 0)
+			{
+				port->next_repeat_time[pin] += BUTTON_REPEAT_MS;
+				Button_Post_Event(port, pin, INPUT_EVENT_REPEAT, held, sample_cycles);
+			}
+		}
+	}
+
+	// An interrupt-driven port goes back to sleep once all of its buttons
+	// are released and none of its vertical counters is running
+	if ((port->enable_interrupts != 0) && ((port->debounced & ~port->switches) == 0) &&
+	    ((port->count0 & port->count1 & port->mask) == port->mask))
+	{
+		port->sampling = 0;
+		port->edge_state = BUTTON_EDGE_NONE;
+		port->enable_interrupts();
+
+		// Keep sampling if a pin changed before the interrupts were re-enabled
+		if ((port->read() & port->mask) != port->debounced)
+		{
+			port->sampling = 1;
+		}
+	}
+}
+
+void Button_Debounce_Set_Switches(uint8_t source, uint8_t mask)
+{
+	Button_Port *port = Button_Find_Port(source);
+
+	if (port != 0)
+	{
+		port->switches = mask & port->mask;
+	}
+}
+
+void Button_Debounce_Wake(uint8_t source)
+{
+	Button_Port *port = Button_Find_Port(source);
+
+	if (port != 0)
+	{
+		// Only the interrupt that wakes the port sees the first edge
+		if (!port->sampling)
+		{
+			port->edge_cycles = DWT->CYCCNT;
+			port->edge_state = BUTTON_EDGE_WOKEN;
+		}
+
+		port->sampling = 1;
+	}
+}
+
+void Button_Debounce_Tick(void)
+{
+	uint32_t now = Input_Event_Millis();
+
+	for (uint8_t i = 0; i < num_button_ports; i++)
+	{
+		if (button_ports[i].sampling)
+		{
+			Button_Process_Port(&button_ports[i], now);
+		}
+	}
+}
+
+uint8_t Button_Debounce_State(uint8_t source)
+{
+	Button_Port *port = Button_Find_Port(source);
+
+	return (port != 0) ? port->debounced : 0;
+}
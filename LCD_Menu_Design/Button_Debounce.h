@@ -0,0 +1,137 @@
+/**
+ * @file Button_Debounce.h
+ *
+ * @brief Header file for the Button_Debounce driver.
+ *
+ * This file contains the function definitions for the Button_Debounce driver.
+ * It debounces push buttons by sampling them from a periodic timer instead of
+ * taking an interrupt on every contact bounce.
+ *
+ * Each registered port is read once per tick and all of its pins are debounced in
+ * parallel with a 2-bit vertical counter: a pin only changes state after it has read
+ * the same level for BUTTON_DEBOUNCE_SAMPLES consecutive ticks. The cost of a tick is
+ * therefore fixed and does not depend on how much the contacts bounce.
+ *
+ * Debounced transitions are posted to the Input_Event queue as timestamped events:
+ *  - INPUT_EVENT_PRESS         The button has been pressed
+ *  - INPUT_EVENT_RELEASE       The button has been released (value holds the press time)
+ *  - INPUT_EVENT_LONG_PRESS    The button has been held for BUTTON_LONG_PRESS_MS
+ *  - INPUT_EVENT_REPEAT        The button is still held, sent every BUTTON_REPEAT_MS
+ *  - INPUT_EVENT_DOUBLE_CLICK  The button has been pressed again within BUTTON_DOUBLE_CLICK_MS
+ *                              of its last release (sent after the second PRESS event)
+ *
+ * A port can be sampled on every tick, or woken by its GPIO edge interrupt. A woken
+ * port is sampled until all of its buttons are released and stable, and its
+ * interrupts are then re-enabled, so idle ports cost no CPU time at all.
+ *
+ * @note Button_Debounce_Tick is called every INPUT_TICK_MS milliseconds by Input_Event_Tick.
+ */
+
+#ifndef BUTTON_DEBOUNCE_H
+#define BUTTON_DEBOUNCE_H
+
+#include "TM4C123GH6PM.h"
+#include "Input_Event.h"
+
+// Number of consecutive identical samples needed to accept a new level
+// (fixed by the 2-bit vertical counter)
+#define BUTTON_DEBOUNCE_SAMPLES 4
+
+// Gesture timing in milliseconds
+#define BUTTON_LONG_PRESS_MS 600
+#define BUTTON_REPEAT_MS 200
+#define BUTTON_DOUBLE_CLICK_MS 300
+
+// Maximum number of ports that can be registered
+#define BUTTON_MAX_PORTS 4
+
+/**
+ * @brief Registers a port with the debounce engine.
+ *
+ * The read function is called on every sampled tick and must return the raw state of the port,
+ * with a pin reading 1 while its button is pressed. Only the pins in the mask are debounced.
+ * Events from this port carry the given source and, in their code field, the bit mask of
+ * the pin (e.g. 0x04 for PA2).
+ *
+ * If enable_interrupts is 0, the port is sampled on every tick. Otherwise, the port is only
+ * sampled after its interrupt service routine has called Button_Debounce_Wake. Once all of the
+ * buttons of the port are released and stable, sampling stops and enable_interrupts is called
+ * to clear and unmask the port's edge interrupts.
+ *
+ * A port that has been removed can be added again, and keeps its slot.
+ *
+ * @param source The identifier of the port (see Input_Sources).
+ *
+ * @param read A pointer to the function that reads the raw port state.
+ *
+ * @param mask The bit mask of the pins to debounce.
+ *
+ * @param enable_interrupts A pointer to the function that re-enables the port's edge interrupts,
+ *                          or 0 for a port that is sampled on every tick.
+ *
+ * @return 1 if the port was registered, or 0 if BUTTON_MAX_PORTS ports are already registered.
+ */
+uint8_t Button_Debounce_Add_Port(uint8_t source, uint8_t (*read)(void), uint8_t mask, void (*enable_interrupts)(void));
+
+/**
+ * @brief Stops debouncing a registered port.
+ *
+ * This function is called when the pins of the port are given to another driver.
+ * The port is no longer sampled, and the buttons held at that time do not
+ * generate release events.
+ *
+ * @param source The identifier of the port.
+ *
+ * @return None
+ */
+void Button_Debounce_Remove_Port(uint8_t source);
+
+/**
+ * @brief Marks pins of a registered port as toggle switches.
+ *
+ * Toggle switches only generate INPUT_EVENT_PRESS when they are turned on and
+ * INPUT_EVENT_RELEASE when they are turned off. A switch that stays on does not keep an
+ * interrupt-driven port awake, so its pin must be configured to interrupt on both edges.
+ *
+ * @param source The identifier of the port.
+ *
+ * @param mask The bit mask of the pins connected to toggle switches.
+ *
+ * @return None
+ */
+void Button_Debounce_Set_Switches(uint8_t source, uint8_t mask);
+
+/**
+ * @brief Starts sampling a port after an edge interrupt.
+ *
+ * This function is called by the GPIO interrupt service routine of a port registered with
+ * an enable_interrupts function, after it has masked the port's edge interrupts. The port
+ * is sampled on every tick until its buttons are released and stable.
+ *
+ * @param source The identifier of the port.
+ *
+ * @return None
+ */
+void Button_Debounce_Wake(uint8_t source);
+
+/**
+ * @brief Samples the active ports and posts their events.
+ *
+ * This function is called every INPUT_TICK_MS milliseconds by Input_Event_Tick.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Button_Debounce_Tick(void);
+
+/**
+ * @brief Returns the debounced state of a registered port.
+ *
+ * @param source The identifier of the port.
+ *
+ * @return The debounced pin states, with a 1 for each pressed button.
+ */
+uint8_t Button_Debounce_State(uint8_t source);
+
+#endif
@@ -32,23 +32,15 @@ const double C5_NOTE = 523.2;
 
 void Buzzer_Init(void)
 {
-	// Enable the clock to Port C
-	SYSCTL->RCGCGPIO |= 0x04;
-	
-	// Set PC4 as an output GPIO pin
-	GPIOC->DIR |= 0x10;
-	
-	// Configure PC4 to function as a GPIO pin
-	GPIOC->AFSEL &= ~0x10;
-	
-	// Enable digital functionality for PC4
-	GPIOC->DEN |= 0x10;
+	// Configure PC4 as a digital GPIO output
+	GPIO_Configure(GPIOC, 0x10, GPIO_OUTPUT);
 }
  
 void Buzzer_Output(uint8_t buzzer_value)
 {
-	// Set the output of the buzzer
-	GPIOC->DATA = (GPIOC->DATA & 0xEF) | buzzer_value;
+	// Set the output of the buzzer through the masked DATA address of PC4,
+	// leaving the other Port C pins (LCD enable, SSI2 SS) untouched
+	GPIO_Write_Bus(GPIOC, 0x10, buzzer_value);
 }
 
 void Play_Note(double note, unsigned int duration)
@@ -0,0 +1,239 @@
+/**
+ * @file Console.c
+ *
+ * @brief Source code for the Console driver.
+ *
+ * This file contains the function definitions for the Console driver.
+ * It implements a small line-based command console on top of the UART0 driver.
+ */
+
+#include "Console.h"
+#include "Trace_Recorder.h"
+#include <string.h>
+#include <stdlib.h>
+
+static const Console_Parameter *console_parameters = 0;
+static uint8_t console_num_parameters = 0;
+
+static const Console_Command *console_commands = 0;
+static uint8_t console_num_commands = 0;
+
+static const Console_Counter *console_counters = 0;
+static uint8_t console_num_counters = 0;
+
+// Command line being edited
+static char line[CONSOLE_LINE_SIZE];
+static uint8_t line_length = 0;
+
+// Last character received, used to treat CR LF as a single line ending
+static char previous_character = 0;
+
+static const Console_Parameter *Console_Find_Parameter(const char *name)
+{
+	for (uint8_t i = 0; i < console_num_parameters; i++)
+	{
+		if (strcmp(console_parameters[i].name, name) == 0)
+		{
+			return &console_parameters[i];
+		}
+	}
+
+	return 0;
+}
+
+static void Console_Print_Parameter(const Console_Parameter *parameter)
+{
+	UART0_Printf("%s = %ld [%ld..%ld]\r\n", parameter->name, (long)*parameter->value,
+	             (long)parameter->min, (long)parameter->max);
+}
+
+static void Console_Help(void)
+{
+	UART0_Write_String("help | get [name] | set <name> <value> | stats\r\n");
+
+	for (uint8_t i = 0; i < console_num_commands; i++)
+	{
+		UART0_Printf("%s - %s\r\n", console_commands[i].name, console_commands[i].help);
+	}
+
+	for (uint8_t i = 0; i < console_num_parameters; i++)
+	{
+		Console_Print_Parameter(&console_parameters[i]);
+	}
+}
+
+static void Console_Stats(void)
+{
+	UART0_Printf("uart_tx_dropped = %lu\r\n", (unsigned long)UART0_TX_Dropped);
+	UART0_Printf("uart_rx_overruns = %lu\r\n", (unsigned long)UART0_RX_Overruns);
+	UART0_Printf("trace_pending = %lu\r\n", (unsigned long)Trace_Recorder_Pending());
+	UART0_Printf("trace_dropped = %lu\r\n", (unsigned long)Trace_Dropped);
+
+	for (uint8_t i = 0; i < console_num_counters; i++)
+	{
+		UART0_Printf("%s = %lu\r\n", console_counters[i].name, (unsigned long)*console_counters[i].value);
+	}
+}
+
+uint8_t Console_Set_Parameter(const char *name, int32_t value)
+{
+	const Console_Parameter *parameter = Console_Find_Parameter(name);
+
+	if ((parameter == 0) || (value < parameter->min) || (value > parameter->max))
+	{
+		return 0;
+	}
+
+	*parameter->value = value;
+
+	if (parameter->on_change != 0)
+	{
+		parameter->on_change(value);
+	}
+
+	return 1;
+}
+
+static void Console_Execute(int argc, char *argv[])
+{
+	if (strcmp(argv[0], "help") == 0)
+	{
+		Console_Help();
+	}
+	else if (strcmp(argv[0], "get") == 0)
+	{
+		if (argc < 2)
+		{
+			for (uint8_t i = 0; i < console_num_parameters; i++)
+			{
+				Console_Print_Parameter(&console_parameters[i]);
+			}
+		}
+		else
+		{
+			const Console_Parameter *parameter = Console_Find_Parameter(argv[1]);
+
+			if (parameter != 0)
+			{
+				Console_Print_Parameter(parameter);
+			}
+			else
+			{
+				UART0_Printf("unknown parameter: %s\r\n", argv[1]);
+			}
+		}
+	}
+	else if (strcmp(argv[0], "set") == 0)
+	{
+		if (argc < 3)
+		{
+			UART0_Write_String("usage: set <name> <value>\r\n");
+		}
+		else if (Console_Set_Parameter(argv[1], (int32_t)strtol(argv[2], 0, 0)))
+		{
+			Console_Print_Parameter(Console_Find_Parameter(argv[1]));
+		}
+		else
+		{
+			UART0_Printf("rejected: %s %s\r\n", argv[1], argv[2]);
+		}
+	}
+	else if (strcmp(argv[0], "stats") == 0)
+	{
+		Console_Stats();
+	}
+	else
+	{
+		for (uint8_t i = 0; i < console_num_commands; i++)
+		{
+			if (strcmp(console_commands[i].name, argv[0]) == 0)
+			{
+				console_commands[i].handler(argc, argv);
+				return;
+			}
+		}
+
+		UART0_Printf("unknown command: %s\r\n", argv[0]);
+	}
+}
+
+static void Console_Execute_Line(void)
+{
+	char *argv[CONSOLE_MAX_ARGS];
+	int argc = 0;
+	char *token = line;
+
+	line[line_length] = '\0';
+
+	// Split the line into space-separated arguments
+	while ((*token != '\0') && (argc < CONSOLE_MAX_ARGS))
+	{
+		while (*token == ' ') token++;
+		if (*token == '\0') break;
+
+		argv[argc++] = token;
+
+		while ((*token != ' ') && (*token != '\0')) token++;
+		if (*token == ' ') *token++ = '\0';
+	}
+
+	if (argc > 0)
+	{
+		Console_Execute(argc, argv);
+	}
+
+	line_length = 0;
+	UART0_Write_String("> ");
+}
+
+void Console_Init(const Console_Parameter *parameters, uint8_t num_parameters,
+                  const Console_Command *commands, uint8_t num_commands)
+{
+	console_parameters = parameters;
+	console_num_parameters = num_parameters;
+	console_commands = commands;
+	console_num_commands = num_commands;
+	line_length = 0;
+
+	UART0_Write_String("\r\n> ");
+}
+
+void Console_Register_Counters(const Console_Counter *counters, uint8_t num_counters)
+{
+	console_counters = counters;
+	console_num_counters = num_counters;
+}
+
+void Console_Process(void)
+{
+	char character;
+
+	while (UART0_Read_Char(&character))
+	{
+		char previous = previous_character;
+		previous_character = character;
+
+		if ((character == '\n') && (previous == '\r'))
+		{
+			continue;
+		}
+		else if ((character == '\r') || (character == '\n'))
+		{
+			UART0_Write_String("\r\n");
+			Console_Execute_Line();
+		}
+		else if ((character == '\b') || (character == 0x7F))
+		{
+			if (line_length > 0)
+			{
+				line_length--;
+				UART0_Write_String("\b \b");
+			}
+		}
+		else if ((line_length < (CONSOLE_LINE_SIZE - 1)) && (character >= ' '))
+		{
+			line[line_length++] = character;
+			UART0_Write((const uint8_t *)&character, 1);
+		}
+	}
+}
@@ -0,0 +1,112 @@
+/**
+ * @file Console.h
+ *
+ * @brief Header file for the Console driver.
+ *
+ * This file contains the function definitions for the Console driver.
+ * It implements a small line-based command console on top of the UART0 driver.
+ * The following commands are built in:
+ *  - help               Lists the commands and parameters
+ *  - get [name]         Prints one parameter, or all of them
+ *  - set <name> <value> Changes a parameter at runtime
+ *  - stats              Dumps the UART, trace and application counters
+ *
+ * The application supplies a table of runtime parameters, an optional table of
+ * additional commands and an optional table of performance counters.
+ *
+ * Console_Process must be called from the main loop. It never blocks: it only
+ * handles the characters that have already been received.
+ */
+
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include "TM4C123GH6PM.h"
+#include "UART0.h"
+
+// Maximum length of a command line
+#define CONSOLE_LINE_SIZE 48
+
+// Maximum number of arguments in a command line (including the command name)
+#define CONSOLE_MAX_ARGS 4
+
+typedef struct
+{
+	const char *name;
+	int32_t *value;
+	int32_t min;
+	int32_t max;
+	void (*on_change)(int32_t value);
+} Console_Parameter;
+
+typedef struct
+{
+	const char *name;
+	const char *help;
+	void (*handler)(int argc, char *argv[]);
+} Console_Command;
+
+typedef struct
+{
+	const char *name;
+	volatile uint32_t *value;
+} Console_Counter;
+
+/**
+ * @brief Initializes the console.
+ *
+ * This function stores the parameter and command tables and prints the prompt.
+ * UART0_Init must be called before this function.
+ *
+ * @param parameters A table of runtime parameters that can be read and set.
+ *
+ * @param num_parameters The number of entries in the parameter table.
+ *
+ * @param commands A table of application commands, or 0 if there are none.
+ *
+ * @param num_commands The number of entries in the command table.
+ *
+ * @return None
+ */
+void Console_Init(const Console_Parameter *parameters, uint8_t num_parameters,
+                  const Console_Command *commands, uint8_t num_commands);
+
+/**
+ * @brief Registers a table of performance counters printed by the stats command.
+ *
+ * @param counters A table of counters.
+ *
+ * @param num_counters The number of entries in the counter table.
+ *
+ * @return None
+ */
+void Console_Register_Counters(const Console_Counter *counters, uint8_t num_counters);
+
+/**
+ * @brief Processes the characters received by UART0.
+ *
+ * This function echoes received characters, handles backspace, and executes the command
+ * line when a carriage return or line feed is received. It returns as soon as the receive
+ * buffer is empty.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Console_Process(void);
+
+/**
+ * @brief Sets a parameter by name as if it had been changed with the set command.
+ *
+ * The value is rejected if it lies outside of the parameter's range. The parameter's
+ * on_change function is called when the value is accepted.
+ *
+ * @param name The name of the parameter.
+ *
+ * @param value The new value of the parameter.
+ *
+ * @return 1 if the value was accepted, or 0 otherwise.
+ */
+uint8_t Console_Set_Parameter(const char *name, int32_t value);
+
+#endif
@@ -0,0 +1,88 @@
+/**
+ * @file EduBase_Button_Interrupt.c
+ *
+ * @brief Source code for the EduBase_Button_Interrupt driver.
+ *
+ * This file contains the function definitions for the EduBase_Button_Interrupt driver.
+ * It interfaces with the push buttons on the EduBase board. The following pins are used:
+ *  - SW2 (PD3)
+ *  - SW3 (PD2)
+ *  - SW4 (PD1)
+ *  - SW5 (PD0)
+ *
+ * The push buttons operate in an active high configuration.
+ */
+
+#include "EduBase_Button_Interrupt.h"
+#include "Button_Debounce.h"
+#include "Trace_Recorder.h"
+#include "Interrupt_Config.h"
+
+static void EduBase_Button_Enable_Interrupts(void)
+{
+	// Clear any pending edge and unmask the PD3, PD2, PD1, and PD0 pins
+	GPIOD->ICR = 0x0F;
+	GPIOD->IM |= 0x0F;
+}
+
+void EduBase_Button_Interrupt_Init(void)
+{
+	// Enable the clock to Port D by setting the
+	// R3 bit (Bit 3) in the RCGCGPIO register
+	SYSCTL->RCGCGPIO |= 0x08;
+	
+	// Mask the interrupts of the PD3, PD2, PD1, and PD0 pins during configuration
+	// by clearing Bits 3 to 0 in the IM register. The debounce engine unmasks them.
+	GPIOD->IM &= ~0x0F;
+	
+	// Configure the PD3, PD2, PD1, and PD0 pins as input
+	// by clearing Bits 3 to 0 in the DIR register
+	GPIOD->DIR &= ~0x0F;
+	
+	// Configure the PD3, PD2, PD1, and PD0 pins to function as
+	// GPIO pins by clearing Bits 3 to 0 in the AFSEL register
+	GPIOD->AFSEL &= ~0x0F;
+	
+	// Enable the digital functionality for the PD3, PD2, PD1, and PD0 pins
+	// by setting Bits 3 to 0 in the DEN register
+	GPIOD->DEN |= 0x0F;
+	
+	// Enable the weak pull-down resistor for the PD3, PD2, PD1, and PD0 pins
+	// by setting Bits 3 to 0 in the PDR register
+	GPIOD->PDR |= 0x0F;
+	
+	// Configure the PD3, PD2, PD1, and PD0 pins to detect rising edges
+	// by clearing Bits 3 to 0 in the IS and IBE registers and setting them in the IEV register
+	GPIOD->IS &= ~0x0F;
+	GPIOD->IBE &= ~0x0F;
+	GPIOD->IEV |= 0x0F;
+	
+	// Register the four buttons with the debounce engine as an interrupt-driven port
+	Button_Debounce_Add_Port(INPUT_SOURCE_EDUBASE_BTN, &EduBase_Button_Read, 0x0F, &EduBase_Button_Enable_Interrupts);
+	
+	// Enable the GPIO Port D interrupt (IRQ 3) at its level in the priority plan
+	Interrupt_Config_Enable(INTERRUPT_EDUBASE_BTN);
+}
+
+uint8_t EduBase_Button_Read(void)
+{
+	// Read the DATA register for Port D
+	// A "0x0F" bit mask is used to capture only the pins used by the push buttons
+	return (uint8_t)(GPIOD->DATA & 0x0F);
+}
+
+void GPIOD_Handler(void)
+{
+	TRACE_ISR_ENTER(GPIOD_IRQn);
+	
+	if (GPIOD->MIS & 0x0F)
+	{
+		// Mask the button interrupts so that contact bounce cannot cause an interrupt storm,
+		// and let the debounce engine sample the pins until they are stable again
+		GPIOD->IM &= ~0x0F;
+		GPIOD->ICR = 0x0F;
+		Button_Debounce_Wake(INPUT_SOURCE_EDUBASE_BTN);
+	}
+	
+	TRACE_ISR_EXIT(GPIOD_IRQn);
+}
@@ -0,0 +1,55 @@
+/**
+ * @file EduBase_Button_Interrupt.h
+ *
+ * @brief Header file for the EduBase_Button_Interrupt driver.
+ *
+ * This file contains the function definitions for the EduBase_Button_Interrupt driver.
+ * It interfaces with the push buttons on the EduBase board. The following pins are used:
+ *  - SW2 (PD3)
+ *  - SW3 (PD2)
+ *  - SW4 (PD1)
+ *  - SW5 (PD0)
+ *
+ * The push buttons operate in an active high configuration. The first rising edge of a
+ * press wakes the Button_Debounce engine, which debounces the buttons and posts their
+ * events to the Input_Event queue as INPUT_SOURCE_EDUBASE_BTN, in the same format as the
+ * PMOD BTN and PMOD ENC events. The code field of an event holds the bit mask of the pin
+ * (e.g. 0x08 for SW2).
+ */
+
+#include "TM4C123GH6PM.h"
+#include "Input_Event.h"
+
+/**
+ * @brief Initializes interrupts for the EduBase push buttons using Port D.
+ *
+ * This function configures the PD3, PD2, PD1, and PD0 pins as inputs that detect rising edges,
+ * and registers them with the Button_Debounce driver as an interrupt-driven port.
+ * The GPIO Port D interrupt is enabled at level 3 of the priority plan (see Interrupt_Config.h).
+ *
+ * @param None
+ *
+ * @return None
+ */
+void EduBase_Button_Interrupt_Init(void);
+
+/**
+ * @brief Reads the current status of the EduBase push buttons.
+ *
+ * @param None
+ *
+ * @return An 8-bit unsigned integer with Bits 3 to 0 set for each pressed button.
+ */
+uint8_t EduBase_Button_Read(void);
+
+/**
+ * @brief The interrupt service routine (ISR) for GPIO Port D.
+ *
+ * This function masks the button interrupts, acknowledges them, and wakes the debounce
+ * engine, which samples the buttons until they are released and stable.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void GPIOD_Handler(void);
@@ -20,113 +20,94 @@
  */
  
 #include "EduBase_LCD.h"
+#include "Trace_Recorder.h"
+#include "LCD_Stream.h"
+#include "Boot_Sequencer.h"
+
+// Pins used by the LCD
+#define LCD_DATA_PORT GPIOA
+#define LCD_DATA_MASK 0x3C
+static const GPIO_Pin LCD_ENABLE_PIN = { GPIOC, 0x40 };
+static const GPIO_Pin LCD_RS_PIN = { GPIOE, 0x01 };
+
+static const GPIO_Config lcd_pin_config[] =
+{
+	{ GPIOA, LCD_DATA_MASK, GPIO_OUTPUT },
+	{ GPIOC, 0x40, GPIO_OUTPUT },
+	{ GPIOE, 0x01, GPIO_OUTPUT }
+};
 
 static uint8_t display_control = 0x00;
+
+//Address counter of the LCD, tracked since the R/W pin is not connected.
+//Data writes go to the CGRAM after a Set CGRAM Address command
+static uint8_t ddram_address = 0x00;
+static uint8_t cgram_selected = 0;
 static uint8_t display_mode = 0x00;
 
 void EduBase_LCD_Ports_Init(void)
 {
-	//Enable the clock to Port A by setting the
-	//R0 bit (Bit 0) in the RCGCGPIO register
-	SYSCTL->RCGCGPIO |= 0x01;
-	
-	//Configure the PA5, PA4, PA3, and PA2 pins as output
-	//by setting Bits 5 to 2 in the DIR register
-	GPIOA->DIR |= 0x3C;
-	
-	//Configure the PA5, PA4, PA3, and PA2 pins to function as
-	//GPIO pins by clearing Bits 5 to 2 in the AFSEL register
-	GPIOA->AFSEL &= ~0x3C;
-	
-	//Enable the digital functionality for the PA5, PA4, PA3, and PA2 pins
-	//by setting Bits 5 to 2 in the DEN register
-	GPIOA->DEN |= 0x3C;
-	
-	//Initialize the output of the PA5, PA4, PA3, and PA2 pins to zero
-	//by clearing Bits 5 to 2 in the DATA register
-	GPIOA->DATA &= ~0x3C;
-	
-	//Enable the clock to Port C by setting the
-	//R2 bit(Bit 2) in the RCGCGPIO register
-	SYSCTL->RCGCGPIO |= 0x04;
-	
-	//Configure the PC6 pin as output by setting Bit 6 in the DIR register
-	GPIOC->DIR |= 0x40;
-	
-	//Configure the PC6 pin to function as a GPIO pin
-	//by clearing Bit 6 in the AFSEL register
-	GPIOC->AFSEL &= ~0x40;
-	
-	//Enable the digital functionality for the PA6 pin
-	//by setting Bit 6 in the DEN register
-	GPIOC->DEN |= 0x40;
-	
-	//Initialize the output of the PC6 pin
-	//by clearing Bits 6 in the DATA register
-	GPIOC->DATA &= ~0x40;
-	
-	//Enable the clock to Port E by setting the
-	//R4 bit (Bit 4) in the RCGCGPIO register
-	SYSCTL->RCGCGPIO |= 0x10;
-	
-	//Configure the PE0 pin as output by setting Bit 0 in the DIR register
-	GPIOE->DIR |= 0x01;
-	
-	//Configure the PE0 pin to function as a GPIO pin\
-	//by clearing Bit 0 in the AFSEL register
-	GPIOE->AFSEL &= ~0x01;
-	
-	//Enable the digital functionality for the PE0 pin
-	//by setting Bit 0 in the DEN register
-	GPIOE->DEN |= 0x01;
-	
-	//Initialize the output of the PE0 pin to zero
-	//by clearing Bit 0 in the DATA register
-	GPIOE->DATA &= ~0x01;
+	//Configure the data pins (PA5 - PA2), the LCD enable pin (PC6)
+	//and the register select pin (PE0) as GPIO outputs initialized to zero
+	GPIO_Configure_Table(lcd_pin_config, sizeof(lcd_pin_config) / sizeof(lcd_pin_config[0]));
 }
 
 void EduBase_LCD_Pulse_Enable(void)
 {
- //Ensure that the output of the PC6 pin is zero before sending a short pulse
-	GPIOC->DATA &= ~0x40;
+	//Ensure that the output of the PC6 pin is zero before sending a short pulse
+	GPIO_Clear(LCD_ENABLE_PIN);
 	SysTick_Delay1us(1);
 	
 	//Output a short pulse on the PC6 pin by setting Bit 6
 	//in the DATA register high and clearing it after 1us.
 	//The minimum time for the enable pulse width must be at least greater than 420 ns
 	//during a read/write operation 
-	GPIOC->DATA |= 0x40;
+	GPIO_Set(LCD_ENABLE_PIN);
 	SysTick_Delay1us(1);
-	GPIOC->DATA &= ~0x40;
+	GPIO_Clear(LCD_ENABLE_PIN);
 }
 
 void EduBase_LCD_Write_4_Bits(uint8_t data, uint8_t control_flag)
 {
- //Set the upper nibble of the data on the data pins (PA2 - PA5)
-	GPIOA->DATA |= (data & 0xF0) >> 0x2;
+	//Wait for the precompiled screens being played in the background
+	LCD_Stream_Wait();
+	
+	//Set the upper nibble of the data on the data pins (PA2 - PA5)
+	//with a single store to the masked DATA address of the pins
+	GPIO_Write_Bus(LCD_DATA_PORT, LCD_DATA_MASK, (data & 0xF0) >> 0x2);
 	
 	//Set or clear the register select (RS) pin based on the control flag
 	//0 for command and 1 for data
-	if (control_flag & 0x01)
-	{
-		GPIOE->DATA |= 0x01;
-	}
-	
-	else
-	{
-		GPIOE->DATA &= ~0x01;
-	}
+	GPIO_Write(LCD_RS_PIN, control_flag & 0x01);
 	
 	//Output a short pulse on the PC6 pin to enable the LCD
 	EduBase_LCD_Pulse_Enable();
 	
 	//Clear the LCD data lines (PA2 - PA5) and provide a 1 ms delay
-	GPIOA->DATA &= ~0x3C;
+	GPIO_Write_Bus(LCD_DATA_PORT, LCD_DATA_MASK, 0x00);
 	SysTick_Delay1us(1000);
 }
 
 void EduBase_LCD_Send_Command(uint8_t command)
 {
+	TRACE_LCD_COMMAND(command);
+	
+	//Keep track of the address counter
+	if (command & SET_DDRAM_ADDR)
+	{
+		ddram_address = command & 0x7F;
+		cgram_selected = 0;
+	}
+	else if (command & SET_CGRAM_ADDR)
+	{
+		cgram_selected = 1;
+	}
+	else if (command < 3)
+	{
+		ddram_address = 0x00;
+		cgram_selected = 0;
+	}
+	
 	//Transmit the upper nibble of the command byte
 	EduBase_LCD_Write_4_Bits(command & 0xF0, SEND_COMMAND_FLAG);
 	
@@ -148,6 +129,24 @@ void EduBase_LCD_Send_Command(uint8_t command)
 
 void EduBase_LCD_Send_Data(uint8_t data)
 {
+	TRACE_LCD_DATA(data);
+	
+	//Advance the tracked DDRAM address in increment mode. The first line
+	//ends at address 0x27 and the second line starts at address 0x40
+	if (!cgram_selected)
+	{
+		ddram_address++;
+		
+		if (ddram_address == 0x28)
+		{
+			ddram_address = 0x40;
+		}
+		else if (ddram_address == 0x68)
+		{
+			ddram_address = 0x00;
+		}
+	}
+	
  //Transmit the upper nibble of the data byte
 	EduBase_LCD_Write_4_Bits(data & 0xF0, SEND_DATA_FLAG);
 	
@@ -157,36 +156,54 @@ void EduBase_LCD_Send_Data(uint8_t data)
 
 void EduBase_LCD_Init(void)
 {
-	//Initialize the GPIO pins used by the LCD
-	EduBase_LCD_Ports_Init();
-	
-	//Provide a delay of 50 ms after the LCD is powered on
-	SysTick_Delay1us(50000);
-	
-	//Transmit function set initialization commands as part of the LCD initialization sequence
-	EduBase_LCD_Write_4_Bits(FUNCTION_SET | CONFIG_EIGHT_BIT_MODE, SEND_COMMAND_FLAG);
-	SysTick_Delay1us(4500);
-	
-	//This was the problem
-	EduBase_LCD_Write_4_Bits(FUNCTION_SET | CONFIG_EIGHT_BIT_MODE, SEND_COMMAND_FLAG);
-	SysTick_Delay1us(4500);
+	uint32_t wait_us;
 	
+	//Run the initialization steps one after another
+	for (uint8_t step = 0; (wait_us = EduBase_LCD_Init_Step(step)) != BOOT_STEP_DONE; step++)
+	{
+		SysTick_Delay1us(wait_us);
+	}
+}
 
-	EduBase_LCD_Write_4_Bits(FUNCTION_SET | CONFIG_EIGHT_BIT_MODE, SEND_COMMAND_FLAG);
-	SysTick_Delay1us(150);
-	
-	//Transmit a Function Set command to the LCD to configure it to use 4-bit mode
-	EduBase_LCD_Write_4_Bits(FUNCTION_SET | CONFIG_FOUR_BIT_MODE, SEND_COMMAND_FLAG);
-	
-	//Configure the LCD to use 5x8 dots and two rows
-	EduBase_LCD_Send_Command(FUNCTION_SET | CONFIG_5x8_DOTS | CONFIG_TWO_LINES);
-	
-	//Transmit a Display Control command to enable the display of the LCD
-	EduBase_LCD_Enable_Display();
-	
-	//Transmit a Clear Display command to clear the display and set the DDRAM address to 0
-	EduBase_LCD_Clear_Display();
-	
+uint32_t EduBase_LCD_Init_Step(uint8_t step)
+{
+	switch (step)
+	{
+		case 0:
+			//Initialize the GPIO pins used by the LCD
+			EduBase_LCD_Ports_Init();
+			
+			//Provide a delay of 50 ms after the LCD is powered on
+			return 50000;
+		
+		case 1:
+			//Transmit function set initialization commands as part of the LCD initialization sequence
+			EduBase_LCD_Write_4_Bits(FUNCTION_SET | CONFIG_EIGHT_BIT_MODE, SEND_COMMAND_FLAG);
+			return 4500;
+		
+		case 2:
+			//This was the problem
+			EduBase_LCD_Write_4_Bits(FUNCTION_SET | CONFIG_EIGHT_BIT_MODE, SEND_COMMAND_FLAG);
+			return 4500;
+		
+		case 3:
+			EduBase_LCD_Write_4_Bits(FUNCTION_SET | CONFIG_EIGHT_BIT_MODE, SEND_COMMAND_FLAG);
+			return 150;
+		
+		default:
+			//Transmit a Function Set command to the LCD to configure it to use 4-bit mode
+			EduBase_LCD_Write_4_Bits(FUNCTION_SET | CONFIG_FOUR_BIT_MODE, SEND_COMMAND_FLAG);
+			
+			//Configure the LCD to use 5x8 dots and two rows
+			EduBase_LCD_Send_Command(FUNCTION_SET | CONFIG_5x8_DOTS | CONFIG_TWO_LINES);
+			
+			//Transmit a Display Control command to enable the display of the LCD
+			EduBase_LCD_Enable_Display();
+			
+			//Transmit a Clear Display command to clear the display and set the DDRAM address to 0
+			EduBase_LCD_Clear_Display();
+			return BOOT_STEP_DONE;
+	}
 }
 
 void EduBase_LCD_Clear_Display(void)
@@ -206,10 +223,39 @@ void EduBase_LCD_Enable_Display(void)
 	EduBase_LCD_Send_Command(DISPLAY_CONTROL | display_control);
 }
 
+void EduBase_LCD_Set_Cursor(uint8_t row, uint8_t column)
+{
+	//The second row starts at DDRAM address 0x40
+	EduBase_LCD_Send_Command(SET_DDRAM_ADDR | ((row == 0) ? 0x00 : 0x40) | (column & 0x3F));
+}
+
+uint8_t EduBase_LCD_Get_Address(void)
+{
+	return ddram_address;
+}
+
+void EduBase_LCD_Sync_Address(uint8_t address)
+{
+	ddram_address = address;
+	cgram_selected = 0;
+}
+
+void EduBase_LCD_Set_Bus(uint8_t nibble, uint8_t control_flag)
+{
+	GPIO_Write_Bus(LCD_DATA_PORT, LCD_DATA_MASK, (nibble & 0x0F) << 0x2);
+	GPIO_Write(LCD_RS_PIN, control_flag & 0x01);
+}
+
+void EduBase_LCD_Set_Enable(uint8_t level)
+{
+	GPIO_Write(LCD_ENABLE_PIN, level & 0x01);
+}
+
 void EduBase_LCD_Display_String(char* string)
 {
-	for (unsigned int i = 0; i < strlen(string); i++)
+	while (*string != '\0')
 	{
-		EduBase_LCD_Send_Data(string[i]);
+		EduBase_LCD_Send_Data(*string);
+		string++;
 	}
 }
\ No newline at end of file
@@ -21,6 +21,7 @@
 
 #include "TM4C123GH6PM.h"
 #include "SysTick_Delay.h"
+#include "GPIO.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -161,6 +162,18 @@ void EduBase_LCD_Send_Data(uint8_t data);
  */
 void EduBase_LCD_Init(void);
 
+/**
+ * @brief Runs one step of the LCD initialization, for the Boot_Sequencer driver.
+ *
+ * The steps are the same as those of EduBase_LCD_Init, which waits between them.
+ * Step 0 initializes the GPIO pins and step 4 sets up the LCD configuration.
+ *
+ * @param step The step to run (0 to 4).
+ *
+ * @return The wait in microseconds before the next step, or BOOT_STEP_DONE after the last step.
+ */
+uint32_t EduBase_LCD_Init_Step(uint8_t step);
+
 /**
  * @brief Clears the display of the LCD.
  *
@@ -195,11 +208,69 @@ void EduBase_LCD_Disable_Display(void);
  */
 void EduBase_LCD_Enable_Display(void);
 
+/**
+ * @brief Moves the cursor of the LCD.
+ *
+ * This function sends a Set DDRAM Address command so that the next character is
+ * displayed at the given position.
+ *
+ * @param row The row of the cursor (0 or 1).
+ *
+ * @param column The column of the cursor (0 - 15).
+ *
+ * @return None
+ */
+void EduBase_LCD_Set_Cursor(uint8_t row, uint8_t column);
+
+/**
+ * @brief Returns the current DDRAM address of the LCD.
+ *
+ * The address is tracked by the driver, since the R/W pin of the LCD is not connected.
+ * It assumes that the entry mode increments the address, which is the default.
+ *
+ * @param None
+ *
+ * @return The DDRAM address where the next character will be displayed.
+ */
+uint8_t EduBase_LCD_Get_Address(void);
+
+/**
+ * @brief Updates the tracked DDRAM address after the LCD was written by the LCD_Stream driver.
+ *
+ * @param address The DDRAM address of the cursor on the LCD.
+ *
+ * @return None
+ */
+void EduBase_LCD_Sync_Address(uint8_t address);
+
+/**
+ * @brief Sets the data lines and the register select pin without pulsing the enable pin.
+ *
+ * This function is used by the LCD_Stream driver, which times the enable pulse itself.
+ *
+ * @param nibble The 4-bit value of the data lines (D7 - D4).
+ *
+ * @param control_flag 0 for a command write, or 1 for a data write.
+ *
+ * @return None
+ */
+void EduBase_LCD_Set_Bus(uint8_t nibble, uint8_t control_flag);
+
+/**
+ * @brief Sets or clears the LCD enable pin (PC6).
+ *
+ * @param level 1 to set the pin high, or 0 to clear it.
+ *
+ * @return None
+ */
+void EduBase_LCD_Set_Enable(uint8_t level);
+
 /**
  * @brief Displays a string on the LCD.
  *
  * This function displays a null-terminated string on the LCD. The string is iterated 
  * character by character until the end of the string is reached.
+ * Static screens should be precompiled and played with LCD_Stream_Play instead.
  *
  * @param string A char pointer that holds the address of a sequence of char values (i.e. string).
  *
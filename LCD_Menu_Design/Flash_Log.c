@@ -0,0 +1,363 @@
+/**
+ * @file Flash_Log.c
+ *
+ * @brief Source code for the Flash_Log driver.
+ *
+ * This file contains the function definitions for the Flash_Log driver.
+ * It buffers the appended text in RAM and programs whole records with the
+ * write buffer of the flash memory controller.
+ */
+
+#include "Flash_Log.h"
+
+// Write key expected in Bits 31 to 16 of the FMC and FMC2 registers
+// (the KEY bit of the BOOTCFG register is set on an unprogrammed device)
+#define FMC_WRKEY           0xA4420000
+
+// WRITE (Bit 0) and ERASE (Bit 1) bits of the FMC register
+#define FMC_WRITE           0x01
+#define FMC_ERASE           0x02
+
+// WRBUF bit (Bit 0) of the FMC2 register
+#define FMC2_WRBUF          0x01
+
+// Header: magic number (Bits 31 to 24), flags (Bits 23 to 16),
+// text length (Bits 15 to 8) and checksum (Bits 7 to 0)
+#define RECORD_MAGIC        0x4C
+
+#define FLASH_LOG_PAGES     ((FLASH_LOG_SECTORS * FLASH_LOG_SECTOR_SIZE) / FLASH_LOG_PAGE_SIZE)
+#define PAGES_PER_SECTOR    (FLASH_LOG_SECTOR_SIZE / FLASH_LOG_PAGE_SIZE)
+#define PAGE_WORDS          (FLASH_LOG_PAGE_SIZE / 4)
+
+// The indexed records must never be in the sectors that are erased ahead of the write pointer
+#if FLASH_LOG_INDEX_SIZE > (FLASH_LOG_PAGES - (2 * PAGES_PER_SECTOR))
+#error "FLASH_LOG_INDEX_SIZE is too large for the size of the log"
+#endif
+
+typedef struct
+{
+	uint32_t header;
+	uint32_t sequence;
+	uint32_t start_ms;
+	uint32_t end_ms;
+	char text[FLASH_LOG_TEXT_SIZE];
+} Flash_Log_Record;
+
+// The record being filled, and the record waiting to be programmed (0 if there is none)
+static Flash_Log_Record record_buffers[2];
+static Flash_Log_Record *active_record = &record_buffers[0];
+static Flash_Log_Record *queued_record = 0;
+static uint8_t active_length = 0;
+static uint8_t message_ended = 0;
+static uint32_t last_append_ms = 0;
+
+static uint16_t write_page = 0;
+static uint32_t next_sequence = 0;
+
+// Sector to erase ahead of the write pointer, or -1 if there is none
+static int16_t erase_sector = -1;
+
+// Pages of the most recent records. The head is the position of the next record.
+static uint16_t index_pages[FLASH_LOG_INDEX_SIZE];
+static uint8_t index_head = 0;
+static uint8_t index_count = 0;
+
+volatile uint32_t Flash_Log_Records_Written = 0;
+volatile uint32_t Flash_Log_Dropped = 0;
+
+static const Flash_Log_Record *Flash_Log_Page(uint16_t page)
+{
+	return (const Flash_Log_Record *)(FLASH_LOG_START + ((uint32_t)page * FLASH_LOG_PAGE_SIZE));
+}
+
+static uint8_t Flash_Log_Checksum(const Flash_Log_Record *record)
+{
+	// 8-bit sum of every byte after the header
+	const uint8_t *bytes = (const uint8_t *)record;
+	uint8_t sum = 0;
+
+	for (uint8_t i = 4; i < FLASH_LOG_PAGE_SIZE; i++)
+	{
+		sum += bytes[i];
+	}
+
+	return sum;
+}
+
+static uint8_t Flash_Log_Valid(const Flash_Log_Record *record)
+{
+	uint32_t header = record->header;
+
+	return ((header >> 24) == RECORD_MAGIC) &&
+	       (((header >> 8) & 0xFF) <= FLASH_LOG_TEXT_SIZE) &&
+	       ((header & 0xFF) == Flash_Log_Checksum(record));
+}
+
+static uint8_t Flash_Log_Blank(uint32_t address, uint32_t num_words)
+{
+	const uint32_t *words = (const uint32_t *)address;
+
+	for (uint32_t i = 0; i < num_words; i++)
+	{
+		if (words[i] != 0xFFFFFFFF)
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+static uint8_t Flash_Log_Busy(void)
+{
+	return ((FLASH_CTRL->FMC & (FMC_WRITE | FMC_ERASE)) != 0) || ((FLASH_CTRL->FMC2 & FMC2_WRBUF) != 0);
+}
+
+static void Flash_Log_Start_Erase(uint16_t sector)
+{
+	// Write the address of the sector to the FMA register and set the ERASE bit
+	FLASH_CTRL->FMA = FLASH_LOG_START + ((uint32_t)sector * FLASH_LOG_SECTOR_SIZE);
+	FLASH_CTRL->FMC = FMC_WRKEY | FMC_ERASE;
+}
+
+static void Flash_Log_Start_Program(const Flash_Log_Record *record, uint16_t page)
+{
+	const uint32_t *words = (const uint32_t *)record;
+
+	// Fill the 32-word write buffer (FWB0 to FWB31 registers)
+	for (uint8_t i = 0; i < PAGE_WORDS; i++)
+	{
+		(&FLASH_CTRL->FWBN)[i] = words[i];
+	}
+
+	// Write the address of the 32-word aligned block to the FMA register
+	// and set the WRBUF bit of the FMC2 register to program the whole buffer
+	FLASH_CTRL->FMA = (uint32_t)Flash_Log_Page(page);
+	FLASH_CTRL->FMC2 = FMC_WRKEY | FMC2_WRBUF;
+}
+
+static void Flash_Log_Index_Add(uint16_t page)
+{
+	index_pages[index_head] = page;
+	index_head = (uint8_t)((index_head + 1) % FLASH_LOG_INDEX_SIZE);
+
+	if (index_count < FLASH_LOG_INDEX_SIZE)
+	{
+		index_count++;
+	}
+}
+
+static void Flash_Log_Advance(void)
+{
+	write_page = (uint16_t)((write_page + 1) % FLASH_LOG_PAGES);
+
+	// Entering a new sector: erase the next one before the write pointer reaches it
+	if ((write_page % PAGES_PER_SECTOR) == 0)
+	{
+		erase_sector = (int16_t)(((write_page / PAGES_PER_SECTOR) + 1) % FLASH_LOG_SECTORS);
+	}
+}
+
+static uint8_t Flash_Log_Queue(uint8_t flags)
+{
+	if (queued_record != 0) return 0;
+
+	Flash_Log_Record *record = active_record;
+
+	// Leave the unused text erased
+	for (uint8_t i = active_length; i < FLASH_LOG_TEXT_SIZE; i++)
+	{
+		record->text[i] = (char)0xFF;
+	}
+
+	record->sequence = next_sequence++;
+	record->header = ((uint32_t)RECORD_MAGIC << 24) | ((uint32_t)flags << 16) |
+	                 ((uint32_t)active_length << 8) | Flash_Log_Checksum(record);
+
+	queued_record = record;
+	active_record = (record == &record_buffers[0]) ? &record_buffers[1] : &record_buffers[0];
+	active_length = 0;
+	message_ended = 0;
+
+	return 1;
+}
+
+uint8_t Flash_Log_Init(void)
+{
+	int32_t newest = -1;
+	uint32_t newest_sequence = 0;
+
+	// Find the newest valid record in one pass over the log
+	for (uint16_t page = 0; page < FLASH_LOG_PAGES; page++)
+	{
+		const Flash_Log_Record *record = Flash_Log_Page(page);
+
+		if (Flash_Log_Valid(record) &&
+		    ((newest < 0) || ((int32_t)(record->sequence - newest_sequence) > 0)))
+		{
+			newest = page;
+			newest_sequence = record->sequence;
+		}
+	}
+
+	index_head = 0;
+	index_count = 0;
+	erase_sector = -1;
+	queued_record = 0;
+	active_length = 0;
+	message_ended = 0;
+
+	if (newest < 0)
+	{
+		write_page = 0;
+		next_sequence = 0;
+	}
+	else
+	{
+		write_page = (uint16_t)((newest + 1) % FLASH_LOG_PAGES);
+		next_sequence = newest_sequence + 1;
+
+		// Walk back from the newest record while the sequence numbers are consecutive,
+		// then index the records from the oldest to the newest
+		uint8_t found = 1;
+		uint16_t page = (uint16_t)newest;
+
+		while (found < FLASH_LOG_INDEX_SIZE)
+		{
+			uint16_t previous = (uint16_t)((page + FLASH_LOG_PAGES - 1) % FLASH_LOG_PAGES);
+			const Flash_Log_Record *record = Flash_Log_Page(previous);
+
+			if (!Flash_Log_Valid(record) || (record->sequence != (Flash_Log_Page(page)->sequence - 1)))
+			{
+				break;
+			}
+
+			page = previous;
+			found++;
+		}
+
+		for (uint8_t i = 0; i < found; i++)
+		{
+			Flash_Log_Index_Add((uint16_t)((page + i) % FLASH_LOG_PAGES));
+		}
+	}
+
+	// A record torn by a reset leaves the page after the newest record dirty.
+	// Continue at the start of the next sector, which is erased now.
+	if (!Flash_Log_Blank((uint32_t)Flash_Log_Page(write_page), PAGE_WORDS))
+	{
+		uint16_t sector = (uint16_t)(((write_page / PAGES_PER_SECTOR) + 1) % FLASH_LOG_SECTORS);
+
+		write_page = (uint16_t)(sector * PAGES_PER_SECTOR);
+
+		Flash_Log_Start_Erase(sector);
+		while (Flash_Log_Busy());
+	}
+
+	// Make sure that the sector after the write pointer is erased
+	uint16_t next_sector = (uint16_t)(((write_page / PAGES_PER_SECTOR) + 1) % FLASH_LOG_SECTORS);
+
+	if (!Flash_Log_Blank(FLASH_LOG_START + ((uint32_t)next_sector * FLASH_LOG_SECTOR_SIZE), FLASH_LOG_SECTOR_SIZE / 4))
+	{
+		erase_sector = (int16_t)next_sector;
+	}
+
+	return index_count;
+}
+
+void Flash_Log_Append(char character, uint32_t timestamp_ms)
+{
+	// Hand over the full or ended record, or drop the character if the previous one is still queued
+	if ((active_length >= FLASH_LOG_TEXT_SIZE) || message_ended)
+	{
+		if (!Flash_Log_Queue(message_ended ? 0 : FLASH_LOG_CONTINUES))
+		{
+			Flash_Log_Dropped = Flash_Log_Dropped + 1;
+			return;
+		}
+	}
+
+	if (active_length == 0)
+	{
+		active_record->start_ms = timestamp_ms;
+	}
+
+	active_record->text[active_length++] = character;
+	active_record->end_ms = timestamp_ms;
+	last_append_ms = timestamp_ms;
+}
+
+void Flash_Log_End_Message(void)
+{
+	if (active_length > 0)
+	{
+		message_ended = 1;
+	}
+}
+
+void Flash_Log_Process(uint32_t now_ms)
+{
+	// Wait for the previous operation to complete
+	if (Flash_Log_Busy()) return;
+
+	// Hand over the current record once it is full or its message has ended
+	if ((active_length > 0) && (queued_record == 0))
+	{
+		if (message_ended || ((now_ms - last_append_ms) >= FLASH_LOG_IDLE_MS))
+		{
+			Flash_Log_Queue(0);
+		}
+		else if (active_length >= FLASH_LOG_TEXT_SIZE)
+		{
+			Flash_Log_Queue(FLASH_LOG_CONTINUES);
+		}
+	}
+
+	if (erase_sector >= 0)
+	{
+		Flash_Log_Start_Erase((uint16_t)erase_sector);
+		erase_sector = -1;
+	}
+	else if (queued_record != 0)
+	{
+		Flash_Log_Start_Program(queued_record, write_page);
+		Flash_Log_Index_Add(write_page);
+		Flash_Log_Advance();
+
+		// The record has been copied to the write buffer
+		queued_record = 0;
+		Flash_Log_Records_Written = Flash_Log_Records_Written + 1;
+	}
+}
+
+void Flash_Log_Flush(void)
+{
+	Flash_Log_End_Message();
+
+	while ((active_length > 0) || (queued_record != 0) || (erase_sector >= 0) || Flash_Log_Busy())
+	{
+		Flash_Log_Process(last_append_ms);
+	}
+}
+
+uint8_t Flash_Log_Count(void)
+{
+	return index_count;
+}
+
+uint8_t Flash_Log_Read(uint8_t age, Flash_Log_Entry *entry)
+{
+	if (age >= index_count) return 0;
+
+	uint16_t page = index_pages[(index_head + FLASH_LOG_INDEX_SIZE - 1 - age) % FLASH_LOG_INDEX_SIZE];
+	const Flash_Log_Record *record = Flash_Log_Page(page);
+
+	entry->sequence = record->sequence;
+	entry->start_ms = record->start_ms;
+	entry->end_ms = record->end_ms;
+	entry->length = (uint8_t)((record->header >> 8) & 0xFF);
+	entry->flags = (uint8_t)((record->header >> 16) & 0xFF);
+	entry->text = record->text;
+
+	return 1;
+}
@@ -0,0 +1,158 @@
+/**
+ * @file Flash_Log.h
+ *
+ * @brief Header file for the Flash_Log driver.
+ *
+ * This file contains the function definitions for the Flash_Log driver.
+ * It keeps the decoded Morse messages in an append-only ring log in the internal flash memory,
+ * so that they can be read back after a reset.
+ *
+ * The log occupies the last FLASH_LOG_SECTORS 1 KB sectors of the flash memory, and is written
+ * in 128-byte records. A record holds up to FLASH_LOG_TEXT_SIZE characters, the time of its first
+ * and last character, a sequence number and a checksum. Appended characters are collected in RAM,
+ * and a record is only programmed when it is full or when its message ends, so that the flash
+ * controller programs one whole 32-word write buffer at a time instead of a word per character.
+ *
+ * The write pointer moves through the sectors in a ring. When it enters a sector, the following
+ * sector is erased in the background, so that the oldest messages are discarded a sector at a time
+ * and a sector is always ready ahead of the write pointer. A RAM index of the most recent records
+ * is built at boot and kept up to date, so reading back a recent message does not search the flash.
+ *
+ * Flash_Log_Append only writes to RAM. Programming and erasing are started by Flash_Log_Process
+ * from the main loop, one operation per call, without waiting for them to complete.
+ *
+ * @note The CPU stalls when it fetches from the flash memory while a sector is being erased,
+ * so an interrupt can be delayed by the erase time (up to about 15 ms).
+ *
+ * @note The linker must not place code in the log area. The IROM1 region of the project
+ * ends at FLASH_LOG_START for this reason.
+ *
+ * @note For more information regarding the flash memory controller, refer to the
+ * "Internal Memory" chapter of the TM4C123GH6PM Microcontroller Datasheet.
+ * Link: https://www.ti.com/lit/ds/symlink/tm4c123gh6pm.pdf
+ */
+
+#ifndef FLASH_LOG_H
+#define FLASH_LOG_H
+
+#include "TM4C123GH6PM.h"
+
+// Location of the log in the flash memory
+#define FLASH_LOG_START 0x0003C000
+#define FLASH_LOG_SECTORS 16
+#define FLASH_LOG_SECTOR_SIZE 1024
+
+// Size of a record (one flash write buffer) and of the text it holds
+#define FLASH_LOG_PAGE_SIZE 128
+#define FLASH_LOG_TEXT_SIZE 112
+
+// Number of recent records kept in the RAM index
+#define FLASH_LOG_INDEX_SIZE 32
+
+// Time in milliseconds without new characters after which a message ends
+#define FLASH_LOG_IDLE_MS 10000
+
+// Record flags
+#define FLASH_LOG_CONTINUES 0x01
+
+typedef struct
+{
+	uint32_t sequence;
+	uint32_t start_ms;
+	uint32_t end_ms;
+	uint8_t length;
+	uint8_t flags;
+
+	// Text of the record in the flash memory (not null-terminated)
+	const char *text;
+} Flash_Log_Entry;
+
+// Number of records programmed since reset
+extern volatile uint32_t Flash_Log_Records_Written;
+
+// Number of characters lost because both RAM buffers were full
+extern volatile uint32_t Flash_Log_Dropped;
+
+/**
+ * @brief Locates the write pointer and builds the index of recent records.
+ *
+ * This function reads the header of every record in one pass, continues after the
+ * newest valid record and indexes the records that precede it. A record torn by a
+ * reset is skipped.
+ *
+ * @param None
+ *
+ * @return The number of records in the index.
+ */
+uint8_t Flash_Log_Init(void);
+
+/**
+ * @brief Appends a character to the current message.
+ *
+ * This function only writes to RAM and never waits for the flash memory.
+ *
+ * @param character The character to append.
+ *
+ * @param timestamp_ms The time at which the character was decoded.
+ *
+ * @return None
+ */
+void Flash_Log_Append(char character, uint32_t timestamp_ms);
+
+/**
+ * @brief Ends the current message.
+ *
+ * The characters appended since the last message are committed by the next call to
+ * Flash_Log_Process. A message also ends after FLASH_LOG_IDLE_MS without new characters.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Flash_Log_End_Message(void);
+
+/**
+ * @brief Commits the buffered records and erases sectors in the background.
+ *
+ * This function must be called from the main loop. It returns immediately, and starts
+ * at most one flash operation per call.
+ *
+ * @param now_ms The current time in milliseconds.
+ *
+ * @return None
+ */
+void Flash_Log_Process(uint32_t now_ms);
+
+/**
+ * @brief Ends the current message and waits until it has been programmed.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Flash_Log_Flush(void);
+
+/**
+ * @brief Returns the number of records that can be read with Flash_Log_Read.
+ *
+ * @param None
+ *
+ * @return The number of records in the index.
+ */
+uint8_t Flash_Log_Count(void);
+
+/**
+ * @brief Reads a recent record.
+ *
+ * A message longer than FLASH_LOG_TEXT_SIZE characters is split over several records, with
+ * FLASH_LOG_CONTINUES set in every record but the last one.
+ *
+ * @param age The position of the record from the newest one (0 is the newest record).
+ *
+ * @param entry A pointer to where the record is described.
+ *
+ * @return 1 if the record was read, or 0 if age is not less than Flash_Log_Count().
+ */
+uint8_t Flash_Log_Read(uint8_t age, Flash_Log_Entry *entry);
+
+#endif
@@ -0,0 +1,101 @@
+/**
+ * @file GPIO.c
+ *
+ * @brief Source code for the GPIO driver.
+ *
+ * This file contains the function definitions for the GPIO driver.
+ * The pin access functions are defined inline in GPIO.h.
+ */
+
+#include "GPIO.h"
+
+static uint8_t GPIO_Port_Clock_Bit(GPIOA_Type *port)
+{
+	// Ports A to D are 4 KB apart starting at 0x40004000,
+	// and Ports E and F are 4 KB apart starting at 0x40024000
+	uint32_t address = (uint32_t)port;
+	
+	if (address >= (uint32_t)GPIOE)
+	{
+		return (uint8_t)(1 << (4 + ((address - (uint32_t)GPIOE) >> 12)));
+	}
+	
+	return (uint8_t)(1 << ((address - (uint32_t)GPIOA) >> 12));
+}
+
+void GPIO_Configure(GPIOA_Type *port, uint8_t mask, uint8_t flags)
+{
+	uint8_t clock_bit = GPIO_Port_Clock_Bit(port);
+	
+	// Enable the clock to the port in the RCGCGPIO register
+	// and wait until the port is ready in the PRGPIO register
+	SYSCTL->RCGCGPIO |= clock_bit;
+	while ((SYSCTL->PRGPIO & clock_bit) == 0);
+	
+	// Set the initial level of output pins before they start driving
+	GPIO_MASKED_DATA(port, mask) = (flags & GPIO_INIT_HIGH) ? mask : 0;
+	
+	// Configure the direction of the pins in the DIR register
+	if (flags & GPIO_OUTPUT)
+	{
+		port->DIR |= mask;
+	}
+	else
+	{
+		port->DIR &= ~mask;
+	}
+	
+	// Select the GPIO or alternate function in the AFSEL register
+	if (flags & GPIO_ALTERNATE)
+	{
+		port->AFSEL |= mask;
+	}
+	else
+	{
+		port->AFSEL &= ~mask;
+	}
+	
+	// Configure the pull-up, pull-down and open-drain settings
+	if (flags & GPIO_PULL_UP)
+	{
+		port->PUR |= mask;
+	}
+	else if (flags & GPIO_PULL_DOWN)
+	{
+		port->PDR |= mask;
+	}
+	else
+	{
+		port->PUR &= ~mask;
+		port->PDR &= ~mask;
+	}
+	
+	if (flags & GPIO_OPEN_DRAIN)
+	{
+		port->ODR |= mask;
+	}
+	else
+	{
+		port->ODR &= ~mask;
+	}
+	
+	// Select analog or digital functionality in the AMSEL and DEN registers
+	if (flags & GPIO_ANALOG)
+	{
+		port->DEN &= ~mask;
+		port->AMSEL |= mask;
+	}
+	else
+	{
+		port->AMSEL &= ~mask;
+		port->DEN |= mask;
+	}
+}
+
+void GPIO_Configure_Table(const GPIO_Config *table, uint8_t num_entries)
+{
+	for (uint8_t i = 0; i < num_entries; i++)
+	{
+		GPIO_Configure(table[i].port, table[i].mask, table[i].flags);
+	}
+}
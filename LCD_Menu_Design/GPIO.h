@@ -0,0 +1,178 @@
+/**
+ * @file GPIO.h
+ *
+ * @brief Header file for the GPIO driver.
+ *
+ * This file contains the function definitions for the GPIO driver.
+ * It provides pin descriptors and atomic pin access for Ports A to F.
+ *
+ * A pin descriptor (GPIO_Pin) holds the port and the bit mask of one or more pins of the
+ * same port. Descriptors are meant to be declared as static const variables or built with
+ * the GPIO_PIN macro, so that the inline access functions below fold into a single store.
+ *
+ * The TM4C123GH6PM decodes address bits [9:2] of an access to the DATA register as a bit mask:
+ * only the pins selected by the address are written, and the other pins of the port are left
+ * unchanged. The access functions therefore write through the masked DATA address of their
+ * pins instead of doing a read-modify-write on GPIOx->DATA. A write changes only its own pins
+ * and cannot be corrupted by an interrupt service routine that writes other pins of the
+ * same port in between.
+ *
+ * @note For more information regarding the masked DATA register, refer to the
+ * "Data Register Operation" section of the TM4C123GH6PM Microcontroller Datasheet.
+ * Link: https://www.ti.com/lit/ds/symlink/tm4c123gh6pm.pdf
+ */
+
+#ifndef GPIO_H
+#define GPIO_H
+
+#include "TM4C123GH6PM.h"
+
+typedef struct
+{
+	GPIOA_Type *port;
+	uint8_t mask;
+} GPIO_Pin;
+
+// Builds a pin descriptor for pin number (0 - 7) of a port, e.g. GPIO_PIN(GPIOC, 6) for PC6
+#define GPIO_PIN(gpio_port, pin_number) ((GPIO_Pin){ (gpio_port), (uint8_t)(1U << (pin_number)) })
+
+// Address of the DATA register alias that only accesses the pins in the mask
+#define GPIO_MASKED_DATA(gpio_port, pin_mask) \
+	(*((volatile uint32_t *)((uint32_t)(gpio_port) + ((uint32_t)(pin_mask) << 2))))
+
+// Configuration flags used by GPIO_Configure
+enum GPIO_Config_Flags
+{
+	GPIO_INPUT      = 0x00,
+	GPIO_OUTPUT     = 0x01,
+	GPIO_PULL_UP    = 0x02,
+	GPIO_PULL_DOWN  = 0x04,
+	GPIO_OPEN_DRAIN = 0x08,
+	GPIO_ALTERNATE  = 0x10,
+	GPIO_ANALOG     = 0x20,
+	GPIO_INIT_HIGH  = 0x40
+};
+
+typedef struct
+{
+	GPIOA_Type *port;
+	uint8_t mask;
+	uint8_t flags;
+} GPIO_Config;
+
+/**
+ * @brief Drives the pins of a descriptor high.
+ *
+ * @param pin The pin descriptor.
+ *
+ * @return None
+ */
+static __inline void GPIO_Set(GPIO_Pin pin)
+{
+	GPIO_MASKED_DATA(pin.port, pin.mask) = pin.mask;
+}
+
+/**
+ * @brief Drives the pins of a descriptor low.
+ *
+ * @param pin The pin descriptor.
+ *
+ * @return None
+ */
+static __inline void GPIO_Clear(GPIO_Pin pin)
+{
+	GPIO_MASKED_DATA(pin.port, pin.mask) = 0;
+}
+
+/**
+ * @brief Drives the pins of a descriptor high if value is non-zero, or low otherwise.
+ *
+ * @param pin The pin descriptor.
+ *
+ * @param value The level to output.
+ *
+ * @return None
+ */
+static __inline void GPIO_Write(GPIO_Pin pin, uint32_t value)
+{
+	GPIO_MASKED_DATA(pin.port, pin.mask) = value ? pin.mask : 0;
+}
+
+/**
+ * @brief Writes a value to a group of pins of the same port with a single store.
+ *
+ * The value is aligned with the port, e.g. GPIO_Write_Bus(GPIOA, 0x3C, 0x14) drives
+ * PA4 and PA2 high and PA5 and PA3 low. Pins outside of the mask are not affected.
+ *
+ * @param port The GPIO port.
+ *
+ * @param mask The bit mask of the pins to write.
+ *
+ * @param value The value to output on the pins.
+ *
+ * @return None
+ */
+static __inline void GPIO_Write_Bus(GPIOA_Type *port, uint8_t mask, uint8_t value)
+{
+	GPIO_MASKED_DATA(port, mask) = value;
+}
+
+/**
+ * @brief Inverts the pins of a descriptor.
+ *
+ * Only the pins of the descriptor are accessed. The toggle itself is a read followed
+ * by a write, so it must not race with another writer of the same pins.
+ *
+ * @param pin The pin descriptor.
+ *
+ * @return None
+ */
+static __inline void GPIO_Toggle(GPIO_Pin pin)
+{
+	GPIO_MASKED_DATA(pin.port, pin.mask) ^= pin.mask;
+}
+
+/**
+ * @brief Reads the pins of a descriptor.
+ *
+ * @param pin The pin descriptor.
+ *
+ * @return The current level of the pins, aligned with the port (0 if all pins are low).
+ */
+static __inline uint8_t GPIO_Read(GPIO_Pin pin)
+{
+	return (uint8_t)GPIO_MASKED_DATA(pin.port, pin.mask);
+}
+
+/**
+ * @brief Configures a group of pins of the same port.
+ *
+ * This function enables the clock to the port and configures every pin in the mask
+ * at once according to the flags (see GPIO_Config_Flags). Pins configured with GPIO_ALTERNATE
+ * must have their PCTL field set by the caller. Output pins start low unless GPIO_INIT_HIGH is set.
+ *
+ * @param port The GPIO port (GPIOA to GPIOF).
+ *
+ * @param mask The bit mask of the pins to configure.
+ *
+ * @param flags The configuration flags.
+ *
+ * @return None
+ */
+void GPIO_Configure(GPIOA_Type *port, uint8_t mask, uint8_t flags);
+
+/**
+ * @brief Configures the pins listed in a table.
+ *
+ * This function calls GPIO_Configure for each entry, so that a driver can describe
+ * all of its pins in one constant table.
+ *
+ * @param table A pointer to the configuration table.
+ *
+ * @param num_entries The number of entries in the table.
+ *
+ * @return None
+ */
+void GPIO_Configure_Table(const GPIO_Config *table, uint8_t num_entries);
+
+#endif
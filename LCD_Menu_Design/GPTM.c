@@ -0,0 +1,488 @@
+/**
+ * @file GPTM.c
+ *
+ * @brief Source code for the GPTM driver.
+ *
+ * This file contains the function definitions for the GPTM driver.
+ * It keeps track of the claimed channels, computes the load and match values of
+ * each mode from the system clock, and dispatches the interrupts of all 24 channels.
+ */
+
+#include "GPTM.h"
+#include "Trace_Recorder.h"
+#include "Interrupt_Config.h"
+
+// The registers of the B half follow those of the A half by one word
+// (e.g. GPTMTBMR follows GPTMTAMR), so a half is selected with an offset
+#define HALF_REGISTER(timer, channel, reg) (*(&(timer)->reg + ((channel) & 1)))
+
+// The GPTMCTL and GPTMIMR bits of the B half are those of the A half shifted by 8
+#define HALF_SHIFT(channel) (((channel) & 1) * 8)
+
+// GPTMTnMR values of each mode
+#define MODE_ONE_SHOT 0x01
+#define MODE_PERIODIC 0x02
+#define MODE_EDGE_COUNT 0x13
+#define MODE_EDGE_TIME 0x17
+#define MODE_PWM 0x50A
+
+// GPTMIMR interrupts of the A half (time-out, capture match, capture event, RTC and match)
+#define INTERRUPTS_A 0x1F
+
+typedef struct
+{
+	void (*task)(void);
+	void (*capture)(uint64_t time);
+
+	// Load value of a PWM channel, used to compute its match value
+	uint64_t pwm_load;
+} GPTM_Channel_State;
+
+static TIMER0_Type *const gptm_timers[GPTM_NUM_CHANNELS / 2] =
+{
+	TIMER0, TIMER1, TIMER2, TIMER3, TIMER4, TIMER5,
+	WTIMER0, WTIMER1, WTIMER2, WTIMER3, WTIMER4, WTIMER5
+};
+
+static const uint8_t gptm_irqs[GPTM_NUM_CHANNELS] =
+{
+	TIMER0A_IRQn, TIMER0B_IRQn, TIMER1A_IRQn, TIMER1B_IRQn,
+	TIMER2A_IRQn, TIMER2B_IRQn, TIMER3A_IRQn, TIMER3B_IRQn,
+	TIMER4A_IRQn, TIMER4B_IRQn, TIMER5A_IRQn, TIMER5B_IRQn,
+	WTIMER0A_IRQn, WTIMER0B_IRQn, WTIMER1A_IRQn, WTIMER1B_IRQn,
+	WTIMER2A_IRQn, WTIMER2B_IRQn, WTIMER3A_IRQn, WTIMER3B_IRQn,
+	WTIMER4A_IRQn, WTIMER4B_IRQn, WTIMER5A_IRQn, WTIMER5B_IRQn
+};
+
+static GPTM_Channel_State gptm_channels[GPTM_NUM_CHANNELS];
+
+// Bit masks of the claimed channels and of the A halves of concatenated timers
+static uint32_t claimed_channels = 0;
+static uint32_t concatenated_channels = 0;
+
+static TIMER0_Type *GPTM_Timer(uint8_t channel)
+{
+	return gptm_timers[channel >> 1];
+}
+
+static uint8_t GPTM_Is_Wide(uint8_t channel)
+{
+	return (channel >= GPTM_WTIMER0A);
+}
+
+static uint8_t GPTM_Is_Concatenated(uint8_t channel)
+{
+	return (concatenated_channels & (1UL << channel)) != 0;
+}
+
+// Width of the counter of a half, without its prescaler
+static uint8_t GPTM_Counter_Bits(uint8_t channel)
+{
+	return GPTM_Is_Wide(channel) ? 32 : 16;
+}
+
+static uint32_t GPTM_Prescaler_Max(uint8_t channel)
+{
+	return GPTM_Is_Wide(channel) ? 0xFFFF : 0xFF;
+}
+
+static void GPTM_Enable_Clock(uint8_t channel)
+{
+	uint8_t timer = channel >> 1;
+
+	if (GPTM_Is_Wide(channel))
+	{
+		uint32_t bit = 1UL << (timer - 6);
+		SYSCTL->RCGCWTIMER |= bit;
+		while ((SYSCTL->PRWTIMER & bit) == 0);
+	}
+	else
+	{
+		uint32_t bit = 1UL << timer;
+		SYSCTL->RCGCTIMER |= bit;
+		while ((SYSCTL->PRTIMER & bit) == 0);
+	}
+}
+
+uint8_t GPTM_Claim(uint8_t channel, uint8_t flags)
+{
+	if (channel >= GPTM_NUM_CHANNELS) return 0;
+
+	uint32_t mask = 1UL << channel;
+
+	if (flags & GPTM_CONCATENATE)
+	{
+		// A concatenated timer is claimed through its A half
+		if (channel & 1) return 0;
+
+		mask |= mask << 1;
+	}
+
+	uint32_t basepri = Interrupt_Lock(INTERRUPT_LEVEL_ALL);
+
+	if (claimed_channels & mask)
+	{
+		Interrupt_Unlock(INTERRUPT_LEVEL_ALL, basepri);
+		return 0;
+	}
+
+	claimed_channels |= mask;
+
+	if (flags & GPTM_CONCATENATE)
+	{
+		concatenated_channels |= (1UL << channel);
+	}
+
+	Interrupt_Unlock(INTERRUPT_LEVEL_ALL, basepri);
+
+	GPTM_Enable_Clock(channel);
+
+	return 1;
+}
+
+int8_t GPTM_Allocate(uint8_t flags)
+{
+	uint8_t first = (flags & GPTM_WIDE) ? GPTM_WTIMER0A : GPTM_TIMER0A;
+	uint8_t step = (flags & GPTM_CONCATENATE) ? 2 : 1;
+
+	for (uint8_t channel = first; channel < GPTM_NUM_CHANNELS; channel += step)
+	{
+		if (GPTM_Claim(channel, flags & GPTM_CONCATENATE))
+		{
+			return (int8_t)channel;
+		}
+	}
+
+	return -1;
+}
+
+void GPTM_Release(uint8_t channel)
+{
+	TIMER0_Type *timer = GPTM_Timer(channel);
+	uint32_t mask = 1UL << channel;
+
+	GPTM_Stop(channel);
+
+	// Mask the interrupts of the channel in the timer and in the NVIC
+	timer->IMR &= ~(INTERRUPTS_A << HALF_SHIFT(channel));
+	NVIC->ICER[gptm_irqs[channel] / 32] = (1UL << (gptm_irqs[channel] % 32));
+
+	gptm_channels[channel].task = 0;
+	gptm_channels[channel].capture = 0;
+
+	if (GPTM_Is_Concatenated(channel))
+	{
+		mask |= mask << 1;
+	}
+
+	uint32_t basepri = Interrupt_Lock(INTERRUPT_LEVEL_ALL);
+
+	claimed_channels &= ~mask;
+	concatenated_channels &= ~(1UL << channel);
+
+	Interrupt_Unlock(INTERRUPT_LEVEL_ALL, basepri);
+}
+
+// Stops the channel and selects its mode, with its interrupts masked and cleared
+static void GPTM_Configure(uint8_t channel, uint32_t mode)
+{
+	TIMER0_Type *timer = GPTM_Timer(channel);
+	uint8_t shift = HALF_SHIFT(channel);
+
+	timer->CTL &= ~(0x01UL << shift);
+
+	// The configuration is shared by both halves, so it is only written when it changes
+	uint32_t configuration = GPTM_Is_Concatenated(channel) ? 0x00 : 0x04;
+
+	if (timer->CFG != configuration)
+	{
+		timer->CFG = configuration;
+	}
+
+	HALF_REGISTER(timer, channel, TAMR) = mode;
+
+	timer->IMR &= ~(INTERRUPTS_A << shift);
+	timer->ICR = (INTERRUPTS_A << shift);
+}
+
+static void GPTM_Enable_Interrupt(uint8_t channel, uint32_t interrupt, uint8_t source)
+{
+	GPTM_Timer(channel)->IMR |= (interrupt << HALF_SHIFT(channel));
+
+	// The level of the interrupt comes from the entry of the priority plan
+	Interrupt_Config_Enable_IRQ(source, gptm_irqs[channel]);
+}
+
+static void GPTM_Enable(uint8_t channel)
+{
+	GPTM_Timer(channel)->CTL |= (0x01UL << HALF_SHIFT(channel));
+}
+
+// Writes a count-down load value of ticks system clock cycles
+static uint8_t GPTM_Set_Load(uint8_t channel, uint64_t ticks)
+{
+	TIMER0_Type *timer = GPTM_Timer(channel);
+
+	if (ticks == 0) return 0;
+
+	if (GPTM_Is_Concatenated(channel))
+	{
+		if (!GPTM_Is_Wide(channel) && (ticks > 0x100000000ULL)) return 0;
+
+		timer->TAILR = (uint32_t)(ticks - 1);
+
+		// A wide timer keeps the upper word of its 64-bit load in GPTMTBILR
+		if (GPTM_Is_Wide(channel))
+		{
+			timer->TBILR = (uint32_t)((ticks - 1) >> 32);
+		}
+
+		return 1;
+	}
+
+	// In the count-down modes, the prescaler divides the clock of a half. Use the
+	// smallest prescaler that lets the period fit the counter, to keep the resolution
+	uint8_t bits = GPTM_Counter_Bits(channel);
+	uint64_t prescale = (ticks - 1) >> bits;
+
+	if (prescale > GPTM_Prescaler_Max(channel)) return 0;
+
+	HALF_REGISTER(timer, channel, TAPR) = (uint32_t)prescale;
+	HALF_REGISTER(timer, channel, TAILR) = (uint32_t)((ticks / (prescale + 1)) - 1);
+
+	return 1;
+}
+
+// Sets the maximum count of a half whose prescaler extends the counter
+static void GPTM_Set_Full_Range(uint8_t channel)
+{
+	TIMER0_Type *timer = GPTM_Timer(channel);
+	uint32_t counter_max = (uint32_t)((1ULL << GPTM_Counter_Bits(channel)) - 1);
+
+	HALF_REGISTER(timer, channel, TAILR) = counter_max;
+	HALF_REGISTER(timer, channel, TAPR) = GPTM_Prescaler_Max(channel);
+	HALF_REGISTER(timer, channel, TAMATCHR) = counter_max;
+	HALF_REGISTER(timer, channel, TAPMR) = GPTM_Prescaler_Max(channel);
+}
+
+static void GPTM_Set_Edges(uint8_t channel, uint8_t edges)
+{
+	uint8_t shift = HALF_SHIFT(channel);
+	TIMER0_Type *timer = GPTM_Timer(channel);
+
+	// TnEVENT field (Bits 3 to 2 for Timer A, Bits 11 to 10 for Timer B)
+	timer->CTL = (timer->CTL & ~(0x0CUL << shift)) | ((uint32_t)(edges & 0x03) << (2 + shift));
+}
+
+static uint8_t GPTM_Start_Timeout(uint8_t channel, uint32_t mode, uint64_t ticks, void (*task)(void), uint8_t source)
+{
+	GPTM_Configure(channel, mode);
+
+	if (!GPTM_Set_Load(channel, ticks)) return 0;
+
+	gptm_channels[channel].task = task;
+
+	if (task != 0)
+	{
+		// Enable the time-out interrupt (TnTOIM)
+		GPTM_Enable_Interrupt(channel, 0x01, source);
+	}
+
+	GPTM_Enable(channel);
+
+	return 1;
+}
+
+uint8_t GPTM_Start_Periodic(uint8_t channel, uint32_t frequency_hz, void (*task)(void), uint8_t source)
+{
+	if (frequency_hz == 0) return 0;
+
+	return GPTM_Start_Timeout(channel, MODE_PERIODIC, SystemCoreClock / frequency_hz, task, source);
+}
+
+uint8_t GPTM_Start_One_Shot(uint8_t channel, uint32_t delay_us, void (*task)(void), uint8_t source)
+{
+	uint64_t ticks = ((uint64_t)SystemCoreClock * delay_us) / 1000000;
+
+	return GPTM_Start_Timeout(channel, MODE_ONE_SHOT, ticks, task, source);
+}
+
+uint8_t GPTM_Start_Capture(uint8_t channel, uint8_t edges, void (*handler)(uint64_t time), uint8_t source)
+{
+	if (GPTM_Is_Concatenated(channel)) return 0;
+
+	GPTM_Configure(channel, MODE_EDGE_TIME);
+	GPTM_Set_Full_Range(channel);
+	GPTM_Set_Edges(channel, edges);
+
+	gptm_channels[channel].capture = handler;
+
+	// Enable the capture event interrupt (CnEIM)
+	GPTM_Enable_Interrupt(channel, 0x04, source);
+	GPTM_Enable(channel);
+
+	return 1;
+}
+
+uint8_t GPTM_Start_Edge_Count(uint8_t channel, uint8_t edges)
+{
+	if (GPTM_Is_Concatenated(channel)) return 0;
+
+	GPTM_Configure(channel, MODE_EDGE_COUNT);
+	GPTM_Set_Full_Range(channel);
+	GPTM_Set_Edges(channel, edges);
+	GPTM_Enable(channel);
+
+	return 1;
+}
+
+uint8_t GPTM_Start_PWM(uint8_t channel, uint32_t frequency_hz, uint16_t duty_permille)
+{
+	if (GPTM_Is_Concatenated(channel) || (frequency_hz == 0)) return 0;
+
+	TIMER0_Type *timer = GPTM_Timer(channel);
+	uint8_t bits = GPTM_Counter_Bits(channel);
+	uint64_t ticks = SystemCoreClock / frequency_hz;
+
+	// In PWM mode, the prescaler holds the upper bits of the load and match values
+	if ((ticks < 2) || (((ticks - 1) >> bits) > GPTM_Prescaler_Max(channel))) return 0;
+
+	// The match and load values are updated at the next time-out (TnMRSU and TnILD)
+	GPTM_Configure(channel, MODE_PWM);
+
+	gptm_channels[channel].pwm_load = ticks - 1;
+	HALF_REGISTER(timer, channel, TAILR) = (uint32_t)(ticks - 1);
+	HALF_REGISTER(timer, channel, TAPR) = (uint32_t)((ticks - 1) >> bits);
+
+	GPTM_Set_Duty(channel, duty_permille);
+	GPTM_Enable(channel);
+
+	return 1;
+}
+
+void GPTM_Set_Duty(uint8_t channel, uint16_t duty_permille)
+{
+	TIMER0_Type *timer = GPTM_Timer(channel);
+	uint64_t load = gptm_channels[channel].pwm_load;
+	uint64_t high = ((load + 1) * duty_permille) / 1000;
+
+	// The output is high from the reload until the match. A match of 0
+	// keeps it high for all but the last cycle of the period.
+	uint64_t match = (high > load) ? 0 : (load - high);
+
+	HALF_REGISTER(timer, channel, TAMATCHR) = (uint32_t)match;
+	HALF_REGISTER(timer, channel, TAPMR) = (uint32_t)(match >> GPTM_Counter_Bits(channel));
+}
+
+void GPTM_Enable_ADC_Trigger(uint8_t channel)
+{
+	// TnOTE bit (Bit 5 for Timer A, Bit 13 for Timer B)
+	GPTM_Timer(channel)->CTL |= (0x20UL << HALF_SHIFT(channel));
+}
+
+uint64_t GPTM_Read(uint8_t channel)
+{
+	TIMER0_Type *timer = GPTM_Timer(channel);
+	uint32_t high;
+	uint32_t low;
+
+	if (GPTM_Is_Concatenated(channel))
+	{
+		if (!GPTM_Is_Wide(channel)) return timer->TAV;
+
+		// Read the upper word again in case the lower word wrapped between the two reads
+		do
+		{
+			high = timer->TBV;
+			low = timer->TAV;
+		}
+		while (high != timer->TBV);
+
+		return ((uint64_t)high << 32) | low;
+	}
+
+	uint8_t bits = GPTM_Counter_Bits(channel);
+	uint32_t counter_mask = (uint32_t)((1ULL << bits) - 1);
+
+	do
+	{
+		high = HALF_REGISTER(timer, channel, TAPV);
+		low = HALF_REGISTER(timer, channel, TAV);
+	}
+	while (high != HALF_REGISTER(timer, channel, TAPV));
+
+	return ((uint64_t)(high & GPTM_Prescaler_Max(channel)) << bits) | (low & counter_mask);
+}
+
+void GPTM_Stop(uint8_t channel)
+{
+	GPTM_Timer(channel)->CTL &= ~(0x01UL << HALF_SHIFT(channel));
+}
+
+void GPTM_Synchronize(uint32_t channels)
+{
+	// The GPTMSYNC register is only implemented in Timer 0
+	SYSCTL->RCGCTIMER |= 0x01;
+	while ((SYSCTL->PRTIMER & 0x01) == 0);
+
+	TIMER0->SYNC = channels;
+}
+
+static void GPTM_Interrupt(uint8_t channel)
+{
+	TIMER0_Type *timer = GPTM_Timer(channel);
+	uint8_t shift = HALF_SHIFT(channel);
+	GPTM_Channel_State *state = &gptm_channels[channel];
+
+	TRACE_ISR_ENTER(gptm_irqs[channel]);
+
+	uint32_t status = timer->MIS & (INTERRUPTS_A << shift);
+	timer->ICR = status;
+
+	// Time-out of a periodic or one-shot timer (TnTOMIS)
+	if ((status & (0x01UL << shift)) && (state->task != 0))
+	{
+		TRACE_TIMER_EXPIRY(channel);
+		state->task();
+	}
+
+	// Captured edge (CnEMIS), extended with the prescaler snapshot
+	if ((status & (0x04UL << shift)) && (state->capture != 0))
+	{
+		uint8_t bits = GPTM_Counter_Bits(channel);
+		uint64_t prescaler = HALF_REGISTER(timer, channel, TAPS) & GPTM_Prescaler_Max(channel);
+		uint32_t count = HALF_REGISTER(timer, channel, TAR) & (uint32_t)((1ULL << bits) - 1);
+
+		state->capture((prescaler << bits) | count);
+	}
+
+	TRACE_ISR_EXIT(gptm_irqs[channel]);
+}
+
+// Interrupt service routines of the 24 channels, named as in the startup file
+#define GPTM_HANDLER(name, channel) void name(void) { GPTM_Interrupt(channel); }
+
+GPTM_HANDLER(TIMER0A_Handler, GPTM_TIMER0A)
+GPTM_HANDLER(TIMER0B_Handler, GPTM_TIMER0B)
+GPTM_HANDLER(TIMER1A_Handler, GPTM_TIMER1A)
+GPTM_HANDLER(TIMER1B_Handler, GPTM_TIMER1B)
+GPTM_HANDLER(TIMER2A_Handler, GPTM_TIMER2A)
+GPTM_HANDLER(TIMER2B_Handler, GPTM_TIMER2B)
+GPTM_HANDLER(TIMER3A_Handler, GPTM_TIMER3A)
+GPTM_HANDLER(TIMER3B_Handler, GPTM_TIMER3B)
+GPTM_HANDLER(TIMER4A_Handler, GPTM_TIMER4A)
+GPTM_HANDLER(TIMER4B_Handler, GPTM_TIMER4B)
+GPTM_HANDLER(TIMER5A_Handler, GPTM_TIMER5A)
+GPTM_HANDLER(TIMER5B_Handler, GPTM_TIMER5B)
+GPTM_HANDLER(WTIMER0A_Handler, GPTM_WTIMER0A)
+GPTM_HANDLER(WTIMER0B_Handler, GPTM_WTIMER0B)
+GPTM_HANDLER(WTIMER1A_Handler, GPTM_WTIMER1A)
+GPTM_HANDLER(WTIMER1B_Handler, GPTM_WTIMER1B)
+GPTM_HANDLER(WTIMER2A_Handler, GPTM_WTIMER2A)
+GPTM_HANDLER(WTIMER2B_Handler, GPTM_WTIMER2B)
+GPTM_HANDLER(WTIMER3A_Handler, GPTM_WTIMER3A)
+GPTM_HANDLER(WTIMER3B_Handler, GPTM_WTIMER3B)
+GPTM_HANDLER(WTIMER4A_Handler, GPTM_WTIMER4A)
+GPTM_HANDLER(WTIMER4B_Handler, GPTM_WTIMER4B)
+GPTM_HANDLER(WTIMER5A_Handler, GPTM_WTIMER5A)
+GPTM_HANDLER(WTIMER5B_Handler, GPTM_WTIMER5B)
@@ -0,0 +1,276 @@
+/**
+ * @file GPTM.h
+ *
+ * @brief Header file for the GPTM driver.
+ *
+ * This file contains the function definitions for the GPTM driver.
+ * It manages the six 16/32-bit timers (Timer 0 to 5) and the six 32/64-bit wide timers
+ * (Wide Timer 0 to 5) of the General-Purpose Timer Module, so that each subsystem can claim
+ * its own timer instead of sharing the interrupt of another one.
+ *
+ * A timer is used either as two independent halves (A and B) or concatenated into one
+ * timer through its A half. A channel identifies a half, and channels are numbered in the
+ * order of the bits of the GPTMSYNC register (GPTM_TIMER0A = 0, ..., GPTM_WTIMER5B = 23).
+ * The width of a channel is:
+ *
+ *  Channel                  Timer    Prescaler
+ *  16/32-bit half           16 bits  8 bits
+ *  16/32-bit concatenated   32 bits  none
+ *  Wide half                32 bits  16 bits
+ *  Wide concatenated        64 bits  none
+ *
+ * The following modes are supported:
+ *  - Periodic and one-shot  The timer counts down and calls a task on time-out
+ *  - Edge-time capture      The timer counts up freely and passes the time of each edge of
+ *                           its CCP pin to a handler, with the prescaler extending the count
+ *  - Edge count             The timer counts the edges of its CCP pin
+ *  - PWM                    The CCP pin is driven high on reload and low on match
+ *
+ * Only halves can capture, count edges or generate PWM. Load values are computed from
+ * SystemCoreClock, and the caller assigns the CCP pins to the timer.
+ *
+ * @note Refer to Table 11-1 (Available CCP Pins) on page 706 of the TM4C123G
+ * Microcontroller Datasheet for the CCP pin of each channel.
+ */
+
+#ifndef GPTM_H
+#define GPTM_H
+
+#include "TM4C123GH6PM.h"
+#include "Interrupt_Config.h"
+
+// Number of channels (two halves for each of the 12 timers)
+#define GPTM_NUM_CHANNELS 24
+
+// Flags of GPTM_Claim and GPTM_Allocate
+#define GPTM_CONCATENATE 0x01
+#define GPTM_WIDE 0x02
+
+// Capture and count events
+#define GPTM_RISING_EDGE 0x00
+#define GPTM_FALLING_EDGE 0x01
+#define GPTM_BOTH_EDGES 0x03
+
+// Bit of a channel in the mask of GPTM_Synchronize
+#define GPTM_SYNC(channel) (1UL << (channel))
+
+enum GPTM_Channels
+{
+	GPTM_TIMER0A, GPTM_TIMER0B, GPTM_TIMER1A, GPTM_TIMER1B,
+	GPTM_TIMER2A, GPTM_TIMER2B, GPTM_TIMER3A, GPTM_TIMER3B,
+	GPTM_TIMER4A, GPTM_TIMER4B, GPTM_TIMER5A, GPTM_TIMER5B,
+	GPTM_WTIMER0A, GPTM_WTIMER0B, GPTM_WTIMER1A, GPTM_WTIMER1B,
+	GPTM_WTIMER2A, GPTM_WTIMER2B, GPTM_WTIMER3A, GPTM_WTIMER3B,
+	GPTM_WTIMER4A, GPTM_WTIMER4B, GPTM_WTIMER5A, GPTM_WTIMER5B
+};
+
+/**
+ * @brief Claims a specific channel.
+ *
+ * This function is used by subsystems that need the timer of a CCP pin. With the
+ * GPTM_CONCATENATE flag, the channel must be an A half and both halves are claimed.
+ *
+ * @param channel The channel to claim (see GPTM_Channels).
+ *
+ * @param flags GPTM_CONCATENATE to use the whole timer, or 0 to use the half.
+ *
+ * @return 1 if the channel was claimed, or 0 if it (or its other half) is already in use.
+ */
+uint8_t GPTM_Claim(uint8_t channel, uint8_t flags);
+
+/**
+ * @brief Claims any free channel.
+ *
+ * The 16/32-bit timers are searched before the wide timers, so that the wide timers
+ * stay available for the subsystems that need them.
+ *
+ * @param flags GPTM_CONCATENATE to allocate a whole timer, and GPTM_WIDE to
+ *              only search the wide timers.
+ *
+ * @return The allocated channel, or -1 if no channel is free.
+ */
+int8_t GPTM_Allocate(uint8_t flags);
+
+/**
+ * @brief Stops a channel and makes it available again.
+ *
+ * @param channel The channel returned by GPTM_Claim or GPTM_Allocate.
+ *
+ * @return None
+ */
+void GPTM_Release(uint8_t channel);
+
+/**
+ * @brief Starts a claimed channel as a periodic timer.
+ *
+ * @param channel The claimed channel.
+ *
+ * @param frequency_hz The number of time-outs per second.
+ *
+ * @param task A pointer to the function called on every time-out, or 0 for a timer
+ *             without interrupts (e.g. one that triggers the ADC).
+ *
+ * @param source The entry of the priority plan that sets the level of the interrupt
+ *               (see Interrupt_Sources).
+ *
+ * @return 1 if the timer was started, or 0 if the period does not fit the channel.
+ */
+uint8_t GPTM_Start_Periodic(uint8_t channel, uint32_t frequency_hz, void (*task)(void), uint8_t source);
+
+/**
+ * @brief Starts a claimed channel as a one-shot timer.
+ *
+ * The timer stops after its time-out, and can be started again by calling this function.
+ *
+ * @param channel The claimed channel.
+ *
+ * @param delay_us The delay before the time-out in microseconds.
+ *
+ * @param task A pointer to the function called on the time-out.
+ *
+ * @param source The entry of the priority plan that sets the level of the interrupt
+ *               (see Interrupt_Sources).
+ *
+ * @return 1 if the timer was started, or 0 if the delay does not fit the channel.
+ */
+uint8_t GPTM_Start_One_Shot(uint8_t channel, uint32_t delay_us, void (*task)(void), uint8_t source);
+
+/**
+ * @brief Starts a claimed half as a free-running timer that captures the time of edges.
+ *
+ * The handler receives the count of the timer at the edge, extended by the prescaler to
+ * 24 bits (16/32-bit half) or 48 bits (wide half), in system clock cycles.
+ *
+ * @param channel The claimed half.
+ *
+ * @param edges GPTM_RISING_EDGE, GPTM_FALLING_EDGE or GPTM_BOTH_EDGES.
+ *
+ * @param handler A pointer to the function called from the interrupt on every edge.
+ *
+ * @param source The entry of the priority plan that sets the level of the interrupt
+ *               (see Interrupt_Sources).
+ *
+ * @return 1 if the capture was started, or 0 if the channel is concatenated.
+ */
+uint8_t GPTM_Start_Capture(uint8_t channel, uint8_t edges, void (*handler)(uint64_t time), uint8_t source);
+
+/**
+ * @brief Starts a claimed half counting the edges of its CCP pin.
+ *
+ * The count is read with GPTM_Read. No interrupt is used.
+ *
+ * @param channel The claimed half.
+ *
+ * @param edges GPTM_RISING_EDGE, GPTM_FALLING_EDGE or GPTM_BOTH_EDGES.
+ *
+ * @return 1 if the count was started, or 0 if the channel is concatenated.
+ */
+uint8_t GPTM_Start_Edge_Count(uint8_t channel, uint8_t edges);
+
+/**
+ * @brief Starts a claimed half generating a PWM signal on its CCP pin.
+ *
+ * @param channel The claimed half.
+ *
+ * @param frequency_hz The frequency of the PWM signal.
+ *
+ * @param duty_permille The high time of the signal in tenths of a percent (0 to 1000).
+ *
+ * @return 1 if the PWM signal was started, or 0 if the period does not fit the channel.
+ */
+uint8_t GPTM_Start_PWM(uint8_t channel, uint32_t frequency_hz, uint16_t duty_permille);
+
+/**
+ * @brief Changes the duty cycle of a PWM channel.
+ *
+ * The new duty cycle takes effect at the start of the next period.
+ *
+ * @param channel A channel started with GPTM_Start_PWM.
+ *
+ * @param duty_permille The high time of the signal in tenths of a percent (0 to 1000).
+ *
+ * @return None
+ */
+void GPTM_Set_Duty(uint8_t channel, uint16_t duty_permille);
+
+/**
+ * @brief Makes a periodic timer trigger the ADC on every time-out.
+ *
+ * The ADC sample sequencer must select the timer as its trigger.
+ *
+ * @param channel A channel started with GPTM_Start_Periodic.
+ *
+ * @return None
+ */
+void GPTM_Enable_ADC_Trigger(uint8_t channel);
+
+/**
+ * @brief Reads the current count of a channel.
+ *
+ * A half is read together with its prescaler, so that a capture or edge-count channel
+ * returns its extended count.
+ *
+ * @param channel A started channel.
+ *
+ * @return The current count.
+ */
+uint64_t GPTM_Read(uint8_t channel);
+
+/**
+ * @brief Stops a channel without releasing it.
+ *
+ * @param channel A claimed channel.
+ *
+ * @return None
+ */
+void GPTM_Stop(uint8_t channel);
+
+/**
+ * @brief Restarts several channels at the same time.
+ *
+ * The selected channels are reloaded on the same clock cycle with the GPTMSYNC register,
+ * so that free-running channels count in step and their times can be compared.
+ *
+ * @param channels The channels to synchronize, as a mask of GPTM_SYNC(channel) bits.
+ *
+ * @return None
+ */
+void GPTM_Synchronize(uint32_t channels);
+
+/**
+ * @brief The interrupt service routines (ISR) of the 24 channels.
+ *
+ * Each of these functions acknowledges the interrupts of its channel, and calls the task of
+ * a periodic or one-shot channel on time-out, or the handler of a capture channel with the
+ * captured time.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void TIMER0A_Handler(void);
+void TIMER0B_Handler(void);
+void TIMER1A_Handler(void);
+void TIMER1B_Handler(void);
+void TIMER2A_Handler(void);
+void TIMER2B_Handler(void);
+void TIMER3A_Handler(void);
+void TIMER3B_Handler(void);
+void TIMER4A_Handler(void);
+void TIMER4B_Handler(void);
+void TIMER5A_Handler(void);
+void TIMER5B_Handler(void);
+void WTIMER0A_Handler(void);
+void WTIMER0B_Handler(void);
+void WTIMER1A_Handler(void);
+void WTIMER1B_Handler(void);
+void WTIMER2A_Handler(void);
+void WTIMER2B_Handler(void);
+void WTIMER3A_Handler(void);
+void WTIMER3B_Handler(void);
+void WTIMER4A_Handler(void);
+void WTIMER4B_Handler(void);
+void WTIMER5A_Handler(void);
+void WTIMER5B_Handler(void);
+
+#endif
@@ -0,0 +1,78 @@
+/**
+ * @file Goertzel.c
+ *
+ * @brief Source code for the Goertzel tone detector.
+ *
+ * This file contains the function definitions for the Goertzel tone detector.
+ */
+
+#include "Goertzel.h"
+#include <math.h>
+
+void Goertzel_Init(Goertzel_Detector *detector, uint32_t tone_hz, uint32_t sample_rate_hz, uint16_t block_size)
+{
+	float omega = (2.0f * 3.14159265f * (float)tone_hz) / (float)sample_rate_hz;
+
+	detector->coefficient = (int32_t)lroundf(2.0f * cosf(omega) * (float)(1 << GOERTZEL_Q));
+	detector->block_size = block_size;
+	detector->tone = 0;
+}
+
+uint8_t Goertzel_Detect(Goertzel_Detector *detector, const uint16_t *samples)
+{
+	uint32_t n = detector->block_size;
+	int32_t coefficient = detector->coefficient;
+
+	// Remove the DC offset of the input
+	uint32_t sum = 0;
+
+	for (uint32_t i = 0; i < n; i++)
+	{
+		sum += samples[i];
+	}
+
+	int32_t mean = (int32_t)(sum / n);
+
+	// Run the filter and measure the power of the block
+	int32_t s1 = 0;
+	int32_t s2 = 0;
+	uint64_t energy = 0;
+
+	for (uint32_t i = 0; i < n; i++)
+	{
+		int32_t x = (int32_t)samples[i] - mean;
+		int32_t s0 = x + (int32_t)(((int64_t)coefficient * s1) >> GOERTZEL_Q) - s2;
+
+		energy += (uint64_t)(x * x);
+		s2 = s1;
+		s1 = s0;
+	}
+
+	// Squared magnitude of the tone, which is (n * energy) / 2 for a pure tone
+	// and energy on average for white noise
+	int64_t power = ((int64_t)s1 * s1) + ((int64_t)s2 * s2) -
+	                ((((int64_t)coefficient * s1) >> GOERTZEL_Q) * s2);
+
+	if (power < 0)
+	{
+		power = 0;
+	}
+
+	if (energy < ((uint64_t)n * GOERTZEL_MIN_POWER))
+	{
+		detector->tone = 0;
+	}
+	else if (detector->tone)
+	{
+		if ((uint64_t)power < (energy * GOERTZEL_OFF_LEVEL))
+		{
+			detector->tone = 0;
+		}
+	}
+	else if ((uint64_t)power > (energy * GOERTZEL_ON_LEVEL))
+	{
+		detector->tone = 1;
+	}
+
+	return detector->tone;
+}
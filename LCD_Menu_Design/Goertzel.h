@@ -0,0 +1,73 @@
+/**
+ * @file Goertzel.h
+ *
+ * @brief Header file for the Goertzel tone detector.
+ *
+ * This file contains the function definitions for the Goertzel tone detector.
+ * It decides, one block of samples at a time, whether a tone of a given frequency
+ * is present, using a fixed-point Goertzel filter tuned to that frequency.
+ *
+ * The power at the tone frequency is compared with the average power of a frequency
+ * bin of the block, so the decision does not depend on the volume of the input. This
+ * ratio is about 1 for white noise and (block_size / 2) for a pure tone. The tone turns
+ * on above GOERTZEL_ON_LEVEL and off below GOERTZEL_OFF_LEVEL, and blocks quieter than
+ * GOERTZEL_MIN_POWER are treated as silence.
+ *
+ * The detector only uses integer arithmetic on the samples and does not depend on
+ * the hardware, so it can be built and tested on the host.
+ */
+
+#ifndef GOERTZEL_H
+#define GOERTZEL_H
+
+#include <stdint.h>
+
+// Fixed-point format of the filter coefficient
+#define GOERTZEL_Q 14
+
+// Tone power relative to the average bin power at which the tone turns on and off
+#define GOERTZEL_ON_LEVEL 8
+#define GOERTZEL_OFF_LEVEL 4
+
+// Minimum mean square of the block in ADC counts squared (noise gate)
+#define GOERTZEL_MIN_POWER 16
+
+typedef struct
+{
+	// 2 * cos(2 * pi * tone_hz / sample_rate_hz) in Q14
+	int32_t coefficient;
+	uint16_t block_size;
+
+	// 1 while the tone is present
+	uint8_t tone;
+} Goertzel_Detector;
+
+/**
+ * @brief Tunes a detector to a tone.
+ *
+ * @param detector A pointer to the detector.
+ *
+ * @param tone_hz The frequency of the tone in Hz.
+ *
+ * @param sample_rate_hz The sample rate in Hz.
+ *
+ * @param block_size The number of samples in a block.
+ *
+ * @return None
+ */
+void Goertzel_Init(Goertzel_Detector *detector, uint32_t tone_hz, uint32_t sample_rate_hz, uint16_t block_size);
+
+/**
+ * @brief Processes a block of samples and updates the tone state.
+ *
+ * The samples are 12-bit unsigned ADC readings. Their mean is removed before filtering.
+ *
+ * @param detector A pointer to the detector.
+ *
+ * @param samples A pointer to block_size samples.
+ *
+ * @return 1 if the tone is present, or 0 otherwise.
+ */
+uint8_t Goertzel_Detect(Goertzel_Detector *detector, const uint16_t *samples);
+
+#endif
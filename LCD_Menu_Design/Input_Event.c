@@ -0,0 +1,138 @@
+/**
+ * @file Input_Event.c
+ *
+ * @brief Source code for the Input_Event driver.
+ *
+ * This file contains the function definitions for the Input_Event driver.
+ * It provides the event queue, the subscriptions and the millisecond time base
+ * shared by the PMOD BTN, EduBase button and PMOD ENC drivers.
+ */
+
+#include "Input_Event.h"
+#include "TM4C123GH6PM.h"
+#include "Button_Debounce.h"
+#include "Interrupt_Config.h"
+
+typedef struct
+{
+	uint8_t source_mask;
+	uint8_t type_mask;
+	void (*handler)(const Input_Event *event);
+} Input_Subscriber;
+
+static Input_Subscriber subscribers[INPUT_MAX_SUBSCRIBERS];
+
+// Millisecond time base advanced by Input_Event_Tick
+static volatile uint32_t input_millis = 0;
+
+// Event queue written by the input interrupts and read by the main loop.
+// The head and tail are free-running counters.
+static Input_Event event_queue[INPUT_EVENT_QUEUE_SIZE];
+static volatile uint32_t event_head = 0;
+static volatile uint32_t event_tail = 0;
+
+volatile uint32_t Input_Events_Dropped = 0;
+
+void Input_Event_Post(uint8_t source, uint8_t code, uint8_t type, int32_t value)
+{
+	Input_Event_Post_Edge(source, code, type, value, DWT->CYCCNT);
+}
+
+void Input_Event_Post_Edge(uint8_t source, uint8_t code, uint8_t type, int32_t value, uint32_t edge_cycles)
+{
+	// Events can be posted from interrupts of different priorities
+	uint32_t basepri = Interrupt_Lock(INTERRUPT_LEVEL_INPUT_TICK);
+
+	uint32_t head = event_head;
+
+	if ((head - event_tail) < INPUT_EVENT_QUEUE_SIZE)
+	{
+		Input_Event *event = &event_queue[head & (INPUT_EVENT_QUEUE_SIZE - 1)];
+		event->timestamp_ms = input_millis;
+		event->value = value;
+		event->edge_cycles = edge_cycles;
+		event->queued_cycles = DWT->CYCCNT;
+		event->source = source;
+		event->code = code;
+		event->type = type;
+		event_head = head + 1;
+	}
+	else
+	{
+		Input_Events_Dropped = Input_Events_Dropped + 1;
+	}
+
+	Interrupt_Unlock(INTERRUPT_LEVEL_INPUT_TICK, basepri);
+}
+
+uint8_t Input_Event_Subscribe(uint8_t source_mask, uint8_t type_mask, void (*handler)(const Input_Event *event))
+{
+	for (uint8_t i = 0; i < INPUT_MAX_SUBSCRIBERS; i++)
+	{
+		if (subscribers[i].handler == 0)
+		{
+			subscribers[i].source_mask = source_mask;
+			subscribers[i].type_mask = type_mask;
+			subscribers[i].handler = handler;
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+void Input_Event_Unsubscribe(void (*handler)(const Input_Event *event))
+{
+	for (uint8_t i = 0; i < INPUT_MAX_SUBSCRIBERS; i++)
+	{
+		if (subscribers[i].handler == handler)
+		{
+			subscribers[i].handler = 0;
+		}
+	}
+}
+
+uint8_t Input_Event_Get(Input_Event *event)
+{
+	if (event_tail == event_head) return 0;
+
+	*event = event_queue[event_tail & (INPUT_EVENT_QUEUE_SIZE - 1)];
+	event_tail = event_tail + 1;
+
+	return 1;
+}
+
+uint32_t Input_Event_Dispatch(void)
+{
+	Input_Event event;
+	uint32_t dispatched = 0;
+
+	while (Input_Event_Get(&event))
+	{
+		for (uint8_t i = 0; i < INPUT_MAX_SUBSCRIBERS; i++)
+		{
+			if ((subscribers[i].handler != 0) &&
+			    (subscribers[i].source_mask & INPUT_SOURCE_MASK(event.source)) &&
+			    (subscribers[i].type_mask & INPUT_TYPE_MASK(event.type)))
+			{
+				subscribers[i].handler(&event);
+			}
+		}
+
+		dispatched++;
+	}
+
+	return dispatched;
+}
+
+void Input_Event_Tick(void)
+{
+	input_millis = input_millis + INPUT_TICK_MS;
+
+	Button_Debounce_Tick();
+}
+
+uint32_t Input_Event_Millis(void)
+{
+	return input_millis;
+}
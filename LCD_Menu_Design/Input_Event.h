@@ -0,0 +1,186 @@
+/**
+ * @file Input_Event.h
+ *
+ * @brief Header file for the Input_Event driver.
+ *
+ * This file contains the function definitions for the Input_Event driver.
+ * It provides the input event model shared by every input device:
+ *  - PMOD BTN push buttons        (INPUT_SOURCE_PMOD_BTN)
+ *  - EduBase board push buttons   (INPUT_SOURCE_EDUBASE_BTN)
+ *  - PMOD ENC rotary encoder      (INPUT_SOURCE_PMOD_ENC)
+ *  - Audio tone detector          (INPUT_SOURCE_AUDIO)
+ *
+ * Drivers post timestamped events into a single queue, and the application
+ * subscribes to the sources and event types it is interested in instead of
+ * decoding per-port status bytes. Events are dispatched from the main loop
+ * with Input_Event_Dispatch, so slow handlers never delay the input interrupts.
+ *
+ * The millisecond time base used to timestamp events is advanced by
+ * Input_Event_Tick, which also runs the Button_Debounce engine. Events also carry
+ * the DWT cycle counts of the edge that caused them and of their queueing, which
+ * Latency_Trace uses to time the path from an input to the display.
+ *
+ * @note Input_Event_Tick must be called every INPUT_TICK_MS milliseconds,
+ * e.g. from the Timer 0A periodic interrupt.
+ */
+
+#ifndef INPUT_EVENT_H
+#define INPUT_EVENT_H
+
+#include <stdint.h>
+
+// Period of Input_Event_Tick in milliseconds
+#define INPUT_TICK_MS 1
+
+// Size of the event queue (must be a power of two)
+#define INPUT_EVENT_QUEUE_SIZE 32
+
+// Maximum number of subscribers
+#define INPUT_MAX_SUBSCRIBERS 8
+
+enum Input_Sources
+{
+	INPUT_SOURCE_PMOD_BTN     = 0x00,
+	INPUT_SOURCE_EDUBASE_BTN  = 0x01,
+	INPUT_SOURCE_PMOD_ENC     = 0x02,
+	INPUT_SOURCE_AUDIO        = 0x03
+};
+
+enum Input_Event_Types
+{
+	INPUT_EVENT_PRESS         = 0x01,
+	INPUT_EVENT_RELEASE       = 0x02,
+	INPUT_EVENT_LONG_PRESS    = 0x03,
+	INPUT_EVENT_REPEAT        = 0x04,
+	INPUT_EVENT_DOUBLE_CLICK  = 0x05,
+	INPUT_EVENT_ROTATE        = 0x06
+};
+
+// Masks used to subscribe to sources and event types
+#define INPUT_SOURCE_MASK(source) (1U << (source))
+#define INPUT_TYPE_MASK(type)     (1U << (type))
+#define INPUT_ALL_SOURCES         0xFF
+#define INPUT_ALL_TYPES           0xFF
+
+typedef struct
+{
+	uint32_t timestamp_ms;
+	int32_t value;
+
+	// DWT cycle counts of the input edge that caused the event and of its queueing
+	uint32_t edge_cycles;
+	uint32_t queued_cycles;
+
+	uint8_t source;
+	uint8_t code;
+	uint8_t type;
+} Input_Event;
+
+// Number of events lost because the queue was full
+extern volatile uint32_t Input_Events_Dropped;
+
+/**
+ * @brief Queues an input event. Can be called from any interrupt service routine.
+ *
+ * The event is timestamped with the current value of the millisecond time base.
+ * Its edge is the time at which it is queued.
+ *
+ * @param source The device that generated the event (see Input_Sources).
+ *
+ * @param code The input within the device. For push buttons, this is the bit mask of the pin.
+ *
+ * @param type The event type (see Input_Event_Types).
+ *
+ * @param value The duration in ms for button events, or the number of detents
+ *              (positive for clockwise) for INPUT_EVENT_ROTATE.
+ *
+ * @return None
+ */
+void Input_Event_Post(uint8_t source, uint8_t code, uint8_t type, int32_t value);
+
+/**
+ * @brief Queues an input event caused by an earlier edge. Can be called from any interrupt service routine.
+ *
+ * This is used by the drivers that report an event some time after the edge
+ * (e.g. once the button has been debounced).
+ *
+ * @param source The device that generated the event (see Input_Sources).
+ *
+ * @param code The input within the device.
+ *
+ * @param type The event type (see Input_Event_Types).
+ *
+ * @param value The duration in ms or the number of detents (see Input_Event_Post).
+ *
+ * @param edge_cycles The DWT cycle count of the edge.
+ *
+ * @return None
+ */
+void Input_Event_Post_Edge(uint8_t source, uint8_t code, uint8_t type, int32_t value, uint32_t edge_cycles);
+
+/**
+ * @brief Subscribes a handler to input events.
+ *
+ * The handler is called by Input_Event_Dispatch for every event whose source and type
+ * are selected by the masks.
+ *
+ * @param source_mask The sources to receive, built with INPUT_SOURCE_MASK or INPUT_ALL_SOURCES.
+ *
+ * @param type_mask The event types to receive, built with INPUT_TYPE_MASK or INPUT_ALL_TYPES.
+ *
+ * @param handler A pointer to the function called for each matching event.
+ *
+ * @return 1 if the handler was subscribed, or 0 if there are already INPUT_MAX_SUBSCRIBERS subscribers.
+ */
+uint8_t Input_Event_Subscribe(uint8_t source_mask, uint8_t type_mask, void (*handler)(const Input_Event *event));
+
+/**
+ * @brief Removes every subscription of a handler.
+ *
+ * @param handler A pointer to the function to unsubscribe.
+ *
+ * @return None
+ */
+void Input_Event_Unsubscribe(void (*handler)(const Input_Event *event));
+
+/**
+ * @brief Delivers the queued events to their subscribers.
+ *
+ * This function must be called from the main loop. It returns when the queue is empty.
+ *
+ * @param None
+ *
+ * @return The number of events dispatched.
+ */
+uint32_t Input_Event_Dispatch(void);
+
+/**
+ * @brief Reads the oldest queued event without dispatching it.
+ *
+ * @param event A pointer to where the event is stored.
+ *
+ * @return 1 if an event was read, or 0 if the queue is empty.
+ */
+uint8_t Input_Event_Get(Input_Event *event);
+
+/**
+ * @brief Advances the millisecond time base and runs the debounce engine.
+ *
+ * This function must be called every INPUT_TICK_MS milliseconds from a periodic timer interrupt.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Input_Event_Tick(void);
+
+/**
+ * @brief Returns the millisecond time base used to timestamp events.
+ *
+ * @param None
+ *
+ * @return The number of milliseconds counted by Input_Event_Tick.
+ */
+uint32_t Input_Event_Millis(void);
+
+#endif
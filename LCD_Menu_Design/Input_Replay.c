@@ -0,0 +1,464 @@
+/**
+ * @file Input_Replay.c
+ *
+ * @brief Source code for the Input_Replay module.
+ *
+ * This file contains the function definitions for the Input_Replay module.
+ * A replayed stream is read one event ahead: the next event and its time relative to
+ * the start of the run are kept until the time has come to post it. A synthetic stream
+ * is generated as it is replayed, so it does not use the recording buffer.
+ */
+
+#include "Input_Replay.h"
+#include "MorseDecoder.h"
+#include <ctype.h>
+
+volatile uint32_t Input_Replay_Max_WPM = 0;
+
+static uint8_t replay_state = INPUT_REPLAY_IDLE;
+static Input_Replay_Result result;
+
+static uint8_t synth_source = 0;
+static uint8_t synth_code = 0;
+
+// Recorded events, with their time relative to the first one
+static Input_Event recording[INPUT_REPLAY_BUFFER_SIZE];
+static uint16_t recorded_count = 0;
+static uint32_t record_start_ms = 0;
+
+// Run in progress
+static uint8_t synthetic = 0;
+static uint8_t sweeping = 0;
+static uint32_t start_ms = 0;
+static uint32_t end_time = 0;
+static uint32_t settle_ms = 0;
+static uint32_t dropped_at_start = 0;
+static Input_Event next_event;
+static uint8_t next_valid = 0;
+
+// Recorded stream
+static uint16_t play_index = 0;
+static uint16_t play_speed = 100;
+
+// Synthetic stream
+static char synth_text[INPUT_REPLAY_TEXT_SIZE];
+static uint8_t synth_jitter = 0;
+static uint32_t synth_unit_ms = 0;
+static uint8_t synth_position = 0;
+static const char *synth_element = "";
+static uint8_t synth_key_down = 0;
+static uint32_t synth_time = 0;
+static uint32_t synth_seed = 1;
+
+// Characters and word spaces that the text should decode to, and the characters decoded during the run
+static char expected_text[INPUT_REPLAY_TEXT_SIZE];
+static char decoded_text[INPUT_REPLAY_TEXT_SIZE];
+
+static void Replay_Record(const Input_Event *event)
+{
+	if (replay_state != INPUT_REPLAY_RECORDING) return;
+
+	if (recorded_count >= INPUT_REPLAY_BUFFER_SIZE)
+	{
+		replay_state = INPUT_REPLAY_IDLE;
+		return;
+	}
+
+	Input_Event *record = &recording[recorded_count];
+	*record = *event;
+
+	if (recorded_count > 0)
+	{
+		record->timestamp_ms = event->timestamp_ms - record_start_ms;
+	}
+	else
+	{
+		record_start_ms = event->timestamp_ms;
+		record->timestamp_ms = 0;
+	}
+
+	recorded_count++;
+}
+
+void Input_Replay_Init(uint8_t key_source, uint8_t key_code)
+{
+	synth_source = key_source;
+	synth_code = key_code;
+
+	Input_Event_Subscribe(INPUT_ALL_SOURCES, INPUT_ALL_TYPES, &Replay_Record);
+}
+
+uint8_t Input_Replay_Record_Start(void)
+{
+	if (replay_state == INPUT_REPLAY_PLAYING) return 0;
+
+	sweeping = 0;
+	recorded_count = 0;
+	replay_state = INPUT_REPLAY_RECORDING;
+
+	return 1;
+}
+
+void Input_Replay_Record_Stop(void)
+{
+	if (replay_state == INPUT_REPLAY_RECORDING)
+	{
+		replay_state = INPUT_REPLAY_IDLE;
+	}
+}
+
+uint8_t Input_Replay_Read(uint16_t index, Input_Event *event)
+{
+	if (index >= recorded_count) return 0;
+
+	*event = recording[index];
+
+	return 1;
+}
+
+uint16_t Input_Replay_Count(void)
+{
+	return recorded_count;
+}
+
+static uint8_t Replay_Next_Recorded(Input_Event *event)
+{
+	if (play_index >= recorded_count) return 0;
+
+	*event = recording[play_index];
+	event->timestamp_ms = (uint32_t)(((uint64_t)event->timestamp_ms * 100) / play_speed);
+	play_index++;
+
+	return 1;
+}
+
+// Stretches or shortens a duration by a random amount of up to synth_jitter percent
+static uint32_t Replay_Jitter(uint32_t duration_ms)
+{
+	if (synth_jitter == 0) return duration_ms;
+
+	// Linear congruential generator (Numerical Recipes constants), using its upper bits
+	synth_seed = (synth_seed * 1664525) + 1013904223;
+	int32_t percent = (int32_t)((synth_seed >> 16) % ((2 * synth_jitter) + 1)) - synth_jitter;
+	int32_t jittered = ((int32_t)duration_ms * (100 + percent)) / 100;
+
+	return (jittered > 0) ? (uint32_t)jittered : 1;
+}
+
+static const char *Replay_Pattern(char character)
+{
+	for (uint8_t i = 0; i < sizeof(char_table); i++)
+	{
+		if (char_table[i] == character)
+		{
+			return morse_table[i];
+		}
+	}
+
+	return 0;
+}
+
+static uint8_t Replay_Next_Synthetic(Input_Event *event)
+{
+	event->source = synth_source;
+	event->code = synth_code;
+
+	if (synth_key_down)
+	{
+		// The mark lasts one dot or three dots
+		uint32_t mark_ms = Replay_Jitter(((*synth_element == '-') ? 3 : 1) * synth_unit_ms);
+
+		synth_time += mark_ms;
+		synth_element++;
+		synth_key_down = 0;
+
+		event->timestamp_ms = synth_time;
+		event->type = INPUT_EVENT_RELEASE;
+		event->value = (int32_t)mark_ms;
+
+		return 1;
+	}
+
+	// The next mark follows an element space, or a character space once
+	// the pattern has been keyed, or a word space if the text has a space
+	uint32_t space_units = 1;
+
+	if (*synth_element == '\0')
+	{
+		space_units = 3;
+
+		while (1)
+		{
+			char character = (char)toupper((unsigned char)synth_text[synth_position]);
+
+			if (character == '\0') return 0;
+
+			synth_position++;
+
+			if (character == ' ')
+			{
+				space_units = 7;
+			}
+			else if ((synth_element = Replay_Pattern(character)) != 0)
+			{
+				break;
+			}
+			else
+			{
+				synth_element = "";
+			}
+		}
+	}
+
+	synth_time += Replay_Jitter(space_units * synth_unit_ms);
+	synth_key_down = 1;
+
+	event->timestamp_ms = synth_time;
+	event->type = INPUT_EVENT_PRESS;
+	event->value = 0;
+
+	return 1;
+}
+
+static uint8_t Replay_Next(Input_Event *event)
+{
+	return synthetic ? Replay_Next_Synthetic(event) : Replay_Next_Recorded(event);
+}
+
+static void Replay_Start(uint32_t now_ms)
+{
+	result.events = 0;
+	result.dropped = 0;
+	result.max_lag_ms = 0;
+	result.decoded = 0;
+	result.errors = 0;
+	result.duration_ms = 0;
+
+	start_ms = now_ms;
+	dropped_at_start = Input_Events_Dropped;
+	replay_state = INPUT_REPLAY_PLAYING;
+	next_valid = Replay_Next(&next_event);
+}
+
+uint8_t Input_Replay_Play(uint16_t speed_percent, uint32_t now_ms)
+{
+	if ((replay_state == INPUT_REPLAY_PLAYING) || (recorded_count == 0) || (speed_percent == 0)) return 0;
+
+	synthetic = 0;
+	sweeping = 0;
+	play_index = 0;
+	play_speed = speed_percent;
+	settle_ms = INPUT_REPLAY_SETTLE_MS;
+
+	result.wpm = 0;
+	result.expected = 0;
+
+	Replay_Start(now_ms);
+
+	return 1;
+}
+
+static void Replay_Start_Synthetic(uint32_t now_ms)
+{
+	synth_unit_ms = 1200 / (uint32_t)result.wpm;
+	synth_position = 0;
+	synth_element = "";
+	synth_key_down = 0;
+	synth_seed = 1;
+
+	// The first mark starts after a word space (with the character space added to it),
+	// so that it cannot continue the previous input
+	synth_time = 4 * synth_unit_ms;
+
+	// The decoder ends the last word after a word space
+	settle_ms = 12 * synth_unit_ms;
+
+	Replay_Start(now_ms);
+}
+
+uint8_t Input_Replay_Synthesize(const char *text, int32_t wpm, uint8_t jitter_percent, uint32_t now_ms)
+{
+	if ((replay_state == INPUT_REPLAY_PLAYING) || (wpm < 1) || (wpm > 1200) || (jitter_percent > 50)) return 0;
+
+	uint8_t length = 0;
+	uint32_t expected = 0;
+
+	while ((text[length] != '\0') && (length < (INPUT_REPLAY_TEXT_SIZE - 1)))
+	{
+		char character = (char)toupper((unsigned char)text[length]);
+
+		if (character == ' ')
+		{
+			// The decoder inserts a single space between two words
+			if ((expected > 0) && (expected_text[expected - 1] != ' '))
+			{
+				expected_text[expected] = ' ';
+				expected++;
+			}
+		}
+		else if (Replay_Pattern(character) != 0)
+		{
+			expected_text[expected] = character;
+			expected++;
+		}
+
+		synth_text[length] = text[length];
+		length++;
+	}
+
+	// The run ends with a word space, so the decoder also inserts a space after the last word
+	if ((expected > 0) && (expected_text[expected - 1] != ' '))
+	{
+		expected_text[expected] = ' ';
+		expected++;
+	}
+
+	synth_text[length] = '\0';
+	synth_jitter = jitter_percent;
+	synthetic = 1;
+	sweeping = 0;
+
+	result.wpm = wpm;
+	result.expected = expected;
+
+	Replay_Start_Synthetic(now_ms);
+
+	return 1;
+}
+
+uint8_t Input_Replay_Sweep(const char *text, int32_t wpm, uint8_t jitter_percent, uint32_t now_ms)
+{
+	if (!Input_Replay_Synthesize(text, wpm, jitter_percent, now_ms)) return 0;
+
+	sweeping = 1;
+	Input_Replay_Max_WPM = 0;
+
+	return 1;
+}
+
+void Input_Replay_Stop(void)
+{
+	replay_state = INPUT_REPLAY_IDLE;
+	next_valid = 0;
+	sweeping = 0;
+}
+
+// Returns the edit distance between the decoded characters and the text, which counts a
+// missing or extra character once instead of shifting the rest of the text
+static uint32_t Replay_Errors(void)
+{
+	uint8_t decoded = (result.decoded < INPUT_REPLAY_TEXT_SIZE) ? (uint8_t)result.decoded : INPUT_REPLAY_TEXT_SIZE;
+	uint8_t expected = (uint8_t)result.expected;
+	uint8_t row[INPUT_REPLAY_TEXT_SIZE + 1];
+
+	for (uint8_t j = 0; j <= expected; j++)
+	{
+		row[j] = j;
+	}
+
+	for (uint8_t i = 1; i <= decoded; i++)
+	{
+		uint8_t diagonal = row[0];
+		row[0] = i;
+
+		for (uint8_t j = 1; j <= expected; j++)
+		{
+			uint8_t above = row[j];
+			uint8_t cost = diagonal + ((decoded_text[i - 1] == expected_text[j - 1]) ? 0 : 1);
+
+			if ((above + 1) < cost) cost = above + 1;
+			if ((row[j - 1] + 1) < cost) cost = row[j - 1] + 1;
+
+			row[j] = cost;
+			diagonal = above;
+		}
+	}
+
+	// The characters decoded after the buffer was full are all errors
+	return row[expected] + (result.decoded - decoded);
+}
+
+static void Replay_Finish(uint32_t now_ms)
+{
+	if (synthetic)
+	{
+		result.errors = Replay_Errors();
+	}
+
+	result.dropped = Input_Events_Dropped - dropped_at_start;
+	result.duration_ms = now_ms - start_ms;
+	replay_state = INPUT_REPLAY_IDLE;
+
+	if (!sweeping) return;
+
+	// The next run of the sweep starts on the next call of Input_Replay_Process,
+	// so that the result of this run can be read first
+	if ((result.errors == 0) && (result.dropped == 0))
+	{
+		Input_Replay_Max_WPM = (uint32_t)result.wpm;
+
+		if ((result.wpm + INPUT_REPLAY_SWEEP_STEP_WPM) <= INPUT_REPLAY_SWEEP_MAX_WPM) return;
+	}
+
+	sweeping = 0;
+}
+
+uint8_t Input_Replay_Process(uint32_t now_ms)
+{
+	if (sweeping && (replay_state == INPUT_REPLAY_IDLE))
+	{
+		result.wpm += INPUT_REPLAY_SWEEP_STEP_WPM;
+		Replay_Start_Synthetic(now_ms);
+	}
+
+	if (replay_state != INPUT_REPLAY_PLAYING) return 0;
+
+	uint32_t elapsed = now_ms - start_ms;
+
+	while (next_valid && (next_event.timestamp_ms <= elapsed))
+	{
+		uint32_t lag = elapsed - next_event.timestamp_ms;
+
+		if (lag > result.max_lag_ms)
+		{
+			result.max_lag_ms = lag;
+		}
+
+		Input_Event_Post(next_event.source, next_event.code, next_event.type, next_event.value);
+		result.events++;
+		end_time = next_event.timestamp_ms;
+
+		next_valid = Replay_Next(&next_event);
+	}
+
+	if (!next_valid && ((elapsed - end_time) >= settle_ms))
+	{
+		Replay_Finish(now_ms);
+		return 1;
+	}
+
+	return 0;
+}
+
+void Input_Replay_Check(char decoded)
+{
+	if ((replay_state != INPUT_REPLAY_PLAYING) || !synthetic) return;
+
+	// The decoded characters are compared with the text once the run has ended
+	if (result.decoded < INPUT_REPLAY_TEXT_SIZE)
+	{
+		decoded_text[result.decoded] = decoded;
+	}
+
+	result.decoded++;
+}
+
+uint8_t Input_Replay_State(void)
+{
+	return replay_state;
+}
+
+const Input_Replay_Result *Input_Replay_Get_Result(void)
+{
+	return &result;
+}
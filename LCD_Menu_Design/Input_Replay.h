@@ -0,0 +1,226 @@
+/**
+ * @file Input_Replay.h
+ *
+ * @brief Header file for the Input_Replay module.
+ *
+ * This file contains the function definitions for the Input_Replay module.
+ * It records the input events delivered by the Input_Event queue, and injects recorded or
+ * synthetic event streams back into the queue, so that the decoder can be tested without
+ * anyone pressing buttons and the results can be reproduced.
+ *
+ * The events are recorded once they have been debounced, with their timestamps relative to the
+ * first recorded event, into a RAM buffer of INPUT_REPLAY_BUFFER_SIZE events. A replayed event is
+ * posted with Input_Event_Post when its time has come, so it follows the same path through the
+ * subscribers, the applications and the Morse decoder as the live input.
+ *
+ * A synthetic stream keys a text in Morse code with the key-down and key-up events of a single
+ * key (e.g. the detected audio tone), at a given speed in words per minute. Every mark and space
+ * can be stretched or shortened at random by up to a given percentage (jitter), with a fixed seed
+ * so that a run can be repeated. The characters and word spaces decoded during a synthetic run are
+ * reported with Input_Replay_Check, and compared with the text once the run has ended: the errors
+ * are the edit distance between the two, so a missing or extra character or space is counted once. A sweep repeats
+ * the run at increasing speeds, and keeps the highest speed decoded without errors or dropped
+ * events.
+ *
+ * The module only uses the Input_Event queue and does not access the hardware.
+ */
+
+#ifndef INPUT_REPLAY_H
+#define INPUT_REPLAY_H
+
+#include "Input_Event.h"
+
+// Number of events that can be recorded
+#define INPUT_REPLAY_BUFFER_SIZE 128
+
+// Maximum length of a synthetic text (including the terminating null character)
+#define INPUT_REPLAY_TEXT_SIZE 32
+
+// Time allowed after the last event of a recorded stream for the decoder to end the message
+#define INPUT_REPLAY_SETTLE_MS 3000
+
+// Speed increment and maximum speed of a sweep in words per minute
+#define INPUT_REPLAY_SWEEP_STEP_WPM 5
+#define INPUT_REPLAY_SWEEP_MAX_WPM 100
+
+enum Input_Replay_States
+{
+	INPUT_REPLAY_IDLE       = 0x00,
+	INPUT_REPLAY_RECORDING  = 0x01,
+	INPUT_REPLAY_PLAYING    = 0x02
+};
+
+typedef struct
+{
+	// Speed of a synthetic stream in words per minute, or 0 for a recorded stream
+	int32_t wpm;
+
+	// Events injected, and events lost because the queue was full during the run
+	uint32_t events;
+	uint32_t dropped;
+
+	// Longest delay between the scheduled time of an event and its injection
+	uint32_t max_lag_ms;
+
+	// Characters and word spaces of the synthetic text, characters decoded, and the characters
+	// that were missing, extra or wrong (edit distance between the decoded characters and the text)
+	uint32_t expected;
+	uint32_t decoded;
+	uint32_t errors;
+
+	uint32_t duration_ms;
+} Input_Replay_Result;
+
+// Highest speed decoded without errors by the last sweep, in words per minute
+extern volatile uint32_t Input_Replay_Max_WPM;
+
+/**
+ * @brief Subscribes the recorder to the input events.
+ *
+ * @param key_source The source of the events keyed by the synthetic streams (see Input_Sources).
+ *
+ * @param key_code The code of the events keyed by the synthetic streams.
+ *
+ * @return None
+ */
+void Input_Replay_Init(uint8_t key_source, uint8_t key_code);
+
+/**
+ * @brief Clears the recording and starts recording the input events.
+ *
+ * Recording stops when the buffer is full.
+ *
+ * @param None
+ *
+ * @return 1 if recording started, or 0 if a stream is being replayed.
+ */
+uint8_t Input_Replay_Record_Start(void);
+
+/**
+ * @brief Stops recording the input events.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Input_Replay_Record_Stop(void);
+
+/**
+ * @brief Reads a recorded event.
+ *
+ * @param index The index of the event, from 0 for the first one.
+ *
+ * @param event A pointer to where the event is stored, with its time relative to the first event.
+ *
+ * @return 1 if the event was read, or 0 if the index is out of range.
+ */
+uint8_t Input_Replay_Read(uint16_t index, Input_Event *event);
+
+/**
+ * @brief Returns the number of recorded events.
+ *
+ * @param None
+ *
+ * @return The number of events in the buffer.
+ */
+uint16_t Input_Replay_Count(void);
+
+/**
+ * @brief Starts replaying the recorded events.
+ *
+ * @param speed_percent The replay speed (100 for the recorded speed, 200 for twice as fast).
+ *
+ * @param now_ms The current time in milliseconds.
+ *
+ * @return 1 if the replay started, or 0 if nothing has been recorded or a stream is being replayed.
+ */
+uint8_t Input_Replay_Play(uint16_t speed_percent, uint32_t now_ms);
+
+/**
+ * @brief Starts keying a text in Morse code.
+ *
+ * Letters and digits are keyed with the standard timing (a dash and a character space are 3 dots,
+ * a word space is 7 dots), other characters than spaces are skipped.
+ *
+ * @param text The text, which is copied. Lowercase letters are keyed as uppercase letters.
+ *
+ * @param wpm The speed in words per minute (PARIS standard, one dot lasts 1200 / wpm ms).
+ *
+ * @param jitter_percent The largest random change of each duration, in percent (0 to 50).
+ *
+ * @param now_ms The current time in milliseconds.
+ *
+ * @return 1 if the run started, or 0 if the speed is out of range or a stream is being replayed.
+ */
+uint8_t Input_Replay_Synthesize(const char *text, int32_t wpm, uint8_t jitter_percent, uint32_t now_ms);
+
+/**
+ * @brief Keys a text at increasing speeds until it is not decoded correctly.
+ *
+ * The text is keyed as with Input_Replay_Synthesize, first at the given speed, then
+ * INPUT_REPLAY_SWEEP_STEP_WPM faster after every run without errors or dropped events,
+ * up to INPUT_REPLAY_SWEEP_MAX_WPM. Input_Replay_Max_WPM is updated after every clean run.
+ *
+ * @param text The text, which is copied.
+ *
+ * @param wpm The speed of the first run in words per minute.
+ *
+ * @param jitter_percent The largest random change of each duration, in percent (0 to 50).
+ *
+ * @param now_ms The current time in milliseconds.
+ *
+ * @return 1 if the sweep started, or 0 otherwise.
+ */
+uint8_t Input_Replay_Sweep(const char *text, int32_t wpm, uint8_t jitter_percent, uint32_t now_ms);
+
+/**
+ * @brief Stops recording or replaying.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Input_Replay_Stop(void);
+
+/**
+ * @brief Injects the events whose time has come, and ends the run after the last one.
+ *
+ * This function must be called from the main loop.
+ *
+ * @param now_ms The current time in milliseconds.
+ *
+ * @return 1 if a run has just ended and its result can be read, or 0 otherwise.
+ */
+uint8_t Input_Replay_Process(uint32_t now_ms);
+
+/**
+ * @brief Compares a decoded character with the synthetic text.
+ *
+ * This function is called by the decoder for every decoded character and for every space
+ * that it inserts between two words. It is ignored unless a stream is being replayed.
+ *
+ * @param decoded The decoded character, or ' ' for a word space.
+ *
+ * @return None
+ */
+void Input_Replay_Check(char decoded);
+
+/**
+ * @brief Returns the state of the module.
+ *
+ * @param None
+ *
+ * @return The state (see Input_Replay_States).
+ */
+uint8_t Input_Replay_State(void);
+
+/**
+ * @brief Returns the result of the last run.
+ *
+ * @param None
+ *
+ * @return A pointer to the result, which is updated while a stream is being replayed.
+ */
+const Input_Replay_Result *Input_Replay_Get_Result(void);
+
+#endif
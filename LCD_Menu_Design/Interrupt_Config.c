@@ -0,0 +1,115 @@
+/**
+ * @file Interrupt_Config.c
+ *
+ * @brief Source code for the Interrupt_Config module.
+ *
+ * This file contains the function definitions for the Interrupt_Config module.
+ * The table is ordered by level, from the highest priority. The IRQs of the timers
+ * handed out by the GPTM driver are recorded when they are enabled.
+ */
+
+#include "Interrupt_Config.h"
+
+static const Interrupt_Config interrupt_plan[INTERRUPT_NUM_SOURCES] =
+{
+	{ "systick",         SysTick_IRQn,       INTERRUPT_LEVEL_SYSTICK,     0 },
+	{ "tone",            INTERRUPT_IRQ_NONE, INTERRUPT_LEVEL_TONE,        0 },
+	{ "stepper",         INTERRUPT_IRQ_NONE, INTERRUPT_LEVEL_STEPPER,     1 },
+	{ "input_tick",      INTERRUPT_IRQ_NONE, INTERRUPT_LEVEL_INPUT_TICK,  0 },
+	{ "pmod_btn",        GPIOA_IRQn,         INTERRUPT_LEVEL_BUTTONS,     0 },
+	{ "edubase_btn",     GPIOD_IRQn,         INTERRUPT_LEVEL_BUTTONS,     0 },
+	{ "pmod_enc",        GPIOE_IRQn,         INTERRUPT_LEVEL_BUTTONS,     0 },
+	{ "stopwatch_start", INTERRUPT_IRQ_NONE, INTERRUPT_LEVEL_STOPWATCH,   1 },
+	{ "stopwatch_lap",   INTERRUPT_IRQ_NONE, INTERRUPT_LEVEL_STOPWATCH,   1 },
+	{ "uart0",           UART0_IRQn,         INTERRUPT_LEVEL_UART,        0 },
+	{ "audio",           ADC0SS3_IRQn,       INTERRUPT_LEVEL_AUDIO,       0 },
+	{ "motor",           PWM0_0_IRQn,        INTERRUPT_LEVEL_MOTOR,       1 },
+	{ "dma_error",       UDMAERR_IRQn,       INTERRUPT_LEVEL_DMA,         0 },
+	{ "led_effects",     PWM1_3_IRQn,        INTERRUPT_LEVEL_LED_EFFECTS, 1 },
+	{ "lcd_stream",      INTERRUPT_IRQ_NONE, INTERRUPT_LEVEL_LCD_STREAM,  0 },
+	{ "marquee",         INTERRUPT_IRQ_NONE, INTERRUPT_LEVEL_MARQUEE,     1 }
+};
+
+// IRQs of the timers handed out at runtime, and the sources that have been enabled
+static int16_t runtime_irqs[INTERRUPT_NUM_SOURCES];
+static uint32_t enabled_sources = 0;
+
+volatile uint32_t Interrupt_Lock_Max_Cycles[INTERRUPT_LEVELS];
+uint32_t Interrupt_Lock_Start[INTERRUPT_LEVELS];
+
+static uint32_t cycles_per_us = 1;
+
+void Interrupt_Config_Init(void)
+{
+	NVIC_SetPriorityGrouping(INTERRUPT_PRIORITY_GROUPING);
+
+	// Start the cycle counter, which is also used by the trace recorder
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	cycles_per_us = SystemCoreClock / 1000000;
+
+	for (uint8_t i = 0; i < INTERRUPT_NUM_SOURCES; i++)
+	{
+		runtime_irqs[i] = interrupt_plan[i].irq;
+	}
+}
+
+void Interrupt_Config_Enable_IRQ(uint8_t source, int16_t irq)
+{
+	if (source >= INTERRUPT_NUM_SOURCES) return;
+
+	const Interrupt_Config *config = &interrupt_plan[source];
+
+	NVIC_SetPriority((IRQn_Type)irq, NVIC_EncodePriority(INTERRUPT_PRIORITY_GROUPING, config->level, config->sub_priority));
+
+	// SysTick and the other system exceptions are enabled in their own registers
+	if (irq >= 0)
+	{
+		NVIC_EnableIRQ((IRQn_Type)irq);
+	}
+
+	runtime_irqs[source] = irq;
+	enabled_sources |= (1UL << source);
+}
+
+void Interrupt_Config_Enable(uint8_t source)
+{
+	if (source >= INTERRUPT_NUM_SOURCES) return;
+
+	Interrupt_Config_Enable_IRQ(source, interrupt_plan[source].irq);
+}
+
+uint8_t Interrupt_Config_Read(uint8_t source, Interrupt_Report *report)
+{
+	if (source >= INTERRUPT_NUM_SOURCES) return 0;
+
+	const Interrupt_Config *config = &interrupt_plan[source];
+	uint32_t blocking = 0;
+
+	// An interrupt is masked by the critical sections of its own level and of the levels above it
+	for (uint8_t level = INTERRUPT_LEVEL_ALL; level <= config->level; level++)
+	{
+		if (Interrupt_Lock_Max_Cycles[level] > blocking)
+		{
+			blocking = Interrupt_Lock_Max_Cycles[level];
+		}
+	}
+
+	report->name = config->name;
+	report->irq = runtime_irqs[source];
+	report->level = config->level;
+	report->sub_priority = config->sub_priority;
+	report->enabled = (enabled_sources >> source) & 1;
+	report->blocking_us = blocking / cycles_per_us;
+
+	return 1;
+}
+
+void Interrupt_Config_Reset(void)
+{
+	for (uint8_t level = 0; level < INTERRUPT_LEVELS; level++)
+	{
+		Interrupt_Lock_Max_Cycles[level] = 0;
+	}
+}
@@ -0,0 +1,231 @@
+/**
+ * @file Interrupt_Config.h
+ *
+ * @brief Header file for the Interrupt_Config module.
+ *
+ * This file contains the function definitions for the Interrupt_Config module.
+ * It holds the interrupt priority plan of the firmware in a single table, and provides
+ * the critical sections that protect the state shared with the interrupt handlers.
+ *
+ * Each interrupt source has an entry in the table (see Interrupt_Sources) with its IRQ,
+ * its preemption level and its sub-priority. The drivers enable their interrupts with
+ * Interrupt_Config_Enable instead of writing the NVIC, and the GPTM driver enables the
+ * timers that it hands out with Interrupt_Config_Enable_IRQ. The levels are:
+ *
+ *  Level  Interrupts
+ *  0      SysTick delay time base (1 us ticks)
+ *  1      Tone output, stepper step generation
+ *  2      Input time base and debouncing (Timer 0A)
+ *  3      Button edges (GPIO A, D and E), stopwatch captures (Wide Timer 2A and 2B)
+ *  4      UART0
+ *  5      Audio samples (ADC0 SS3), motor PWM (PWM0 Generator 0)
+ *  6      uDMA bus errors, LED effects (PWM1 Generator 3)
+ *  7      LCD stream, seven-segment marquee
+ *
+ * The TM4C123 implements three priority bits, which are all used for the eight preemption
+ * levels (INTERRUPT_PRIORITY_GROUPING), so the sub-priority column has no bits and the pending
+ * interrupts of a level are taken in the order of their IRQ numbers.
+ *
+ * A critical section raises BASEPRI to the level of the highest-priority interrupt that
+ * shares the state, so the interrupts above it keep running: the tone output and the
+ * stepper are never delayed by the drivers at levels 2 to 7. Level 0 cannot be masked by
+ * BASEPRI, and INTERRUPT_LEVEL_ALL masks everything else. The longest time that each level
+ * has been masked is measured with the DWT cycle counter, which gives the worst-case blocking
+ * time of each interrupt seen so far.
+ */
+
+#ifndef INTERRUPT_CONFIG_H
+#define INTERRUPT_CONFIG_H
+
+#include "TM4C123GH6PM.h"
+
+// Set to 0 to stop timing the critical sections
+#define INTERRUPT_LOCK_TIMING 1
+
+// Priority grouping (PRIGROUP) with the three implemented bits used for preemption
+#define INTERRUPT_PRIORITY_GROUPING 4
+#define INTERRUPT_LEVELS 8
+
+// Preemption levels of the priority plan
+#define INTERRUPT_LEVEL_SYSTICK      0
+#define INTERRUPT_LEVEL_TONE         1
+#define INTERRUPT_LEVEL_STEPPER      1
+#define INTERRUPT_LEVEL_INPUT_TICK   2
+#define INTERRUPT_LEVEL_BUTTONS      3
+#define INTERRUPT_LEVEL_STOPWATCH    3
+#define INTERRUPT_LEVEL_UART         4
+#define INTERRUPT_LEVEL_AUDIO        5
+#define INTERRUPT_LEVEL_MOTOR        5
+#define INTERRUPT_LEVEL_DMA          6
+#define INTERRUPT_LEVEL_LED_EFFECTS  6
+#define INTERRUPT_LEVEL_LCD_STREAM   7
+#define INTERRUPT_LEVEL_MARQUEE      7
+
+// Level of the critical sections that may be entered from any interrupt but SysTick
+#define INTERRUPT_LEVEL_ALL 1
+
+// BASEPRI value that masks a level and the levels below it
+#define INTERRUPT_BASEPRI(level) ((uint32_t)(level) << (8 - __NVIC_PRIO_BITS))
+
+// IRQ of an entry whose timer has not been enabled yet
+#define INTERRUPT_IRQ_NONE -128
+
+enum Interrupt_Sources
+{
+	INTERRUPT_SYSTICK          = 0x00,
+	INTERRUPT_TONE             = 0x01,
+	INTERRUPT_STEPPER          = 0x02,
+	INTERRUPT_INPUT_TICK       = 0x03,
+	INTERRUPT_PMOD_BTN         = 0x04,
+	INTERRUPT_EDUBASE_BTN      = 0x05,
+	INTERRUPT_PMOD_ENC         = 0x06,
+	INTERRUPT_STOPWATCH_START  = 0x07,
+	INTERRUPT_STOPWATCH_LAP    = 0x08,
+	INTERRUPT_UART0            = 0x09,
+	INTERRUPT_AUDIO            = 0x0A,
+	INTERRUPT_MOTOR            = 0x0B,
+	INTERRUPT_DMA_ERROR        = 0x0C,
+	INTERRUPT_LED_EFFECTS      = 0x0D,
+	INTERRUPT_LCD_STREAM       = 0x0E,
+	INTERRUPT_MARQUEE          = 0x0F,
+	INTERRUPT_NUM_SOURCES      = 0x10
+};
+
+typedef struct
+{
+	const char *name;
+
+	// IRQ number, or INTERRUPT_IRQ_NONE for a timer handed out by the GPTM driver
+	int16_t irq;
+
+	uint8_t level;
+	uint8_t sub_priority;
+} Interrupt_Config;
+
+typedef struct
+{
+	const char *name;
+	int16_t irq;
+	uint8_t level;
+	uint8_t sub_priority;
+	uint8_t enabled;
+
+	// Longest time that the interrupt has been masked by a critical section
+	uint32_t blocking_us;
+} Interrupt_Report;
+
+// Longest critical section of each level, and the start of the current one, in DWT cycles
+extern volatile uint32_t Interrupt_Lock_Max_Cycles[INTERRUPT_LEVELS];
+extern uint32_t Interrupt_Lock_Start[INTERRUPT_LEVELS];
+
+/**
+ * @brief Selects the priority grouping and starts the cycle counter used to time the critical sections.
+ *
+ * This function must be called before any interrupt is enabled.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Interrupt_Config_Init(void);
+
+/**
+ * @brief Sets the priority of an interrupt from the plan and enables it in the NVIC.
+ *
+ * SysTick is only given its priority, since it is enabled in the SysTick registers.
+ *
+ * @param source The entry of the plan (see Interrupt_Sources).
+ *
+ * @return None
+ */
+void Interrupt_Config_Enable(uint8_t source);
+
+/**
+ * @brief Sets the priority of an interrupt whose IRQ is only known at runtime and enables it.
+ *
+ * This is used by the GPTM driver, whose channels are handed out at runtime.
+ *
+ * @param source The entry of the plan (see Interrupt_Sources).
+ *
+ * @param irq The IRQ number of the interrupt.
+ *
+ * @return None
+ */
+void Interrupt_Config_Enable_IRQ(uint8_t source, int16_t irq);
+
+/**
+ * @brief Reads the configuration and the worst-case blocking time of an interrupt.
+ *
+ * The blocking time is the longest critical section of the interrupt's level or a higher
+ * level since the last call to Interrupt_Config_Reset.
+ *
+ * @param source The entry of the plan (see Interrupt_Sources).
+ *
+ * @param report A pointer to where the report is stored.
+ *
+ * @return 1 if the report was read, or 0 if the source is out of range.
+ */
+uint8_t Interrupt_Config_Read(uint8_t source, Interrupt_Report *report);
+
+/**
+ * @brief Clears the longest critical section of every level.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Interrupt_Config_Reset(void);
+
+/**
+ * @brief Enters a critical section that masks the interrupts of a level and of the levels below it.
+ *
+ * The interrupts of the higher levels keep running. Critical sections can be nested,
+ * and only the outermost section of a level is timed.
+ *
+ * @param level The level of the highest-priority interrupt that shares the state (1 to 7).
+ *
+ * @return The previous value of BASEPRI, to be passed to Interrupt_Unlock.
+ */
+static __inline uint32_t Interrupt_Lock(uint8_t level)
+{
+	uint32_t basepri = __get_BASEPRI();
+
+	__set_BASEPRI_MAX(INTERRUPT_BASEPRI(level));
+
+#if INTERRUPT_LOCK_TIMING
+	if ((basepri == 0) || (basepri > INTERRUPT_BASEPRI(level)))
+	{
+		Interrupt_Lock_Start[level] = DWT->CYCCNT;
+	}
+#endif
+
+	return basepri;
+}
+
+/**
+ * @brief Leaves a critical section entered with Interrupt_Lock.
+ *
+ * @param level The level passed to Interrupt_Lock.
+ *
+ * @param basepri The value returned by Interrupt_Lock.
+ *
+ * @return None
+ */
+static __inline void Interrupt_Unlock(uint8_t level, uint32_t basepri)
+{
+#if INTERRUPT_LOCK_TIMING
+	if ((basepri == 0) || (basepri > INTERRUPT_BASEPRI(level)))
+	{
+		uint32_t cycles = DWT->CYCCNT - Interrupt_Lock_Start[level];
+
+		if (cycles > Interrupt_Lock_Max_Cycles[level])
+		{
+			Interrupt_Lock_Max_Cycles[level] = cycles;
+		}
+	}
+#endif
+
+	__set_BASEPRI(basepri);
+}
+
+#endif
@@ -0,0 +1,128 @@
+/**
+ * @file LCD_Glyph_Cache.c
+ *
+ * @brief Source code for the LCD_Glyph_Cache driver.
+ *
+ * This file contains the function definitions for the LCD_Glyph_Cache driver.
+ * It keeps track of the glyph loaded in each CGRAM slot and evicts the least recently used one.
+ */
+
+#include "LCD_Glyph_Cache.h"
+#include "EduBase_LCD.h"
+
+const LCD_Glyph LCD_GLYPH_ARROW_UP    = { { 0x04, 0x0E, 0x15, 0x04, 0x04, 0x04, 0x04, 0x00 }, '^' };
+const LCD_Glyph LCD_GLYPH_ARROW_DOWN  = { { 0x04, 0x04, 0x04, 0x04, 0x15, 0x0E, 0x04, 0x00 }, 'v' };
+const LCD_Glyph LCD_GLYPH_ARROW_LEFT  = { { 0x00, 0x04, 0x08, 0x1F, 0x08, 0x04, 0x00, 0x00 }, '<' };
+const LCD_Glyph LCD_GLYPH_ARROW_RIGHT = { { 0x00, 0x04, 0x02, 0x1F, 0x02, 0x04, 0x00, 0x00 }, '>' };
+const LCD_Glyph LCD_GLYPH_PROGRESS_1  = { { 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10 }, ' ' };
+const LCD_Glyph LCD_GLYPH_PROGRESS_2  = { { 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18 }, ' ' };
+const LCD_Glyph LCD_GLYPH_PROGRESS_3  = { { 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C }, '|' };
+const LCD_Glyph LCD_GLYPH_PROGRESS_4  = { { 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E }, '|' };
+const LCD_Glyph LCD_GLYPH_MORSE_DOT   = { { 0x00, 0x00, 0x00, 0x0E, 0x0E, 0x00, 0x00, 0x00 }, '.' };
+const LCD_Glyph LCD_GLYPH_MORSE_DASH  = { { 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x00, 0x00, 0x00 }, '-' };
+const LCD_Glyph LCD_GLYPH_E_ACUTE     = { { 0x02, 0x04, 0x0E, 0x11, 0x1F, 0x10, 0x0E, 0x00 }, 'e' };
+const LCD_Glyph LCD_GLYPH_E_GRAVE     = { { 0x08, 0x04, 0x0E, 0x11, 0x1F, 0x10, 0x0E, 0x00 }, 'e' };
+const LCD_Glyph LCD_GLYPH_A_GRAVE     = { { 0x08, 0x04, 0x0E, 0x01, 0x0F, 0x11, 0x0F, 0x00 }, 'a' };
+const LCD_Glyph LCD_GLYPH_C_CEDILLA   = { { 0x00, 0x0E, 0x10, 0x10, 0x11, 0x0E, 0x04, 0x0C }, 'c' };
+const LCD_Glyph LCD_GLYPH_N_TILDE     = { { 0x0D, 0x12, 0x00, 0x16, 0x19, 0x11, 0x11, 0x00 }, 'n' };
+
+typedef struct
+{
+	const LCD_Glyph *glyph;
+	uint32_t last_used;
+	uint32_t frame;
+} LCD_Glyph_Slot;
+
+static LCD_Glyph_Slot glyph_slots[LCD_GLYPH_SLOTS];
+
+// Use counter for the LRU order, and the current frame number
+static uint32_t use_counter = 0;
+static uint32_t current_frame = 1;
+
+volatile uint32_t LCD_Glyph_Hits = 0;
+volatile uint32_t LCD_Glyph_Uploads = 0;
+
+static void LCD_Glyph_Upload(uint8_t slot, const LCD_Glyph *glyph)
+{
+	uint8_t address = EduBase_LCD_Get_Address();
+	
+	// Each slot holds 8 rows, starting at CGRAM address (slot * 8)
+	EduBase_LCD_Send_Command(SET_CGRAM_ADDR | (slot << 3));
+	
+	for (uint8_t i = 0; i < 8; i++)
+	{
+		EduBase_LCD_Send_Data(glyph->rows[i]);
+	}
+	
+	// Point the address counter back to the DDRAM position of the cursor
+	EduBase_LCD_Send_Command(SET_DDRAM_ADDR | address);
+	
+	LCD_Glyph_Uploads++;
+}
+
+void LCD_Glyph_Cache_Init(void)
+{
+	for (uint8_t i = 0; i < LCD_GLYPH_SLOTS; i++)
+	{
+		glyph_slots[i].glyph = 0;
+		glyph_slots[i].last_used = 0;
+		glyph_slots[i].frame = 0;
+	}
+	
+	use_counter = 0;
+	current_frame = 1;
+}
+
+void LCD_Glyph_Cache_Begin_Frame(void)
+{
+	current_frame++;
+}
+
+char LCD_Glyph_Cache_Load(const LCD_Glyph *glyph)
+{
+	uint8_t victim = LCD_GLYPH_SLOTS;
+	
+	use_counter++;
+	
+	for (uint8_t i = 0; i < LCD_GLYPH_SLOTS; i++)
+	{
+		// The glyph is already loaded
+		if (glyph_slots[i].glyph == glyph)
+		{
+			glyph_slots[i].last_used = use_counter;
+			glyph_slots[i].frame = current_frame;
+			LCD_Glyph_Hits++;
+			return (char)(0x08 + i);
+		}
+		
+		// Prefer an empty slot, then the least recently used slot outside of the current frame
+		if (glyph_slots[i].frame != current_frame)
+		{
+			if ((victim == LCD_GLYPH_SLOTS) ||
+			    ((glyph_slots[victim].glyph != 0) &&
+			     ((glyph_slots[i].glyph == 0) || (glyph_slots[i].last_used < glyph_slots[victim].last_used))))
+			{
+				victim = i;
+			}
+		}
+	}
+	
+	// Every slot is on the screen
+	if (victim == LCD_GLYPH_SLOTS)
+	{
+		return glyph->fallback;
+	}
+	
+	LCD_Glyph_Upload(victim, glyph);
+	
+	glyph_slots[victim].glyph = glyph;
+	glyph_slots[victim].last_used = use_counter;
+	glyph_slots[victim].frame = current_frame;
+	
+	return (char)(0x08 + victim);
+}
+
+void LCD_Glyph_Cache_Write(const LCD_Glyph *glyph)
+{
+	EduBase_LCD_Send_Data(LCD_Glyph_Cache_Load(glyph));
+}
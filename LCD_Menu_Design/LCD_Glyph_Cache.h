@@ -0,0 +1,107 @@
+/**
+ * @file LCD_Glyph_Cache.h
+ *
+ * @brief Header file for the LCD_Glyph_Cache driver.
+ *
+ * This file contains the function definitions for the LCD_Glyph_Cache driver.
+ * It maps custom glyphs to the 8 CGRAM slots of the HD44780 LCD controller on demand.
+ *
+ * A glyph is only uploaded to the CGRAM when it is not already loaded, since an upload
+ * takes 9 LCD writes. When all slots are taken, the least recently used glyph is evicted.
+ * Glyphs used since the last call to LCD_Glyph_Cache_Begin_Frame are never evicted, because
+ * they may be on the screen. If all 8 slots are in use by the current frame, the fallback
+ * character of the glyph is displayed instead.
+ *
+ * The character codes returned by the cache are 0x08 to 0x0F, which the HD44780 maps to the
+ * same CGRAM slots as 0x00 to 0x07, so that they can be embedded in null-terminated strings.
+ *
+ * @note For more information regarding the CGRAM, refer to the HD44780 LCD Controller Datasheet.
+ * Link: https://www.sparkfun.com/datasheets/LCD/HD44780.pdf
+ */
+
+#ifndef LCD_GLYPH_CACHE_H
+#define LCD_GLYPH_CACHE_H
+
+#include "TM4C123GH6PM.h"
+
+// Number of CGRAM slots for 5x8 glyphs
+#define LCD_GLYPH_SLOTS 8
+
+typedef struct
+{
+	// Pixel rows from top to bottom, using Bits 4 to 0
+	uint8_t rows[8];
+	
+	// Character displayed when the glyph cannot be loaded
+	char fallback;
+} LCD_Glyph;
+
+// Built-in glyphs
+extern const LCD_Glyph LCD_GLYPH_ARROW_UP;
+extern const LCD_Glyph LCD_GLYPH_ARROW_DOWN;
+extern const LCD_Glyph LCD_GLYPH_ARROW_LEFT;
+extern const LCD_Glyph LCD_GLYPH_ARROW_RIGHT;
+extern const LCD_Glyph LCD_GLYPH_PROGRESS_1;
+extern const LCD_Glyph LCD_GLYPH_PROGRESS_2;
+extern const LCD_Glyph LCD_GLYPH_PROGRESS_3;
+extern const LCD_Glyph LCD_GLYPH_PROGRESS_4;
+extern const LCD_Glyph LCD_GLYPH_MORSE_DOT;
+extern const LCD_Glyph LCD_GLYPH_MORSE_DASH;
+extern const LCD_Glyph LCD_GLYPH_E_ACUTE;
+extern const LCD_Glyph LCD_GLYPH_E_GRAVE;
+extern const LCD_Glyph LCD_GLYPH_A_GRAVE;
+extern const LCD_Glyph LCD_GLYPH_C_CEDILLA;
+extern const LCD_Glyph LCD_GLYPH_N_TILDE;
+
+// Full block character of the HD44780 character ROM, used for full progress cells
+#define LCD_CHAR_FULL_BLOCK 0xFF
+
+// Cache statistics
+extern volatile uint32_t LCD_Glyph_Hits;
+extern volatile uint32_t LCD_Glyph_Uploads;
+
+/**
+ * @brief Empties the glyph cache.
+ *
+ * This function must be called after EduBase_LCD_Init, since the CGRAM content is undefined at power-on.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void LCD_Glyph_Cache_Init(void);
+
+/**
+ * @brief Starts a new frame.
+ *
+ * This function must be called when the screen is cleared or redrawn. The glyphs used before
+ * this call become evictable again.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void LCD_Glyph_Cache_Begin_Frame(void);
+
+/**
+ * @brief Loads a glyph into the CGRAM if needed and returns its character code.
+ *
+ * If the glyph has to be uploaded, the DDRAM address is restored afterwards, so the
+ * cursor is not moved.
+ *
+ * @param glyph A pointer to the glyph.
+ *
+ * @return The character code of the glyph (0x08 - 0x0F), or its fallback character if no slot is free.
+ */
+char LCD_Glyph_Cache_Load(const LCD_Glyph *glyph);
+
+/**
+ * @brief Displays a glyph at the cursor position.
+ *
+ * @param glyph A pointer to the glyph.
+ *
+ * @return None
+ */
+void LCD_Glyph_Cache_Write(const LCD_Glyph *glyph);
+
+#endif
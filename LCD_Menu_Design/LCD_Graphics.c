@@ -0,0 +1,231 @@
+/**
+ * @file LCD_Graphics.c
+ *
+ * @brief Source code for the LCD_Graphics driver.
+ *
+ * This file contains the function definitions for the LCD_Graphics driver.
+ * It renders into a shadow copy of the screen and only sends the cells that changed.
+ */
+
+#include "LCD_Graphics.h"
+#include "LCD_Glyph_Cache.h"
+#include "EduBase_LCD.h"
+
+// Value of a shadow cell whose content is unknown. The glyph cache only uses
+// the character codes 0x08 to 0x0F, so code 0x00 is never displayed by this driver
+#define LCD_CELL_UNKNOWN 0x00
+
+// Glyphs used by the big numerals: bars at the top, at the bottom, or both
+static const LCD_Glyph LCD_GLYPH_BIG_TOP    = { { 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, '-' };
+static const LCD_Glyph LCD_GLYPH_BIG_BOTTOM = { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F }, '_' };
+static const LCD_Glyph LCD_GLYPH_BIG_BOTH   = { { 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F }, '=' };
+
+// Cells of the big numerals: top row then bottom row, 3 cells each.
+// F = full block, T = top bar, B = bottom bar, X = both bars
+enum Big_Digit_Cells
+{
+	CELL_SPACE  = 0,
+	CELL_FULL   = 1,
+	CELL_TOP    = 2,
+	CELL_BOTTOM = 3,
+	CELL_BOTH   = 4
+};
+
+static const uint8_t big_digit_cells[10][6] =
+{
+	{ CELL_FULL,   CELL_TOP,    CELL_FULL,   CELL_FULL,   CELL_BOTTOM, CELL_FULL   },	// 0
+	{ CELL_TOP,    CELL_FULL,   CELL_SPACE,  CELL_BOTTOM, CELL_FULL,   CELL_BOTTOM },	// 1
+	{ CELL_BOTH,   CELL_BOTH,   CELL_FULL,   CELL_FULL,   CELL_BOTTOM, CELL_BOTTOM },	// 2
+	{ CELL_TOP,    CELL_BOTH,   CELL_FULL,   CELL_BOTTOM, CELL_BOTTOM, CELL_FULL   },	// 3
+	{ CELL_FULL,   CELL_BOTTOM, CELL_FULL,   CELL_SPACE,  CELL_SPACE,  CELL_FULL   },	// 4
+	{ CELL_FULL,   CELL_BOTH,   CELL_BOTH,   CELL_BOTTOM, CELL_BOTTOM, CELL_FULL   },	// 5
+	{ CELL_FULL,   CELL_BOTH,   CELL_BOTH,   CELL_FULL,   CELL_BOTTOM, CELL_FULL   },	// 6
+	{ CELL_TOP,    CELL_TOP,    CELL_FULL,   CELL_SPACE,  CELL_SPACE,  CELL_FULL   },	// 7
+	{ CELL_FULL,   CELL_BOTH,   CELL_FULL,   CELL_FULL,   CELL_BOTTOM, CELL_FULL   },	// 8
+	{ CELL_FULL,   CELL_BOTH,   CELL_FULL,   CELL_BOTTOM, CELL_BOTTOM, CELL_FULL   }	// 9
+};
+
+// Glyphs of the partially filled bar cells, indexed by the number of filled pixel columns
+static const LCD_Glyph *const bar_glyphs[5] =
+{
+	0,
+	&LCD_GLYPH_PROGRESS_1,
+	&LCD_GLYPH_PROGRESS_2,
+	&LCD_GLYPH_PROGRESS_3,
+	&LCD_GLYPH_PROGRESS_4
+};
+
+// Characters currently on the screen
+static char screen[LCD_ROWS][LCD_COLUMNS];
+
+volatile uint32_t LCD_Graphics_Cells_Written = 0;
+volatile uint32_t LCD_Graphics_Cells_Skipped = 0;
+
+static uint8_t LCD_Cell_Address(uint8_t row, uint8_t column)
+{
+	return (uint8_t)(((row == 0) ? 0x00 : 0x40) + column);
+}
+
+void LCD_Graphics_Init(void)
+{
+	LCD_Graphics_Invalidate();
+}
+
+void LCD_Graphics_Clear(void)
+{
+	EduBase_LCD_Clear_Display();
+	LCD_Glyph_Cache_Begin_Frame();
+	
+	for (uint8_t row = 0; row < LCD_ROWS; row++)
+	{
+		for (uint8_t column = 0; column < LCD_COLUMNS; column++)
+		{
+			screen[row][column] = ' ';
+		}
+	}
+}
+
+void LCD_Graphics_Begin_Frame(void)
+{
+	LCD_Glyph_Cache_Begin_Frame();
+}
+
+void LCD_Graphics_Invalidate(void)
+{
+	for (uint8_t row = 0; row < LCD_ROWS; row++)
+	{
+		for (uint8_t column = 0; column < LCD_COLUMNS; column++)
+		{
+			screen[row][column] = LCD_CELL_UNKNOWN;
+		}
+	}
+}
+
+void LCD_Graphics_Put_Char(uint8_t row, uint8_t column, char character)
+{
+	if ((row >= LCD_ROWS) || (column >= LCD_COLUMNS)) return;
+	
+	if (screen[row][column] == character)
+	{
+		LCD_Graphics_Cells_Skipped++;
+		return;
+	}
+	
+	// Only move the cursor when the cell is not the next one to be written
+	uint8_t address = LCD_Cell_Address(row, column);
+	
+	if (EduBase_LCD_Get_Address() != address)
+	{
+		EduBase_LCD_Send_Command(SET_DDRAM_ADDR | address);
+	}
+	
+	EduBase_LCD_Send_Data((uint8_t)character);
+	screen[row][column] = character;
+	LCD_Graphics_Cells_Written++;
+}
+
+static void LCD_Graphics_Put_Glyph(uint8_t row, uint8_t column, const LCD_Glyph *glyph)
+{
+	// Loading the glyph may upload it, which restores the address counter afterwards
+	LCD_Graphics_Put_Char(row, column, LCD_Glyph_Cache_Load(glyph));
+}
+
+void LCD_Graphics_Put_String(uint8_t row, uint8_t column, const char *string)
+{
+	while ((*string != '\0') && (column < LCD_COLUMNS))
+	{
+		LCD_Graphics_Put_Char(row, column++, *string++);
+	}
+}
+
+void LCD_Graphics_Bar(uint8_t row, uint8_t column, uint8_t width, uint32_t value, uint32_t max_value)
+{
+	if ((max_value == 0) || (width == 0)) return;
+	
+	if (value > max_value)
+	{
+		value = max_value;
+	}
+	
+	// Number of filled pixel columns, 5 per cell
+	uint32_t filled = ((uint64_t)value * width * 5) / max_value;
+	
+	for (uint8_t i = 0; i < width; i++)
+	{
+		if (filled >= 5)
+		{
+			LCD_Graphics_Put_Char(row, column + i, (char)LCD_CHAR_FULL_BLOCK);
+			filled -= 5;
+		}
+		else if (filled > 0)
+		{
+			LCD_Graphics_Put_Glyph(row, column + i, bar_glyphs[filled]);
+			filled = 0;
+		}
+		else
+		{
+			LCD_Graphics_Put_Char(row, column + i, ' ');
+		}
+	}
+}
+
+static void LCD_Graphics_Put_Big_Cell(uint8_t row, uint8_t column, uint8_t cell)
+{
+	switch (cell)
+	{
+		case CELL_FULL:
+		{
+			LCD_Graphics_Put_Char(row, column, (char)LCD_CHAR_FULL_BLOCK);
+			break;
+		}
+		
+		case CELL_TOP:
+		{
+			LCD_Graphics_Put_Glyph(row, column, &LCD_GLYPH_BIG_TOP);
+			break;
+		}
+		
+		case CELL_BOTTOM:
+		{
+			LCD_Graphics_Put_Glyph(row, column, &LCD_GLYPH_BIG_BOTTOM);
+			break;
+		}
+		
+		case CELL_BOTH:
+		{
+			LCD_Graphics_Put_Glyph(row, column, &LCD_GLYPH_BIG_BOTH);
+			break;
+		}
+		
+		default:
+		{
+			LCD_Graphics_Put_Char(row, column, ' ');
+			break;
+		}
+	}
+}
+
+void LCD_Graphics_Big_Digit(uint8_t column, uint8_t digit)
+{
+	for (uint8_t i = 0; i < 3; i++)
+	{
+		uint8_t top = (digit < 10) ? big_digit_cells[digit][i] : CELL_SPACE;
+		uint8_t bottom = (digit < 10) ? big_digit_cells[digit][i + 3] : CELL_SPACE;
+		
+		LCD_Graphics_Put_Big_Cell(0, column + i, top);
+		LCD_Graphics_Put_Big_Cell(1, column + i, bottom);
+	}
+}
+
+void LCD_Graphics_Big_Number(uint8_t column, uint32_t value, uint8_t num_digits)
+{
+	// Draw the numerals from the right so that leading zeros can be blanked
+	for (uint8_t i = num_digits; i > 0; i--)
+	{
+		uint8_t digit_column = column + ((i - 1) * LCD_BIG_DIGIT_WIDTH);
+		uint8_t blank = (value == 0) && (i != num_digits);
+		
+		LCD_Graphics_Big_Digit(digit_column, blank ? 0xFF : (uint8_t)(value % 10));
+		value /= 10;
+	}
+}
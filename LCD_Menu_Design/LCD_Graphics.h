@@ -0,0 +1,153 @@
+/**
+ * @file LCD_Graphics.h
+ *
+ * @brief Header file for the LCD_Graphics driver.
+ *
+ * This file contains the function definitions for the LCD_Graphics driver.
+ * It draws text, horizontal bar graphs and two-row big numerals on the EduBase 16x2 LCD.
+ *
+ * The driver keeps a copy of the characters on the screen and only rewrites the cells
+ * whose character changed, so redrawing a live value usually costs a few LCD writes.
+ * The cursor is only moved when the next changed cell is not at the current address.
+ *
+ * Bar graphs have a resolution of 5 pixels per cell and use the partial progress glyphs,
+ * and big numerals are 3 cells wide and use 3 custom glyphs. The custom glyphs are loaded
+ * through the LCD_Glyph_Cache driver.
+ *
+ * A redraw starts with LCD_Graphics_Begin_Frame and draws every cell that holds a custom
+ * glyph, even if it is unchanged, so that the glyphs on the screen stay in the cache and
+ * the ones that are gone can be evicted.
+ *
+ * @note Text written to the LCD without this driver is not tracked. LCD_Graphics_Invalidate
+ * must be called after such writes, or LCD_Graphics_Clear used to start a new screen.
+ */
+
+#ifndef LCD_GRAPHICS_H
+#define LCD_GRAPHICS_H
+
+#include "TM4C123GH6PM.h"
+
+#define LCD_ROWS    2
+#define LCD_COLUMNS 16
+
+// Width of a big numeral in cells, including the gap to the next numeral
+#define LCD_BIG_DIGIT_WIDTH 4
+
+// Number of cells written and skipped because they were already up to date
+extern volatile uint32_t LCD_Graphics_Cells_Written;
+extern volatile uint32_t LCD_Graphics_Cells_Skipped;
+
+/**
+ * @brief Initializes the renderer.
+ *
+ * This function must be called after EduBase_LCD_Init and LCD_Glyph_Cache_Init.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void LCD_Graphics_Init(void);
+
+/**
+ * @brief Clears the LCD and starts a new screen.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void LCD_Graphics_Clear(void);
+
+/**
+ * @brief Starts a redraw of the screen.
+ *
+ * The glyphs drawn after this call are kept in the glyph cache until the next redraw.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void LCD_Graphics_Begin_Frame(void);
+
+/**
+ * @brief Forgets the content of the screen, so the next drawing rewrites every cell it covers.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void LCD_Graphics_Invalidate(void);
+
+/**
+ * @brief Draws a character if it differs from the one on the screen.
+ *
+ * @param row The row of the cell (0 or 1).
+ *
+ * @param column The column of the cell (0 - 15).
+ *
+ * @param character The character to display.
+ *
+ * @return None
+ */
+void LCD_Graphics_Put_Char(uint8_t row, uint8_t column, char character);
+
+/**
+ * @brief Draws a string, rewriting only the cells that changed.
+ *
+ * The string is clipped at the end of the row.
+ *
+ * @param row The row of the first character (0 or 1).
+ *
+ * @param column The column of the first character (0 - 15).
+ *
+ * @param string The null-terminated string to display.
+ *
+ * @return None
+ */
+void LCD_Graphics_Put_String(uint8_t row, uint8_t column, const char *string);
+
+/**
+ * @brief Draws a horizontal bar graph.
+ *
+ * The bar is filled from the left in steps of one pixel column, with 5 pixel columns per cell.
+ *
+ * @param row The row of the bar (0 or 1).
+ *
+ * @param column The column of the first cell of the bar (0 - 15).
+ *
+ * @param width The width of the bar in cells.
+ *
+ * @param value The value to display (clipped to max_value).
+ *
+ * @param max_value The value of a full bar.
+ *
+ * @return None
+ */
+void LCD_Graphics_Bar(uint8_t row, uint8_t column, uint8_t width, uint32_t value, uint32_t max_value);
+
+/**
+ * @brief Draws a big numeral over both rows.
+ *
+ * @param column The column of the left cell of the numeral (0 - 13).
+ *
+ * @param digit The digit to display (0 - 9), or any other value to blank the cells.
+ *
+ * @return None
+ */
+void LCD_Graphics_Big_Digit(uint8_t column, uint8_t digit);
+
+/**
+ * @brief Draws a right-aligned number with big numerals over both rows.
+ *
+ * Leading zeros are blanked. Each numeral takes LCD_BIG_DIGIT_WIDTH cells.
+ *
+ * @param column The column of the left cell of the number.
+ *
+ * @param value The value to display.
+ *
+ * @param num_digits The number of numerals (at most 4 fit on the screen).
+ *
+ * @return None
+ */
+void LCD_Graphics_Big_Number(uint8_t column, uint32_t value, uint8_t num_digits);
+
+#endif
@@ -0,0 +1,80 @@
+/**
+ * @file LCD_Screens.c
+ *
+ * @brief Precompiled LCD screens.
+ *
+ * This file is generated by Tools/lcd_stream_gen.py from Tools/lcd_screens.txt.
+ * Do not edit it.
+ */
+
+#include "LCD_Screens.h"
+
+static const uint8_t lcd_screen_splash_codes[90] =
+{
+	0x00, 0x01, 0xD0,  // Clear Display
+	0x08, 0x01, 0x82,  // Set DDRAM Address 0x01
+	0x14, 0x1D, 0x82,  // 'M'
+	0x16, 0x1F, 0x82,  // 'o'
+	0x17, 0x12, 0x82,  // 'r'
+	0x17, 0x13, 0x82,  // 's'
+	0x16, 0x15, 0x82,  // 'e'
+	0x12, 0x10, 0x82,  // ' '
+	0x14, 0x14, 0x82,  // 'D'
+	0x16, 0x15, 0x82,  // 'e'
+	0x16, 0x13, 0x82,  // 'c'
+	0x16, 0x1F, 0x82,  // 'o'
+	0x16, 0x14, 0x82,  // 'd'
+	0x16, 0x15, 0x82,  // 'e'
+	0x17, 0x12, 0x82,  // 'r'
+	0x0C, 0x02, 0x82,  // Set DDRAM Address 0x42
+	0x15, 0x14, 0x82,  // 'T'
+	0x14, 0x1D, 0x82,  // 'M'
+	0x13, 0x14, 0x82,  // '4'
+	0x14, 0x13, 0x82,  // 'C'
+	0x13, 0x11, 0x82,  // '1'
+	0x13, 0x12, 0x82,  // '2'
+	0x13, 0x13, 0x82,  // '3'
+	0x12, 0x10, 0x82,  // ' '
+	0x15, 0x12, 0x82,  // 'R'
+	0x16, 0x15, 0x82,  // 'e'
+	0x16, 0x11, 0x82,  // 'a'
+	0x16, 0x14, 0x82,  // 'd'
+	0x17, 0x19, 0x82,  // 'y'
+	0x08, 0x00, 0x82,  // Set DDRAM Address 0x00
+};
+
+const LCD_Stream LCD_SCREEN_SPLASH = { lcd_screen_splash_codes, 90, 0x00 };
+
+static const uint8_t lcd_screen_stopwatch_codes[84] =
+{
+	0x00, 0x01, 0xD0,  // Clear Display
+	0x08, 0x00, 0x82,  // Set DDRAM Address 0x00
+	0x15, 0x13, 0x82,  // 'S'
+	0x17, 0x14, 0x82,  // 't'
+	0x16, 0x1F, 0x82,  // 'o'
+	0x17, 0x10, 0x82,  // 'p'
+	0x17, 0x17, 0x82,  // 'w'
+	0x16, 0x11, 0x82,  // 'a'
+	0x17, 0x14, 0x82,  // 't'
+	0x16, 0x13, 0x82,  // 'c'
+	0x16, 0x18, 0x82,  // 'h'
+	0x0C, 0x00, 0x82,  // Set DDRAM Address 0x40
+	0x15, 0x13, 0x82,  // 'S'
+	0x15, 0x17, 0x82,  // 'W'
+	0x13, 0x15, 0x82,  // '5'
+	0x12, 0x10, 0x82,  // ' '
+	0x14, 0x17, 0x82,  // 'G'
+	0x16, 0x1F, 0x82,  // 'o'
+	0x12, 0x10, 0x82,  // ' '
+	0x12, 0x10, 0x82,  // ' '
+	0x15, 0x13, 0x82,  // 'S'
+	0x15, 0x17, 0x82,  // 'W'
+	0x13, 0x14, 0x82,  // '4'
+	0x12, 0x10, 0x82,  // ' '
+	0x14, 0x1C, 0x82,  // 'L'
+	0x16, 0x11, 0x82,  // 'a'
+	0x17, 0x10, 0x82,  // 'p'
+	0x08, 0x00, 0x82,  // Set DDRAM Address 0x00
+};
+
+const LCD_Stream LCD_SCREEN_STOPWATCH = { lcd_screen_stopwatch_codes, 84, 0x00 };
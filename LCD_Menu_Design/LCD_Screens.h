@@ -0,0 +1,18 @@
+/**
+ * @file LCD_Screens.h
+ *
+ * @brief Precompiled LCD screens.
+ *
+ * This file is generated by Tools/lcd_stream_gen.py from Tools/lcd_screens.txt.
+ * Do not edit it. Each screen is played with LCD_Stream_Play.
+ */
+
+#ifndef LCD_SCREENS_H
+#define LCD_SCREENS_H
+
+#include "LCD_Stream.h"
+
+extern const LCD_Stream LCD_SCREEN_SPLASH;
+extern const LCD_Stream LCD_SCREEN_STOPWATCH;
+
+#endif
@@ -0,0 +1,126 @@
+/**
+ * @file LCD_Stream.c
+ *
+ * @brief Source code for the LCD_Stream driver.
+ *
+ * This file contains the function definitions for the LCD_Stream driver.
+ * Each nibble is written in three steps one microsecond apart (data lines and register
+ * select, enable high, enable low), and the wait codes delay the next step. The next
+ * step is scheduled by restarting a one-shot timer from its own interrupt.
+ */
+
+#include "LCD_Stream.h"
+#include "EduBase_LCD.h"
+#include "GPTM.h"
+#include "Interrupt_Config.h"
+
+// Step of the nibble being written
+#define STEP_NEXT_CODE 0
+#define STEP_ENABLE_HIGH 1
+#define STEP_ENABLE_LOW 2
+
+static int8_t stream_timer = -1;
+
+// Queue of the streams to play. The stream at the tail is being played.
+// The head and tail are free-running counters.
+static const LCD_Stream *stream_queue[LCD_STREAM_QUEUE_SIZE];
+static volatile uint8_t queue_head = 0;
+static volatile uint8_t queue_tail = 0;
+
+static uint16_t position = 0;
+static uint8_t step = STEP_NEXT_CODE;
+
+static void LCD_Stream_Step(void)
+{
+	const LCD_Stream *stream = stream_queue[queue_tail % LCD_STREAM_QUEUE_SIZE];
+	uint32_t delay_us = 1;
+
+	if (step == STEP_ENABLE_HIGH)
+	{
+		EduBase_LCD_Set_Enable(1);
+		step = STEP_ENABLE_LOW;
+	}
+	else if (step == STEP_ENABLE_LOW)
+	{
+		// The LCD latches the nibble on the falling edge of the enable pin
+		EduBase_LCD_Set_Enable(0);
+		step = STEP_NEXT_CODE;
+	}
+	else if (position < stream->length)
+	{
+		uint8_t code = stream->codes[position];
+		position++;
+
+		if (code & 0x80)
+		{
+			delay_us = (uint32_t)(code & 0x7F) * LCD_STREAM_WAIT_UNIT_US;
+		}
+		else
+		{
+			EduBase_LCD_Set_Bus(code & 0x0F, (code >> 4) & 0x01);
+			step = STEP_ENABLE_HIGH;
+		}
+	}
+	else
+	{
+		// The stream has ended. Keep the address counter of the EduBase_LCD driver
+		// in step with the LCD, and start the next stream if there is one
+		EduBase_LCD_Sync_Address(stream->end_address);
+		position = 0;
+		queue_tail = queue_tail + 1;
+
+		if (queue_tail == queue_head) return;
+	}
+
+	if (delay_us == 0)
+	{
+		delay_us = 1;
+	}
+
+	GPTM_Start_One_Shot((uint8_t)stream_timer, delay_us, &LCD_Stream_Step, INTERRUPT_LCD_STREAM);
+}
+
+void LCD_Stream_Init(void)
+{
+	// Any free half is enough, with its prescaler it can wait up to 335 ms
+	stream_timer = GPTM_Allocate(0);
+}
+
+uint8_t LCD_Stream_Play(const LCD_Stream *stream)
+{
+	if (stream_timer < 0) return 0;
+
+	uint32_t basepri = Interrupt_Lock(INTERRUPT_LEVEL_LCD_STREAM);
+
+	if ((uint8_t)(queue_head - queue_tail) >= LCD_STREAM_QUEUE_SIZE)
+	{
+		Interrupt_Unlock(INTERRUPT_LEVEL_LCD_STREAM, basepri);
+		return 0;
+	}
+
+	uint8_t idle = (queue_head == queue_tail);
+
+	stream_queue[queue_head % LCD_STREAM_QUEUE_SIZE] = stream;
+	queue_head = queue_head + 1;
+
+	// Start playing if no stream was playing, otherwise the stream starts
+	// after the streams ahead of it
+	if (idle)
+	{
+		LCD_Stream_Step();
+	}
+
+	Interrupt_Unlock(INTERRUPT_LEVEL_LCD_STREAM, basepri);
+
+	return 1;
+}
+
+uint8_t LCD_Stream_Busy(void)
+{
+	return (queue_head != queue_tail);
+}
+
+void LCD_Stream_Wait(void)
+{
+	while (LCD_Stream_Busy());
+}
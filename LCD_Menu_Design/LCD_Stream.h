@@ -0,0 +1,82 @@
+/**
+ * @file LCD_Stream.h
+ *
+ * @brief Header file for the LCD_Stream driver.
+ *
+ * This file contains the function definitions for the LCD_Stream driver.
+ * It plays precompiled screens to the EduBase LCD in the background, from the interrupt
+ * of a GPTM one-shot timer, so that showing a static screen is a single call that
+ * returns immediately.
+ *
+ * A screen is stored in flash as a stream of codes, pre-encoded on the host by
+ * Tools/lcd_stream_gen.py (see LCD_Screens.h). Each code is either:
+ *  - 0x00 to 0x1F  A nibble written to the LCD, with the register select flag in Bit 4
+ *                  and the data lines (D7 to D4) in Bits 3 to 0
+ *  - 0x80 to 0xFF  A wait of (Bits 6 to 0) x LCD_STREAM_WAIT_UNIT_US before the next code,
+ *                  for the execution time of the previous command or data byte
+ *
+ * The EduBase_LCD functions wait for the stream in progress to end before they
+ * write to the LCD.
+ */
+
+#ifndef LCD_STREAM_H
+#define LCD_STREAM_H
+
+#include "TM4C123GH6PM.h"
+
+// Codes of a stream
+#define LCD_STREAM_NIBBLE(control_flag, nibble) ((uint8_t)((((control_flag) & 0x01) << 4) | ((nibble) & 0x0F)))
+#define LCD_STREAM_WAIT(units) ((uint8_t)(0x80 | ((units) & 0x7F)))
+#define LCD_STREAM_WAIT_UNIT_US 20
+
+// Number of streams that can wait to be played
+#define LCD_STREAM_QUEUE_SIZE 4
+
+typedef struct
+{
+	const uint8_t *codes;
+	uint16_t length;
+
+	// DDRAM address of the cursor after the stream, tracked by the EduBase_LCD driver
+	uint8_t end_address;
+} LCD_Stream;
+
+/**
+ * @brief Allocates the timer that plays the streams.
+ *
+ * The LCD must have been initialized with EduBase_LCD_Init.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void LCD_Stream_Init(void);
+
+/**
+ * @brief Queues a stream to be played after the streams already queued.
+ *
+ * @param stream A pointer to the stream, which must stay in memory until it is played.
+ *
+ * @return 1 if the stream was queued, or 0 if the queue is full.
+ */
+uint8_t LCD_Stream_Play(const LCD_Stream *stream);
+
+/**
+ * @brief Checks if a stream is being played or waits to be played.
+ *
+ * @param None
+ *
+ * @return 1 if the LCD is in use by the streams, or 0 otherwise.
+ */
+uint8_t LCD_Stream_Busy(void);
+
+/**
+ * @brief Waits until every queued stream has been played.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void LCD_Stream_Wait(void);
+
+#endif
@@ -0,0 +1,387 @@
+/**
+ * @file LED_Effects.c
+ *
+ * @brief Source code for the LED_Effects driver.
+ *
+ * This file contains the function definitions for the LED_Effects driver.
+ * It runs fades, breathing and blink patterns on the RGB LED from the
+ * PWM Module 1 Generator 3 load interrupt.
+ */
+
+#include "LED_Effects.h"
+#include "PWM.h"
+#include "Interrupt_Config.h"
+
+// Fixed-point precision of the effect progress (Q12, 4096 = 100 %)
+#define LED_PROGRESS_ONE 4096
+
+enum LED_Effect_Types
+{
+	LED_EFFECT_STATIC  = 0x00,
+	LED_EFFECT_FADE    = 0x01,
+	LED_EFFECT_BREATHE = 0x02,
+	LED_EFFECT_BLINK   = 0x03
+};
+
+typedef struct
+{
+	uint8_t effect;
+	uint8_t easing;
+	uint8_t level;
+	uint8_t from_level;
+	uint8_t to_level;
+	uint8_t blink_count;
+	uint16_t elapsed_ticks;
+	uint16_t duration_ticks;
+	uint16_t off_ticks;
+	uint16_t duty_cycle;
+} LED_Channel_State;
+
+// PWM channel driving each LED channel
+static const uint8_t led_pwm_channels[LED_NUM_CHANNELS] = { PWM_M1PWM5, PWM_M1PWM6, PWM_M1PWM7 };
+
+// Gamma 2.2 correction table stored in flash. Converts a perceptually linear
+// level (0 - 255) to a linear light output (0 - 65535)
+static const uint16_t led_gamma_table[256] =
+{
+	    0,     0,     2,     4,     7,    11,    17,    24,
+	   32,    42,    53,    65,    79,    94,   111,   129,
+	  148,   169,   192,   216,   242,   270,   299,   330,
+	  362,   396,   432,   469,   508,   549,   591,   635,
+	  681,   729,   779,   830,   883,   938,   995,  1053,
+	 1113,  1175,  1239,  1305,  1373,  1443,  1514,  1587,
+	 1663,  1740,  1819,  1900,  1983,  2068,  2155,  2243,
+	 2334,  2427,  2521,  2618,  2717,  2817,  2920,  3024,
+	 3131,  3240,  3350,  3463,  3578,  3694,  3813,  3934,
+	 4057,  4182,  4309,  4438,  4570,  4703,  4838,  4976,
+	 5115,  5257,  5401,  5547,  5695,  5845,  5998,  6152,
+	 6309,  6468,  6629,  6792,  6957,  7124,  7294,  7466,
+	 7640,  7816,  7994,  8175,  8358,  8543,  8730,  8919,
+	 9111,  9305,  9501,  9699,  9900, 10102, 10307, 10515,
+	10724, 10936, 11150, 11366, 11585, 11806, 12029, 12254,
+	12482, 12712, 12944, 13179, 13416, 13655, 13896, 14140,
+	14386, 14635, 14885, 15138, 15394, 15652, 15912, 16174,
+	16439, 16706, 16975, 17247, 17521, 17798, 18077, 18358,
+	18642, 18928, 19216, 19507, 19800, 20095, 20393, 20694,
+	20996, 21301, 21609, 21919, 22231, 22546, 22863, 23182,
+	23504, 23829, 24156, 24485, 24817, 25151, 25487, 25826,
+	26168, 26512, 26858, 27207, 27558, 27912, 28268, 28627,
+	28988, 29351, 29717, 30086, 30457, 30830, 31206, 31585,
+	31966, 32349, 32735, 33124, 33514, 33908, 34304, 34702,
+	35103, 35507, 35913, 36321, 36732, 37146, 37562, 37981,
+	38402, 38825, 39252, 39680, 40112, 40546, 40982, 41421,
+	41862, 42306, 42753, 43202, 43654, 44108, 44565, 45025,
+	45487, 45951, 46418, 46888, 47360, 47835, 48313, 48793,
+	49275, 49761, 50249, 50739, 51232, 51728, 52226, 52727,
+	53230, 53736, 54245, 54756, 55270, 55787, 56306, 56828,
+	57352, 57879, 58409, 58941, 59476, 60014, 60554, 61097,
+	61642, 62190, 62741, 63295, 63851, 64410, 64971, 65535
+};
+
+static LED_Channel_State led_channels[LED_NUM_CHANNELS];
+static uint8_t master_brightness = 255;
+static uint8_t interrupt_count = 0;
+
+static uint16_t LED_Level_To_Duty_Cycle(uint8_t level)
+{
+	// Scale the level by the master brightness, then apply the gamma correction
+	uint8_t scaled_level = (uint8_t)(((uint32_t)level * (master_brightness + 1)) >> 8);
+	return (uint16_t)(((uint32_t)led_gamma_table[scaled_level] * LED_EFFECTS_PWM_PERIOD) >> 16);
+}
+
+static uint16_t LED_Milliseconds_To_Ticks(uint16_t milliseconds)
+{
+	uint16_t ticks = milliseconds / LED_EFFECTS_TICK_MS;
+	return (ticks == 0) ? 1 : ticks;
+}
+
+static uint8_t LED_Interpolate(uint8_t from_level, uint8_t to_level, uint32_t progress, uint8_t easing)
+{
+	// Smoothstep easing: 3t^2 - 2t^3, computed in Q12
+	if (easing == LED_EASE_IN_OUT)
+	{
+		uint32_t progress_squared = (progress * progress) >> 12;
+		progress = (progress_squared * ((3 * LED_PROGRESS_ONE) - (2 * progress))) >> 12;
+	}
+	
+	return (uint8_t)(from_level + ((((int32_t)to_level - from_level) * (int32_t)progress) / LED_PROGRESS_ONE));
+}
+
+static void LED_Advance_Channel(LED_Channel_State *channel)
+{
+	switch (channel->effect)
+	{
+		case LED_EFFECT_FADE:
+		case LED_EFFECT_BREATHE:
+		{
+			channel->elapsed_ticks++;
+			uint32_t progress = ((uint32_t)channel->elapsed_ticks * LED_PROGRESS_ONE) / channel->duration_ticks;
+			channel->level = LED_Interpolate(channel->from_level, channel->to_level, progress, channel->easing);
+			
+			if (channel->elapsed_ticks >= channel->duration_ticks)
+			{
+				channel->level = channel->to_level;
+				channel->elapsed_ticks = 0;
+				
+				if (channel->effect == LED_EFFECT_FADE)
+				{
+					channel->effect = LED_EFFECT_STATIC;
+				}
+				else
+				{
+					// Breathe back in the other direction
+					channel->to_level = channel->from_level;
+					channel->from_level = channel->level;
+				}
+			}
+			break;
+		}
+		
+		case LED_EFFECT_BLINK:
+		{
+			channel->elapsed_ticks++;
+			
+			if (channel->elapsed_ticks == channel->duration_ticks)
+			{
+				channel->level = 0;
+			}
+			else if (channel->elapsed_ticks >= (channel->duration_ticks + channel->off_ticks))
+			{
+				channel->elapsed_ticks = 0;
+				
+				if ((channel->blink_count != 0) && (--channel->blink_count == 0))
+				{
+					channel->effect = LED_EFFECT_STATIC;
+				}
+				else
+				{
+					channel->level = channel->to_level;
+				}
+			}
+			break;
+		}
+		
+		default:
+		{
+			break;
+		}
+	}
+}
+
+static void LED_Apply_Duty_Cycles(void)
+{
+	PWM_Duty_Update updates[LED_NUM_CHANNELS];
+	uint8_t num_updates = 0;
+	
+	// Only write the duty cycles that changed
+	for (uint8_t i = 0; i < LED_NUM_CHANNELS; i++)
+	{
+		uint16_t duty_cycle = LED_Level_To_Duty_Cycle(led_channels[i].level);
+		
+		if (duty_cycle != led_channels[i].duty_cycle)
+		{
+			led_channels[i].duty_cycle = duty_cycle;
+			updates[num_updates].channel = led_pwm_channels[i];
+			updates[num_updates].duty_cycle = duty_cycle;
+			num_updates++;
+		}
+	}
+	
+	if (num_updates > 0)
+	{
+		PWM_Update_Duty_Cycles(updates, num_updates);
+	}
+}
+
+static void LED_Update_Interrupt(void)
+{
+	uint8_t animating = 0;
+	
+	for (uint8_t i = 0; i < LED_NUM_CHANNELS; i++)
+	{
+		if (led_channels[i].effect != LED_EFFECT_STATIC)
+		{
+			animating = 1;
+		}
+	}
+	
+	// Only take the load interrupt of PWM1_3 while an effect is running
+	// by setting or clearing the INTCNTLOAD bit (Bit 1) in the PWM3INTEN register
+	PWM1->_3_INTEN = animating ? 0x02 : 0x00;
+}
+
+// Stops the effect updates while a channel is being changed from the main loop
+static void LED_Lock(void)
+{
+	PWM1->_3_INTEN = 0x00;
+	
+	// Discard a load interrupt that was already pending in the NVIC
+	NVIC->ICPR[4] = (1 << 9);
+}
+
+static void LED_Unlock(void)
+{
+	LED_Apply_Duty_Cycles();
+	LED_Update_Interrupt();
+}
+
+void LED_Effects_Init(void)
+{
+	const PWM_Channel_Config led_pwm_config[LED_NUM_CHANNELS] =
+	{
+		{ PWM_M1PWM5, 0, LED_EFFECTS_PWM_PERIOD, 0, 0, 0 },
+		{ PWM_M1PWM6, 0, LED_EFFECTS_PWM_PERIOD, 0, 0, 0 },
+		{ PWM_M1PWM7, 0, LED_EFFECTS_PWM_PERIOD, 0, 0, 0 }
+	};
+	
+	for (uint8_t i = 0; i < LED_NUM_CHANNELS; i++)
+	{
+		led_channels[i].effect = LED_EFFECT_STATIC;
+		led_channels[i].level = 0;
+		led_channels[i].duty_cycle = 0;
+	}
+	
+	// Configure PF1, PF2 and PF3 as PWM outputs that start off,
+	// and restart the counters of Generators 2 and 3 together
+	PWM_Init_Channels(led_pwm_config, LED_NUM_CHANNELS);
+	
+	// Route the Generator 3 interrupt to the interrupt controller by setting
+	// the INTPWM3 bit (Bit 3) in the PWMINTEN register. The load interrupt itself
+	// is only enabled while an effect is running
+	PWM1->_3_INTEN = 0x00;
+	PWM1->_3_ISC = 0x02;
+	PWM1->INTEN |= 0x08;
+	
+	// Enable the PWM Module 1 Generator 3 interrupt (IRQ 137) at its level in the priority plan
+	Interrupt_Config_Enable(INTERRUPT_LED_EFFECTS);
+}
+
+void LED_Effects_Set_Level(uint8_t channel, uint8_t level)
+{
+	if (channel >= LED_NUM_CHANNELS) return;
+	
+	LED_Lock();
+	led_channels[channel].effect = LED_EFFECT_STATIC;
+	led_channels[channel].level = level;
+	LED_Unlock();
+}
+
+static void LED_Start_Fade(LED_Channel_State *state, uint8_t level, uint16_t duration_ms, uint8_t easing)
+{
+	state->effect = LED_EFFECT_FADE;
+	state->easing = easing;
+	state->from_level = state->level;
+	state->to_level = level;
+	state->elapsed_ticks = 0;
+	state->duration_ticks = LED_Milliseconds_To_Ticks(duration_ms);
+}
+
+void LED_Effects_Fade(uint8_t channel, uint8_t level, uint16_t duration_ms, uint8_t easing)
+{
+	if (channel >= LED_NUM_CHANNELS) return;
+	
+	LED_Lock();
+	LED_Start_Fade(&led_channels[channel], level, duration_ms, easing);
+	LED_Unlock();
+}
+
+void LED_Effects_Breathe(uint8_t channel, uint8_t level, uint16_t period_ms)
+{
+	if (channel >= LED_NUM_CHANNELS) return;
+	
+	LED_Lock();
+	LED_Channel_State *state = &led_channels[channel];
+	state->effect = LED_EFFECT_BREATHE;
+	state->easing = LED_EASE_IN_OUT;
+	state->level = 0;
+	state->from_level = 0;
+	state->to_level = level;
+	state->elapsed_ticks = 0;
+	state->duration_ticks = LED_Milliseconds_To_Ticks(period_ms / 2);
+	LED_Unlock();
+}
+
+void LED_Effects_Blink(uint8_t channel, uint8_t level, uint16_t on_ms, uint16_t off_ms, uint8_t count)
+{
+	if (channel >= LED_NUM_CHANNELS) return;
+	
+	LED_Lock();
+	LED_Channel_State *state = &led_channels[channel];
+	state->effect = LED_EFFECT_BLINK;
+	state->level = level;
+	state->to_level = level;
+	state->blink_count = count;
+	state->elapsed_ticks = 0;
+	state->duration_ticks = LED_Milliseconds_To_Ticks(on_ms);
+	state->off_ticks = LED_Milliseconds_To_Ticks(off_ms);
+	LED_Unlock();
+}
+
+void LED_Effects_Set_Color(uint8_t red, uint8_t green, uint8_t blue)
+{
+	LED_Lock();
+	led_channels[LED_RED].effect = LED_EFFECT_STATIC;
+	led_channels[LED_RED].level = red;
+	led_channels[LED_GREEN].effect = LED_EFFECT_STATIC;
+	led_channels[LED_GREEN].level = green;
+	led_channels[LED_BLUE].effect = LED_EFFECT_STATIC;
+	led_channels[LED_BLUE].level = blue;
+	LED_Unlock();
+}
+
+void LED_Effects_Fade_To_Color(uint8_t red, uint8_t green, uint8_t blue, uint16_t duration_ms, uint8_t easing)
+{
+	// The three fades start on the same tick since the load interrupt stays
+	// disabled until the last one has been set up
+	LED_Lock();
+	LED_Start_Fade(&led_channels[LED_RED], red, duration_ms, easing);
+	LED_Start_Fade(&led_channels[LED_GREEN], green, duration_ms, easing);
+	LED_Start_Fade(&led_channels[LED_BLUE], blue, duration_ms, easing);
+	LED_Unlock();
+}
+
+void LED_Effects_Set_Brightness(uint8_t brightness)
+{
+	LED_Lock();
+	master_brightness = brightness;
+	LED_Unlock();
+}
+
+uint8_t LED_Effects_Get_Level(uint8_t channel)
+{
+	return (channel < LED_NUM_CHANNELS) ? led_channels[channel].level : 0;
+}
+
+void LED_Effects_Claim_Pins(void)
+{
+	for (uint8_t i = 0; i < LED_NUM_CHANNELS; i++)
+	{
+		PWM_Claim_Pin(led_pwm_channels[i]);
+	}
+}
+
+void LED_Effects_Release_Pins(void)
+{
+	for (uint8_t i = 0; i < LED_NUM_CHANNELS; i++)
+	{
+		PWM_Release_Pin(led_pwm_channels[i]);
+	}
+}
+
+void PWM1_3_Handler(void)
+{
+	// Acknowledge the load interrupt by writing 1 to the INTCNTLOAD bit (Bit 1) in the PWM3ISC register
+	PWM1->_3_ISC = 0x02;
+	
+	// Advance the effects once every LED_EFFECTS_INTERRUPT_DIVIDER PWM periods
+	if (++interrupt_count < LED_EFFECTS_INTERRUPT_DIVIDER) return;
+	interrupt_count = 0;
+	
+	for (uint8_t i = 0; i < LED_NUM_CHANNELS; i++)
+	{
+		LED_Advance_Channel(&led_channels[i]);
+	}
+	
+	LED_Apply_Duty_Cycles();
+	LED_Update_Interrupt();
+}
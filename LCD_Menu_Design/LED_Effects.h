@@ -0,0 +1,210 @@
+/**
+ * @file LED_Effects.h
+ *
+ * @brief Header file for the LED_Effects driver.
+ *
+ * This file contains the function definitions for the LED_Effects driver.
+ * It animates the RGB LED of the TM4C123G LaunchPad in the background. The following pins are used:
+ *  - Red LED    (PF1, M1PWM5)
+ *  - Blue LED   (PF2, M1PWM6)
+ *  - Green LED  (PF3, M1PWM7)
+ *
+ * Each color channel runs its own effect (static level, fade, breathing or blink), so effects
+ * can be mixed across the three channels, e.g. a green flash on top of a breathing blue.
+ * Levels range from 0 to 255 and are perceptually linear: they are converted to duty cycles
+ * with a gamma 2.2 lookup table and scaled by a master brightness.
+ *
+ * The effects are computed with fixed-point math every LED_EFFECTS_TICK_MS milliseconds from
+ * the load interrupt of PWM Module 1 Generator 3, and all three duty cycles are applied on the
+ * same PWM period boundary. The interrupt is disabled while every channel holds a static level,
+ * so the LED costs no CPU time at all when it is not animated.
+ *
+ * @note This driver assumes that the system clock's frequency is 50 MHz and that the
+ * PWM_Clock_Init function has been called before calling the LED_Effects_Init function.
+ */
+
+#ifndef LED_EFFECTS_H
+#define LED_EFFECTS_H
+
+#include "TM4C123GH6PM.h"
+
+// PWM period of the LEDs in PWM clock ticks (3.125 MHz / 3125 = 1 kHz)
+#define LED_EFFECTS_PWM_PERIOD 3125
+
+// Number of PWM periods between two effect updates (1 kHz / 10 = 100 Hz)
+#define LED_EFFECTS_INTERRUPT_DIVIDER 10
+
+// Time between two effect updates in milliseconds
+#define LED_EFFECTS_TICK_MS 10
+
+enum LED_Channels
+{
+	LED_RED   = 0x00,
+	LED_BLUE  = 0x01,
+	LED_GREEN = 0x02
+};
+
+#define LED_NUM_CHANNELS 3
+
+enum LED_Easing
+{
+	LED_EASE_LINEAR   = 0x00,
+	LED_EASE_IN_OUT   = 0x01
+};
+
+/**
+ * @brief Initializes the RGB LED and the effects engine.
+ *
+ * This function configures PF1, PF2 and PF3 as PWM outputs of PWM Module 1 Generators 2 and 3
+ * with synchronized counters, turns the LEDs off, and enables the Generator 3 interrupt in the NVIC.
+ * The PWM Module 1 Generator 3 interrupt is enabled at level 6 of the priority plan (see Interrupt_Config.h).
+ *
+ * @param None
+ *
+ * @return None
+ */
+void LED_Effects_Init(void);
+
+/**
+ * @brief Sets a channel to a static level, stopping its effect.
+ *
+ * @param channel The LED channel (see LED_Channels).
+ *
+ * @param level The brightness level (0 - 255).
+ *
+ * @return None
+ */
+void LED_Effects_Set_Level(uint8_t channel, uint8_t level);
+
+/**
+ * @brief Fades a channel from its current level to a new level.
+ *
+ * @param channel The LED channel (see LED_Channels).
+ *
+ * @param level The target brightness level (0 - 255).
+ *
+ * @param duration_ms The duration of the fade in milliseconds.
+ *
+ * @param easing The easing curve of the fade (see LED_Easing).
+ *
+ * @return None
+ */
+void LED_Effects_Fade(uint8_t channel, uint8_t level, uint16_t duration_ms, uint8_t easing);
+
+/**
+ * @brief Makes a channel breathe between off and a peak level.
+ *
+ * The channel fades in and out with an ease-in-out curve until another effect is started.
+ *
+ * @param channel The LED channel (see LED_Channels).
+ *
+ * @param level The peak brightness level (0 - 255).
+ *
+ * @param period_ms The duration of one full breath in milliseconds.
+ *
+ * @return None
+ */
+void LED_Effects_Breathe(uint8_t channel, uint8_t level, uint16_t period_ms);
+
+/**
+ * @brief Makes a channel blink.
+ *
+ * @param channel The LED channel (see LED_Channels).
+ *
+ * @param level The brightness level while the LED is on (0 - 255).
+ *
+ * @param on_ms The time the LED stays on in milliseconds.
+ *
+ * @param off_ms The time the LED stays off in milliseconds.
+ *
+ * @param count The number of blinks before the channel stays off, or 0 to blink forever.
+ *
+ * @return None
+ */
+void LED_Effects_Blink(uint8_t channel, uint8_t level, uint16_t on_ms, uint16_t off_ms, uint8_t count);
+
+/**
+ * @brief Sets the three channels to a static color.
+ *
+ * @param red The level of the red LED (0 - 255).
+ *
+ * @param green The level of the green LED (0 - 255).
+ *
+ * @param blue The level of the blue LED (0 - 255).
+ *
+ * @return None
+ */
+void LED_Effects_Set_Color(uint8_t red, uint8_t green, uint8_t blue);
+
+/**
+ * @brief Fades the three channels to a color with the same duration and easing.
+ *
+ * @param red The target level of the red LED (0 - 255).
+ *
+ * @param green The target level of the green LED (0 - 255).
+ *
+ * @param blue The target level of the blue LED (0 - 255).
+ *
+ * @param duration_ms The duration of the fade in milliseconds.
+ *
+ * @param easing The easing curve of the fade (see LED_Easing).
+ *
+ * @return None
+ */
+void LED_Effects_Fade_To_Color(uint8_t red, uint8_t green, uint8_t blue, uint16_t duration_ms, uint8_t easing);
+
+/**
+ * @brief Sets the master brightness applied to all channels.
+ *
+ * @param brightness The master brightness (0 - 255).
+ *
+ * @return None
+ */
+void LED_Effects_Set_Brightness(uint8_t brightness);
+
+/**
+ * @brief Returns the current level of a channel.
+ *
+ * @param channel The LED channel (see LED_Channels).
+ *
+ * @return The current brightness level (0 - 255).
+ */
+uint8_t LED_Effects_Get_Level(uint8_t channel);
+
+/**
+ * @brief Connects PF1, PF2 and PF3 to the PWM outputs again.
+ *
+ * The effects keep running while the pins are released, so the LEDs show
+ * the current effects as soon as the pins are connected.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void LED_Effects_Claim_Pins(void);
+
+/**
+ * @brief Turns the LEDs off and gives PF1, PF2 and PF3 back to GPIO.
+ *
+ * This function is used when another driver needs the pins (e.g. the Stepper_Motor driver
+ * uses PF2 and PF3). The pins are left as low outputs.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void LED_Effects_Release_Pins(void);
+
+/**
+ * @brief The interrupt service routine (ISR) for PWM Module 1 Generator 3.
+ *
+ * This function advances the effects every LED_EFFECTS_INTERRUPT_DIVIDER PWM periods and
+ * updates the duty cycles that changed. The interrupt disables itself once every channel is static.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void PWM1_3_Handler(void);
+
+#endif
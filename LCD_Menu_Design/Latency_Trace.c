@@ -0,0 +1,193 @@
+/**
+ * @file Latency_Trace.c
+ *
+ * @brief Source code for the Latency_Trace module.
+ *
+ * This file contains the function definitions for the Latency_Trace module.
+ * The spans are timed with the DWT cycle counter, which wraps after 85 seconds at 50 MHz,
+ * and the histograms count in 16 bits: when a bucket is full, every bucket of its stage
+ * is halved, which keeps the shape of the distribution.
+ */
+
+#include "Latency_Trace.h"
+#include "Trace_Recorder.h"
+
+static const char *const stage_names[LATENCY_NUM_STAGES] = {
+	"debounce", "queue", "decode", "display", "total"
+};
+
+typedef struct
+{
+	uint32_t count;
+	uint32_t max_us;
+	uint16_t buckets[LATENCY_BUCKETS];
+} Latency_Histogram;
+
+static Latency_Histogram histograms[LATENCY_NUM_STAGES];
+
+static uint32_t cycles_per_us = 1;
+
+// Cycle counts of the open span, which is open while span_open is set
+static uint8_t span_open = 0;
+static uint8_t span_decoded = 0;
+static uint8_t span_source = 0;
+static uint32_t span_edge = 0;
+static uint32_t span_queued = 0;
+static uint32_t span_handled = 0;
+static uint32_t span_decode = 0;
+
+// Bucket of a latency: the values below LATENCY_SUB_BUCKETS have their own bucket, and
+// each power of two above is split into LATENCY_SUB_BUCKETS buckets of equal width,
+// selected by the LATENCY_SUB_BUCKET_BITS bits below the leading one
+static uint8_t Latency_Bucket(uint32_t us)
+{
+	if (us < LATENCY_SUB_BUCKETS) return (uint8_t)us;
+
+	uint32_t shift = (31 - __CLZ(us)) - LATENCY_SUB_BUCKET_BITS;
+	uint32_t bucket = ((shift + 1) * LATENCY_SUB_BUCKETS) + ((us >> shift) & (LATENCY_SUB_BUCKETS - 1));
+
+	return (bucket < LATENCY_BUCKETS) ? (uint8_t)bucket : (LATENCY_BUCKETS - 1);
+}
+
+// Largest latency of a bucket
+static uint32_t Latency_Bucket_Limit(uint8_t bucket)
+{
+	if (bucket < LATENCY_SUB_BUCKETS) return bucket;
+
+	uint32_t shift = (bucket / LATENCY_SUB_BUCKETS) - 1;
+	uint32_t sub_bucket = bucket % LATENCY_SUB_BUCKETS;
+
+	return ((LATENCY_SUB_BUCKETS + sub_bucket + 1) << shift) - 1;
+}
+
+static void Latency_Record(uint8_t stage, uint32_t cycles)
+{
+	Latency_Histogram *histogram = &histograms[stage];
+	uint32_t us = cycles / cycles_per_us;
+	uint8_t bucket = Latency_Bucket(us);
+
+	if (histogram->buckets[bucket] == 0xFFFF)
+	{
+		for (uint8_t i = 0; i < LATENCY_BUCKETS; i++)
+		{
+			histogram->buckets[i] = (uint16_t)((histogram->buckets[i] + 1) / 2);
+		}
+	}
+
+	histogram->buckets[bucket]++;
+	histogram->count++;
+
+	if (us > histogram->max_us)
+	{
+		histogram->max_us = us;
+	}
+}
+
+void Latency_Trace_Reset(void)
+{
+	cycles_per_us = SystemCoreClock / 1000000;
+
+	for (uint8_t stage = 0; stage < LATENCY_NUM_STAGES; stage++)
+	{
+		histograms[stage].count = 0;
+		histograms[stage].max_us = 0;
+
+		for (uint8_t i = 0; i < LATENCY_BUCKETS; i++)
+		{
+			histograms[stage].buckets[i] = 0;
+		}
+	}
+
+	span_open = 0;
+}
+
+void Latency_Trace_Begin(const Input_Event *event)
+{
+	span_edge = event->edge_cycles;
+	span_queued = event->queued_cycles;
+	span_handled = DWT->CYCCNT;
+	span_source = event->source;
+	span_decoded = 0;
+	span_open = 1;
+}
+
+void Latency_Trace_Decoded(void)
+{
+	if (!span_open) return;
+
+	span_decode = DWT->CYCCNT;
+	span_decoded = 1;
+}
+
+void Latency_Trace_Displayed(void)
+{
+	if (!span_open || !span_decoded) return;
+
+	uint32_t displayed = DWT->CYCCNT;
+
+	Latency_Record(LATENCY_STAGE_DEBOUNCE, span_queued - span_edge);
+	Latency_Record(LATENCY_STAGE_QUEUE, span_handled - span_queued);
+	Latency_Record(LATENCY_STAGE_DECODE, span_decode - span_handled);
+	Latency_Record(LATENCY_STAGE_DISPLAY, displayed - span_decode);
+	Latency_Record(LATENCY_STAGE_TOTAL, displayed - span_edge);
+
+	// Show the span on the trace timeline, in milliseconds
+	uint32_t total_ms = (displayed - span_edge) / (cycles_per_us * 1000);
+	TRACE_LATENCY_SPAN(span_source, (total_ms < 0xFFFF) ? total_ms : 0xFFFF);
+
+	span_open = 0;
+}
+
+uint8_t Latency_Trace_Stats(uint8_t stage, Latency_Stats *stats)
+{
+	if (stage >= LATENCY_NUM_STAGES) return 0;
+
+	const Latency_Histogram *histogram = &histograms[stage];
+	uint32_t total = 0;
+
+	for (uint8_t i = 0; i < LATENCY_BUCKETS; i++)
+	{
+		total += histogram->buckets[i];
+	}
+
+	// Smallest number of samples at or below each percentile
+	uint32_t p50_rank = (total + 1) / 2;
+	uint32_t p99_rank = ((total * 99) + 99) / 100;
+	uint32_t cumulative = 0;
+	uint8_t p50_found = 0;
+
+	stats->count = histogram->count;
+	stats->max_us = histogram->max_us;
+	stats->p50_us = 0;
+	stats->p99_us = 0;
+
+	for (uint8_t i = 0; (i < LATENCY_BUCKETS) && (cumulative < p99_rank); i++)
+	{
+		uint32_t limit = Latency_Bucket_Limit(i);
+
+		if (limit > histogram->max_us)
+		{
+			limit = histogram->max_us;
+		}
+
+		cumulative += histogram->buckets[i];
+
+		if (!p50_found && (cumulative >= p50_rank))
+		{
+			stats->p50_us = limit;
+			p50_found = 1;
+		}
+
+		if (cumulative >= p99_rank)
+		{
+			stats->p99_us = limit;
+		}
+	}
+
+	return 1;
+}
+
+const char *Latency_Trace_Stage_Name(uint8_t stage)
+{
+	return (stage < LATENCY_NUM_STAGES) ? stage_names[stage] : 0;
+}
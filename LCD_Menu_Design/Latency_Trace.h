@@ -0,0 +1,127 @@
+/**
+ * @file Latency_Trace.h
+ *
+ * @brief Header file for the Latency_Trace module.
+ *
+ * This file contains the function definitions for the Latency_Trace module.
+ * It measures how long an input takes to become visible on the LCD, from the edge that
+ * woke the button interrupt to the end of the LCD write that shows the decoded character.
+ *
+ * Every input event carries the DWT cycle counts of its edge and of its queueing (see
+ * Input_Event). A handler that feeds the decoder opens a span with Latency_Trace_Begin,
+ * and the decoder marks the span with Latency_Trace_Decoded and Latency_Trace_Displayed.
+ * A span that is not displayed is replaced by the next one, and a character decoded after
+ * the character pause is measured from the last key event, so the pause is part of its span.
+ *
+ * A displayed span is split into stages, and each stage has its own histogram:
+ *  - LATENCY_STAGE_DEBOUNCE  Edge to queued event (debouncing and gesture detection)
+ *  - LATENCY_STAGE_QUEUE     Queued event to its handler (main loop delay)
+ *  - LATENCY_STAGE_DECODE    Handler to decoded character (including the character pause)
+ *  - LATENCY_STAGE_DISPLAY   Decoded character to the end of the LCD write
+ *  - LATENCY_STAGE_TOTAL     Edge to the end of the LCD write
+ *
+ * The histograms have LATENCY_SUB_BUCKETS buckets per power of two of microseconds,
+ * so a percentile is known within 1 / LATENCY_SUB_BUCKETS of its value (25% with the
+ * default of 4) in a few hundred bytes of RAM.
+ */
+
+#ifndef LATENCY_TRACE_H
+#define LATENCY_TRACE_H
+
+#include "TM4C123GH6PM.h"
+#include "Input_Event.h"
+
+// Buckets per power of two (2^LATENCY_SUB_BUCKET_BITS), and number of buckets
+// (up to 2^24 us, about 16 seconds)
+#define LATENCY_SUB_BUCKET_BITS 2
+#define LATENCY_SUB_BUCKETS (1 << LATENCY_SUB_BUCKET_BITS)
+#define LATENCY_BUCKETS ((25 - LATENCY_SUB_BUCKET_BITS) * LATENCY_SUB_BUCKETS)
+
+// The buckets are indexed with 8 bits
+#if LATENCY_BUCKETS > 255
+#error "LATENCY_SUB_BUCKET_BITS must be 3 or less"
+#endif
+
+enum Latency_Stages
+{
+	LATENCY_STAGE_DEBOUNCE  = 0x00,
+	LATENCY_STAGE_QUEUE     = 0x01,
+	LATENCY_STAGE_DECODE    = 0x02,
+	LATENCY_STAGE_DISPLAY   = 0x03,
+	LATENCY_STAGE_TOTAL     = 0x04,
+	LATENCY_NUM_STAGES      = 0x05
+};
+
+typedef struct
+{
+	// Number of displayed spans, median, 99th percentile and longest latency in microseconds
+	uint32_t count;
+	uint32_t p50_us;
+	uint32_t p99_us;
+	uint32_t max_us;
+} Latency_Stats;
+
+/**
+ * @brief Clears the histograms and closes the open span.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Latency_Trace_Reset(void);
+
+/**
+ * @brief Opens a span for an input event that is handled by the decoder.
+ *
+ * This function is called by the event handler, from the main loop.
+ *
+ * @param event A pointer to the event.
+ *
+ * @return None
+ */
+void Latency_Trace_Begin(const Input_Event *event);
+
+/**
+ * @brief Marks the open span as decoded.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Latency_Trace_Decoded(void);
+
+/**
+ * @brief Closes the open span once its character has been written to the LCD,
+ *        and adds its stages to the histograms.
+ *
+ * The span is ignored if it has not been marked as decoded.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Latency_Trace_Displayed(void);
+
+/**
+ * @brief Computes the statistics of a stage.
+ *
+ * The percentiles are rounded up to the end of their bucket, and never exceed the maximum.
+ *
+ * @param stage The stage (see Latency_Stages).
+ *
+ * @param stats A pointer to where the statistics are stored.
+ *
+ * @return 1 if the statistics were computed, or 0 if the stage is out of range.
+ */
+uint8_t Latency_Trace_Stats(uint8_t stage, Latency_Stats *stats);
+
+/**
+ * @brief Returns the name of a stage.
+ *
+ * @param stage The stage (see Latency_Stages).
+ *
+ * @return The name of the stage, or 0 if the stage is out of range.
+ */
+const char *Latency_Trace_Stage_Name(uint8_t stage);
+
+#endif
@@ -1,4 +1,5 @@
 #include "MorseDecoder.h"
+#include "Trace_Recorder.h"
 #include <string.h>
 
 // Morse code lookup table
@@ -11,6 +12,11 @@ const char* morse_table[36] = {
 
 const char char_table[36] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
 
+// Runtime timing thresholds (6 WPM gives a 200 ms dot)
+MorseDecoder_Timing Morse_Timing = {
+    DOT_THRESHOLD, DASH_THRESHOLD, CHAR_PAUSE, WORD_PAUSE, 6
+};
+
 // Buffer to store Morse input
 static char morse_input[10] = {0};
 static uint8_t morse_index = 0;
@@ -21,15 +27,18 @@ char MorseDecoder_Decode(void) {
     for (int i = 0; i < 36; i++) {
         if (strcmp(morse_input, morse_table[i]) == 0) {
             morse_index = 0;  // Reset the input buffer
+            TRACE_MORSE_DECODED(char_table[i]);
             return char_table[i];
         }
     }
     morse_index = 0;  // Reset the input buffer
+    TRACE_MORSE_DECODED('?');
     return '?';       // Return '?' for invalid Morse input
 }
 
 // Add a symbol ('.' or '-') to the Morse input buffer
 void MorseDecoder_AddSymbol(char symbol) {
+    TRACE_MORSE_SYMBOL(symbol);
     if (morse_index < sizeof(morse_input) - 1) {
         morse_input[morse_index++] = symbol;
     }
@@ -39,4 +48,18 @@ void MorseDecoder_AddSymbol(char symbol) {
 void MorseDecoder_Clear(void) {
     morse_index = 0;
     morse_input[0] = '\0';
+}
+
+// Derive the timing thresholds from the keying speed
+// One dot lasts (1200 / WPM) ms, a dash 3 dots, a character gap 3 dots and a word gap 7 dots
+void MorseDecoder_Set_WPM(int32_t wpm) {
+    if (wpm < 1) return;
+
+    int32_t dot_ms = 1200 / wpm;
+
+    Morse_Timing.wpm = wpm;
+    Morse_Timing.dot_threshold = dot_ms;
+    Morse_Timing.dash_threshold = 3 * dot_ms;
+    Morse_Timing.char_pause = 4 * dot_ms;
+    Morse_Timing.word_pause = 10 * dot_ms;
 }
\ No newline at end of file
@@ -1,8 +1,36 @@
-#include "TM4C123GH6PM.h"
+#ifndef MORSEDECODER_H
+#define MORSEDECODER_H
+
 #include <stdint.h>
 
+// Default Morse timing thresholds (in ms)
+#define DOT_THRESHOLD 200
+#define DASH_THRESHOLD 600
+#define CHAR_PAUSE 800
+#define WORD_PAUSE 2000
+
+// Runtime Morse timing thresholds (in ms), initialized to the defaults above
+typedef struct {
+    int32_t dot_threshold;
+    int32_t dash_threshold;
+    int32_t char_pause;
+    int32_t word_pause;
+    int32_t wpm;
+} MorseDecoder_Timing;
+
+extern MorseDecoder_Timing Morse_Timing;
+
+// Morse code patterns of the decoded characters, in the order of char_table
+extern const char* morse_table[36];
+extern const char char_table[36];
+
 char MorseDecoder_Decode(void);
 
 void MorseDecoder_AddSymbol(char symbol);
 
-void MorseDecorder_Clear(void);
\ No newline at end of file
+void MorseDecoder_Clear(void);
+
+// Derive the timing thresholds from a keying speed in words per minute (PARIS standard)
+void MorseDecoder_Set_WPM(int32_t wpm);
+
+#endif
@@ -0,0 +1,435 @@
+/**
+ * @file Morse_Classifier.c
+ *
+ * @brief Source code for the Morse_Classifier driver.
+ *
+ * This file contains the function definitions for the Morse_Classifier driver.
+ * The adaptive estimates are kept in units of 1/16 ms.
+ */
+
+#include "Morse_Classifier.h"
+#include <string.h>
+
+// Fractional bits of the adaptive estimates
+#define ESTIMATE_Q 4
+
+// Adaptation rates (as right shifts) of the estimate of a decided mark, of the
+// other estimate towards the 1:3 dot to dash ratio, and of the estimates for spaces
+#define MARK_RATE_SHIFT 2
+#define RATIO_RATE_SHIFT 4
+#define SPACE_RATE_SHIFT 3
+
+// Slowest and fastest speeds that the adaptive estimates can follow (in ms per dot)
+#define MAX_DOT_MS 1200
+#define MIN_DOT_MS 20
+
+// Longest pattern of the Morse table
+#define MAX_PATTERN_LENGTH 5
+
+// Largest distance of a single element, so that the cost of a whole group cannot overflow
+#define MAX_DISTANCE 0x00FFFFFF
+#define NO_PATH UINT32_MAX
+
+static const MorseDecoder_Timing *classifier_timing = 0;
+static void (*classifier_handler)(uint8_t event, uint32_t timestamp_ms) = 0;
+static uint8_t classifier_mode = MORSE_CLASSIFIER_FIXED;
+
+static uint8_t key_state = 0;
+static uint32_t edge_time = 0;
+
+// Set while a character or a word has elements that have not been ended yet
+static uint8_t character_pending = 0;
+static uint8_t word_pending = 0;
+
+// Adaptive dot and dash estimates (Q4 ms)
+static int32_t dot_estimate = 0;
+static int32_t dash_estimate = 0;
+
+// Shortest and longest marks seen until both a dot and a dash have been keyed
+static uint8_t speed_acquired = 0;
+static uint16_t shortest_mark = 0;
+static uint16_t longest_mark = 0;
+
+// Marks of the current group, the spaces between them, and their symbols as reported while keying
+static uint16_t mark_durations[MORSE_MAX_ELEMENTS];
+static uint16_t space_durations[MORSE_MAX_ELEMENTS];
+static char mark_symbols[MORSE_MAX_ELEMENTS + 1];
+static uint8_t mark_count = 0;
+
+// Distances of the marks and spaces of the group to the dot and dash estimates
+static uint32_t dot_distances[MORSE_MAX_ELEMENTS];
+static uint32_t dash_distances[MORSE_MAX_ELEMENTS];
+static uint32_t element_space_distances[MORSE_MAX_ELEMENTS];
+static uint32_t character_space_distances[MORSE_MAX_ELEMENTS];
+
+// Pattern of the character reported by the last MORSE_EVENT_CHARACTER_END
+static char pattern[MORSE_MAX_ELEMENTS + 1];
+
+volatile uint32_t Morse_Classifier_WPM = 0;
+
+// Relative distance between a duration and an estimate, (d - c)^2 / (d * c) in Q8.
+// The distance is the same for a duration r times longer or r times shorter than the estimate.
+static uint32_t Classifier_Distance(int32_t duration_ms, int32_t estimate_q4)
+{
+	int32_t estimate_ms = estimate_q4 >> ESTIMATE_Q;
+	int64_t difference = duration_ms - estimate_ms;
+
+	if (duration_ms < 1) duration_ms = 1;
+
+	uint64_t distance = ((uint64_t)(difference * difference) << 8) / ((uint64_t)duration_ms * (uint64_t)estimate_ms);
+
+	return (distance > MAX_DISTANCE) ? MAX_DISTANCE : (uint32_t)distance;
+}
+
+// Length of a dot in ms
+static int32_t Classifier_Unit(void)
+{
+	if (classifier_mode == MORSE_CLASSIFIER_ADAPTIVE)
+	{
+		// Average of the dot estimate and a third of the dash estimate
+		return (dot_estimate + (dash_estimate / 3)) >> (ESTIMATE_Q + 1);
+	}
+
+	return classifier_timing->dot_threshold;
+}
+
+// Shortest space that ends a character, in ms
+static int32_t Classifier_Character_Space(void)
+{
+	if (classifier_mode == MORSE_CLASSIFIER_ADAPTIVE)
+	{
+		// Halfway between the 1-dot element space and the 3-dot character space
+		return 2 * Classifier_Unit();
+	}
+
+	return (classifier_timing->dot_threshold + classifier_timing->dash_threshold) / 2;
+}
+
+// Shortest space that ends a word, in ms
+static int32_t Classifier_Word_Space(void)
+{
+	if (classifier_mode == MORSE_CLASSIFIER_ADAPTIVE)
+	{
+		// Halfway between the 3-dot character space and the 7-dot word space
+		return 5 * Classifier_Unit();
+	}
+
+	return classifier_timing->dash_threshold + (2 * classifier_timing->dot_threshold);
+}
+
+static void Classifier_Limit_Estimates(void)
+{
+	if (dot_estimate < (MIN_DOT_MS << ESTIMATE_Q)) dot_estimate = MIN_DOT_MS << ESTIMATE_Q;
+	if (dot_estimate > (MAX_DOT_MS << ESTIMATE_Q)) dot_estimate = MAX_DOT_MS << ESTIMATE_Q;
+
+	// Keep the dash between 2 and 5 dots so that the clusters cannot merge or swap
+	if (dash_estimate < (2 * dot_estimate)) dash_estimate = 2 * dot_estimate;
+	if (dash_estimate > (5 * dot_estimate)) dash_estimate = 5 * dot_estimate;
+
+	Morse_Classifier_WPM = 1200 / (uint32_t)Classifier_Unit();
+}
+
+static void Classifier_Adapt_Mark(int32_t duration_ms, char symbol)
+{
+	int32_t duration_q4 = duration_ms << ESTIMATE_Q;
+
+	if (symbol == '.')
+	{
+		dot_estimate += (duration_q4 - dot_estimate) >> MARK_RATE_SHIFT;
+		dash_estimate += ((3 * dot_estimate) - dash_estimate) >> RATIO_RATE_SHIFT;
+	}
+	else
+	{
+		dash_estimate += (duration_q4 - dash_estimate) >> MARK_RATE_SHIFT;
+		dot_estimate += ((dash_estimate / 3) - dot_estimate) >> RATIO_RATE_SHIFT;
+	}
+
+	Classifier_Limit_Estimates();
+}
+
+static void Classifier_Adapt_Space(int32_t duration_ms, uint8_t character_space)
+{
+	// An element space lasts a dot, and a character space lasts as long as a dash
+	if (character_space)
+	{
+		dash_estimate += ((duration_ms << ESTIMATE_Q) - dash_estimate) >> SPACE_RATE_SHIFT;
+	}
+	else
+	{
+		dot_estimate += ((duration_ms << ESTIMATE_Q) - dot_estimate) >> SPACE_RATE_SHIFT;
+	}
+
+	Classifier_Limit_Estimates();
+}
+
+// Jumps to the keying speed as soon as the marks seen so far contain both dots and dashes,
+// instead of waiting for the estimates to converge from the configured speed
+static void Classifier_Acquire(int32_t duration_ms)
+{
+	if (duration_ms < shortest_mark) shortest_mark = (uint16_t)duration_ms;
+	if (duration_ms > longest_mark) longest_mark = (uint16_t)duration_ms;
+
+	if (longest_mark >= (2 * shortest_mark))
+	{
+		dot_estimate = (int32_t)shortest_mark << ESTIMATE_Q;
+		dash_estimate = (int32_t)longest_mark << ESTIMATE_Q;
+		speed_acquired = 1;
+
+		Classifier_Limit_Estimates();
+	}
+}
+
+static char Classifier_Nearest_Symbol(int32_t duration_ms)
+{
+	return (Classifier_Distance(duration_ms, dot_estimate) <= Classifier_Distance(duration_ms, dash_estimate)) ? '.' : '-';
+}
+
+// Finds the pattern of the Morse table closest to marks [first, first + length)
+static uint32_t Classifier_Best_Pattern(uint8_t first, uint8_t length, int8_t *best)
+{
+	uint32_t best_cost = NO_PATH;
+	*best = -1;
+
+	if (length > MAX_PATTERN_LENGTH) return NO_PATH;
+
+	for (uint8_t i = 0; i < 36; i++)
+	{
+		const char *candidate = morse_table[i];
+
+		if (strlen(candidate) != length) continue;
+
+		uint32_t cost = 0;
+
+		for (uint8_t j = 0; j < length; j++)
+		{
+			cost += (candidate[j] == '.') ? dot_distances[first + j] : dash_distances[first + j];
+		}
+
+		if (cost < best_cost)
+		{
+			best_cost = cost;
+			*best = (int8_t)i;
+		}
+	}
+
+	return best_cost;
+}
+
+// Reports the characters of the group of marks that has just ended
+static void Classifier_End_Group(uint32_t timestamp_ms)
+{
+	if (classifier_mode != MORSE_CLASSIFIER_ADAPTIVE)
+	{
+		mark_symbols[mark_count] = '\0';
+		strcpy(pattern, mark_symbols);
+		classifier_handler(MORSE_EVENT_CHARACTER_END, timestamp_ms);
+		return;
+	}
+
+	// Viterbi search over the ways of splitting the group into characters. Each space between
+	// two marks is either an element space or a character space that was keyed too short, and
+	// each character is the closest pattern of the Morse table. cost[n] is the lowest cost of
+	// the first n marks, reached by a last character that starts at mark start[n].
+	uint32_t cost[MORSE_MAX_ELEMENTS + 1];
+	uint8_t start[MORSE_MAX_ELEMENTS + 1];
+	int8_t character[MORSE_MAX_ELEMENTS + 1];
+
+	for (uint8_t i = 0; i < mark_count; i++)
+	{
+		dot_distances[i] = Classifier_Distance(mark_durations[i], dot_estimate);
+		dash_distances[i] = Classifier_Distance(mark_durations[i], dash_estimate);
+		element_space_distances[i] = Classifier_Distance(space_durations[i], dot_estimate);
+		character_space_distances[i] = Classifier_Distance(space_durations[i], dash_estimate);
+	}
+
+	cost[0] = 0;
+
+	for (uint8_t end = 1; end <= mark_count; end++)
+	{
+		cost[end] = NO_PATH;
+
+		uint32_t element_spaces = 0;
+
+		for (uint8_t length = 1; (length <= end) && (length <= MAX_PATTERN_LENGTH); length++)
+		{
+			uint8_t first = end - length;
+
+			// Spaces inside the character
+			if (length > 1)
+			{
+				element_spaces += element_space_distances[first];
+			}
+
+			if (cost[first] == NO_PATH) continue;
+
+			int8_t best;
+			uint32_t total = Classifier_Best_Pattern(first, length, &best);
+
+			if (total == NO_PATH) continue;
+
+			total += cost[first] + element_spaces;
+
+			// Space before the character
+			if (first > 0)
+			{
+				total += character_space_distances[first - 1];
+			}
+
+			if (total < cost[end])
+			{
+				cost[end] = total;
+				start[end] = first;
+				character[end] = best;
+			}
+		}
+	}
+
+	if (cost[mark_count] == NO_PATH)
+	{
+		// No split fits the table, so report the symbols as keyed
+		mark_symbols[mark_count] = '\0';
+		strcpy(pattern, mark_symbols);
+		classifier_handler(MORSE_EVENT_CHARACTER_END, timestamp_ms);
+		return;
+	}
+
+	// Trace the best path back to find the first mark of each character
+	uint8_t boundaries[MORSE_MAX_ELEMENTS + 1];
+	uint8_t num_characters = 0;
+
+	for (uint8_t end = mark_count; end > 0; end = start[end])
+	{
+		boundaries[num_characters++] = end;
+	}
+
+	// Learn from the decisions, then report the characters in order
+	for (uint8_t n = num_characters; n > 0; n--)
+	{
+		uint8_t end = boundaries[n - 1];
+		uint8_t first = start[end];
+		const char *decided = morse_table[character[end]];
+
+		for (uint8_t j = 0; j < (end - first); j++)
+		{
+			Classifier_Adapt_Mark(mark_durations[first + j], decided[j]);
+
+			if ((first + j + 1) < mark_count)
+			{
+				Classifier_Adapt_Space(space_durations[first + j], (first + j + 1) == end);
+			}
+		}
+
+		strcpy(pattern, decided);
+		classifier_handler(MORSE_EVENT_CHARACTER_END, timestamp_ms);
+	}
+}
+
+void Morse_Classifier_Init(const MorseDecoder_Timing *timing, void (*handler)(uint8_t event, uint32_t timestamp_ms))
+{
+	classifier_timing = timing;
+	classifier_handler = handler;
+	key_state = 0;
+	character_pending = 0;
+	word_pending = 0;
+	mark_count = 0;
+	pattern[0] = '\0';
+
+	Morse_Classifier_Set_Mode(MORSE_CLASSIFIER_FIXED);
+}
+
+void Morse_Classifier_Set_Mode(uint8_t mode)
+{
+	classifier_mode = mode;
+
+	// Start the estimates from the configured speed
+	dot_estimate = classifier_timing->dot_threshold << ESTIMATE_Q;
+	dash_estimate = classifier_timing->dash_threshold << ESTIMATE_Q;
+	Classifier_Limit_Estimates();
+
+	speed_acquired = 0;
+	shortest_mark = 0xFFFF;
+	longest_mark = 0;
+}
+
+void Morse_Classifier_Key(uint8_t key_down, uint32_t timestamp_ms)
+{
+	if (key_down == key_state) return;
+
+	int32_t duration = (int32_t)(timestamp_ms - edge_time);
+
+	if (duration > 0xFFFF)
+	{
+		duration = 0xFFFF;
+	}
+
+	if (key_down)
+	{
+		// End the character or the word before the next mark starts
+		Morse_Classifier_Process(timestamp_ms);
+
+		// Keep the space that follows the last mark of the group
+		if (character_pending && (mark_count > 0))
+		{
+			space_durations[mark_count - 1] = (uint16_t)duration;
+		}
+	}
+	else if (duration >= (Classifier_Unit() / 4))
+	{
+		char symbol;
+
+		if (classifier_mode == MORSE_CLASSIFIER_ADAPTIVE)
+		{
+			if (!speed_acquired)
+			{
+				Classifier_Acquire(duration);
+			}
+
+			symbol = Classifier_Nearest_Symbol(duration);
+		}
+		else
+		{
+			// Split the marks halfway between a dot and a dash
+			symbol = (duration < ((classifier_timing->dot_threshold + classifier_timing->dash_threshold) / 2)) ? '.' : '-';
+		}
+
+		if (mark_count < MORSE_MAX_ELEMENTS)
+		{
+			mark_durations[mark_count] = (uint16_t)duration;
+			mark_symbols[mark_count] = symbol;
+			mark_count++;
+		}
+
+		character_pending = 1;
+		classifier_handler((symbol == '.') ? MORSE_EVENT_DOT : MORSE_EVENT_DASH, timestamp_ms);
+	}
+
+	key_state = key_down;
+	edge_time = timestamp_ms;
+}
+
+void Morse_Classifier_Process(uint32_t now_ms)
+{
+	if (key_state) return;
+
+	int32_t space = (int32_t)(now_ms - edge_time);
+
+	if (character_pending && (space >= Classifier_Character_Space()))
+	{
+		character_pending = 0;
+		word_pending = 1;
+
+		Classifier_End_Group(now_ms);
+		mark_count = 0;
+	}
+
+	if (word_pending && (space >= Classifier_Word_Space()))
+	{
+		word_pending = 0;
+		classifier_handler(MORSE_EVENT_WORD_END, now_ms);
+	}
+}
+
+const char *Morse_Classifier_Pattern(void)
+{
+	return pattern;
+}
@@ -0,0 +1,120 @@
+/**
+ * @file Morse_Classifier.h
+ *
+ * @brief Header file for the Morse_Classifier driver.
+ *
+ * This file contains the function definitions for the Morse_Classifier driver.
+ * It turns the key-down and key-up times of a single Morse key (e.g. a detected
+ * audio tone) into dots, dashes, character ends and word ends.
+ *
+ * The durations are measured against the dot length of the runtime timing
+ * thresholds (Morse_Timing), with the standard Morse ratios:
+ *  - A mark shorter than 2 dots is a dot, and a longer mark is a dash
+ *  - A space of 2 dots or more ends the character
+ *  - A space of 5 dots or more ends the word
+ *
+ * Marks shorter than a quarter of a dot are ignored as glitches.
+ *
+ * In the MORSE_CLASSIFIER_ADAPTIVE mode, the classifier does not rely on the configured speed.
+ * It keeps running estimates of the dot and dash lengths, which are the centers of two clusters
+ * of mark durations, and updates the cluster of every new mark and element space in fixed point.
+ * A mark belongs to the cluster with the smaller relative distance (d - c)^2 / (d * c), so the
+ * dot/dash split follows the geometric mean of the two estimates as the keying speed changes.
+ * When a character ends, its mark durations are scored against every pattern of the Morse table
+ * with the same number of marks, and the pattern with the lowest total distance is reported, so
+ * a mark that was misclassified on its own is corrected when it makes the character invalid.
+ * Since a character space keyed too short would merge two characters, the end of a group of marks
+ * also searches, with a Viterbi recursion, for the most likely split of the group into characters,
+ * so MORSE_CLASSIFIER_CHARACTER_END can be reported several times for one group.
+ * The work per group is bounded by MORSE_MAX_ELEMENTS and the size of the Morse table, and only
+ * uses integer additions once the distances of the elements have been computed.
+ *
+ * The classifier does not depend on the hardware, so it can be built and tested on the host.
+ */
+
+#ifndef MORSE_CLASSIFIER_H
+#define MORSE_CLASSIFIER_H
+
+#include <stdint.h>
+#include "MorseDecoder.h"
+
+// Maximum number of marks kept for a character
+#define MORSE_MAX_ELEMENTS 10
+
+// Keying speed estimated by the MORSE_CLASSIFIER_ADAPTIVE mode, in words per minute
+extern volatile uint32_t Morse_Classifier_WPM;
+
+enum Morse_Classifier_Modes
+{
+	MORSE_CLASSIFIER_FIXED     = 0x00,
+	MORSE_CLASSIFIER_ADAPTIVE  = 0x01
+};
+
+enum Morse_Classifier_Events
+{
+	MORSE_EVENT_DOT            = 0x01,
+	MORSE_EVENT_DASH           = 0x02,
+	MORSE_EVENT_CHARACTER_END  = 0x03,
+	MORSE_EVENT_WORD_END       = 0x04
+};
+
+/**
+ * @brief Initializes the classifier in the MORSE_CLASSIFIER_FIXED mode.
+ *
+ * @param timing A pointer to the timing thresholds (only read, so they can be changed at any time).
+ *
+ * @param handler A pointer to the function called for every classified element,
+ *                with the event (see Morse_Classifier_Events) and the time at which it was recognized.
+ *
+ * @return None
+ */
+void Morse_Classifier_Init(const MorseDecoder_Timing *timing, void (*handler)(uint8_t event, uint32_t timestamp_ms));
+
+/**
+ * @brief Selects how the marks and spaces are classified.
+ *
+ * Selecting the MORSE_CLASSIFIER_ADAPTIVE mode starts its estimates from the timing thresholds.
+ *
+ * @param mode The classification mode (see Morse_Classifier_Modes).
+ *
+ * @return None
+ */
+void Morse_Classifier_Set_Mode(uint8_t mode);
+
+/**
+ * @brief Reports a change of the key state.
+ *
+ * @param key_down 1 when the key goes down (tone on), or 0 when it goes up (tone off).
+ *
+ * @param timestamp_ms The time of the change in milliseconds.
+ *
+ * @return None
+ */
+void Morse_Classifier_Key(uint8_t key_down, uint32_t timestamp_ms);
+
+/**
+ * @brief Reports the character and word ends of the current space.
+ *
+ * This function must be called periodically, e.g. from the main loop, since
+ * the end of a character is only known once the key has stayed up long enough.
+ *
+ * @param now_ms The current time in milliseconds.
+ *
+ * @return None
+ */
+void Morse_Classifier_Process(uint32_t now_ms);
+
+/**
+ * @brief Returns the most likely pattern of the character that has just ended.
+ *
+ * This function can be called by the handler of MORSE_EVENT_CHARACTER_END. In the
+ * MORSE_CLASSIFIER_ADAPTIVE mode, the pattern can differ from the dots and dashes
+ * reported while the character was being keyed.
+ *
+ * @param None
+ *
+ * @return The pattern of dots and dashes as a null-terminated string.
+ */
+const char *Morse_Classifier_Pattern(void);
+
+#endif
@@ -0,0 +1,183 @@
+/**
+ * @file Motor_Control.c
+ *
+ * @brief Source code for the Motor_Control driver.
+ *
+ * This file contains the function definitions for the Motor_Control driver.
+ * It ramps the pulse width of the PB6 (M0PWM0) output from the PWM0_0 load interrupt.
+ */
+
+#include "Motor_Control.h"
+#include "PWM.h"
+#include "Interrupt_Config.h"
+
+// Pulse widths are ramped in Q16 PWM clock ticks so that slow slew rates still move
+#define MOTOR_Q16_ONE 65536
+
+static uint8_t motor_mode = MOTOR_CONTROL_SERVO;
+static uint32_t period_ticks = SERVO_PERIOD_TICKS;
+
+// Pulse width range of the output and its size in ticks per unit (Q16)
+static uint32_t min_pulse_ticks = SERVO_MIN_PULSE_TICKS;
+static uint32_t ticks_per_unit_q16 = ((SERVO_MAX_PULSE_TICKS - SERVO_MIN_PULSE_TICKS) * MOTOR_Q16_ONE) / SERVO_MAX_ANGLE;
+
+// Number of PWM periods between two ramp updates
+static uint16_t update_divider = 1;
+static uint16_t update_frequency_hz = SERVO_PWM_FREQUENCY;
+static uint16_t update_count = 0;
+
+// Current and target pulse widths and the ramp step per update, in Q16 ticks
+static volatile uint32_t current_pulse_q16 = 0;
+static volatile uint32_t target_pulse_q16 = 0;
+static volatile uint32_t step_q16 = 0;
+
+static void Motor_Control_Enable_Ramp(uint8_t enable)
+{
+	// Set or clear the INTCNTLOAD bit (Bit 1) in the PWM0INTEN register
+	PWM0->_0_INTEN = enable ? 0x02 : 0x00;
+}
+
+static void Motor_Control_Set_Target(uint32_t pulse_ticks)
+{
+	// Stop the ramp while the target is changed
+	Motor_Control_Enable_Ramp(0);
+	
+	target_pulse_q16 = pulse_ticks * MOTOR_Q16_ONE;
+	
+	// Without a slew rate limit, the new pulse width is applied at the end of the current period
+	if (step_q16 == 0)
+	{
+		current_pulse_q16 = target_pulse_q16;
+		PWM_Set_Duty_Cycle(PWM_M0PWM0, (uint16_t)pulse_ticks);
+	}
+	
+	Motor_Control_Enable_Ramp(current_pulse_q16 != target_pulse_q16);
+}
+
+void Motor_Control_Init(uint8_t mode, uint16_t update_frequency)
+{
+	uint16_t pwm_frequency;
+	
+	motor_mode = mode;
+	
+	if (mode == MOTOR_CONTROL_SERVO)
+	{
+		pwm_frequency = SERVO_PWM_FREQUENCY;
+		period_ticks = SERVO_PERIOD_TICKS;
+		min_pulse_ticks = SERVO_MIN_PULSE_TICKS;
+		ticks_per_unit_q16 = ((SERVO_MAX_PULSE_TICKS - SERVO_MIN_PULSE_TICKS) * MOTOR_Q16_ONE) / SERVO_MAX_ANGLE;
+	}
+	else
+	{
+		pwm_frequency = DC_MOTOR_PWM_FREQUENCY;
+		period_ticks = DC_MOTOR_PERIOD_TICKS;
+		min_pulse_ticks = 0;
+		ticks_per_unit_q16 = (DC_MOTOR_PERIOD_TICKS * MOTOR_Q16_ONE) / 100;
+	}
+	
+	// The ramp is updated at most once per PWM period
+	if ((update_frequency == 0) || (update_frequency > pwm_frequency))
+	{
+		update_frequency = pwm_frequency;
+	}
+	
+	update_divider = pwm_frequency / update_frequency;
+	update_frequency_hz = pwm_frequency / update_divider;
+	update_count = 0;
+	
+	current_pulse_q16 = min_pulse_ticks * MOTOR_Q16_ONE;
+	target_pulse_q16 = current_pulse_q16;
+	
+	// Configure PB6 as the M0PWM0 output with locally synchronized updates,
+	// so that a new pulse width never cuts a period short
+	PWM_Channel_Config config = { PWM_M0PWM0, 0, (uint16_t)period_ticks, (uint16_t)min_pulse_ticks, 0, 0 };
+	PWM_Init_Channel(&config);
+	
+	Motor_Control_Set_Slew_Rate((mode == MOTOR_CONTROL_SERVO) ? SERVO_DEFAULT_SLEW_RATE : DC_MOTOR_DEFAULT_SLEW_RATE);
+	
+	// Route the Generator 0 interrupt to the interrupt controller by setting
+	// the INTPWM0 bit (Bit 0) in the PWMINTEN register
+	Motor_Control_Enable_Ramp(0);
+	PWM0->_0_ISC = 0x02;
+	PWM0->INTEN |= 0x01;
+	
+	// Enable the PWM Module 0 Generator 0 interrupt (IRQ 10) at its level in the priority plan
+	Interrupt_Config_Enable(INTERRUPT_MOTOR);
+}
+
+void Motor_Control_Release(void)
+{
+	Motor_Control_Enable_Ramp(0);
+	PWM_Release_Pin(PWM_M0PWM0);
+}
+
+void Motor_Control_Set_Slew_Rate(uint16_t units_per_second)
+{
+	// Convert the slew rate to a step in Q16 ticks per ramp update
+	step_q16 = (uint32_t)(((uint64_t)units_per_second * ticks_per_unit_q16) / update_frequency_hz);
+	
+	if ((units_per_second != 0) && (step_q16 == 0))
+	{
+		step_q16 = 1;
+	}
+}
+
+void Motor_Control_Set_Angle(uint16_t degrees)
+{
+	if (motor_mode != MOTOR_CONTROL_SERVO) return;
+	
+	if (degrees > SERVO_MAX_ANGLE)
+	{
+		degrees = SERVO_MAX_ANGLE;
+	}
+	
+	Motor_Control_Set_Target(min_pulse_ticks + ((degrees * ticks_per_unit_q16) >> 16));
+}
+
+void Motor_Control_Set_Speed(uint8_t percent)
+{
+	if (motor_mode != MOTOR_CONTROL_DC_MOTOR) return;
+	
+	if (percent > 100)
+	{
+		percent = 100;
+	}
+	
+	Motor_Control_Set_Target((percent * ticks_per_unit_q16) >> 16);
+}
+
+uint8_t Motor_Control_Is_Moving(void)
+{
+	return current_pulse_q16 != target_pulse_q16;
+}
+
+void PWM0_0_Handler(void)
+{
+	// Acknowledge the load interrupt by writing 1 to the INTCNTLOAD bit (Bit 1) in the PWM0ISC register
+	PWM0->_0_ISC = 0x02;
+	
+	if (++update_count < update_divider) return;
+	update_count = 0;
+	
+	uint32_t current = current_pulse_q16;
+	uint32_t target = target_pulse_q16;
+	
+	// Move one step towards the target without overshooting it
+	if (current < target)
+	{
+		current = ((target - current) > step_q16) ? (current + step_q16) : target;
+	}
+	else
+	{
+		current = ((current - target) > step_q16) ? (current - step_q16) : target;
+	}
+	
+	current_pulse_q16 = current;
+	PWM_Set_Duty_Cycle(PWM_M0PWM0, (uint16_t)((current + (MOTOR_Q16_ONE / 2)) >> 16));
+	
+	// Stop the interrupt once the target has been reached
+	if (current == target)
+	{
+		Motor_Control_Enable_Ramp(0);
+	}
+}
@@ -0,0 +1,125 @@
+/**
+ * @file Motor_Control.h
+ *
+ * @brief Header file for the Motor_Control driver.
+ *
+ * This file contains the function definitions for the Motor_Control driver.
+ * It controls a hobby servo or a DC motor driver with the PWM signal of
+ * Module 0 Generator 0 on the PB6 pin (M0PWM0).
+ *
+ * Commands are given in physical units (degrees for a servo, percent of full speed for a
+ * DC motor) and return immediately. The output then ramps towards the new target at a
+ * limited slew rate, updated from the PWM0_0 load interrupt, so that the actuator moves
+ * smoothly. The interrupt is only enabled while the output is ramping.
+ *
+ * @note This driver assumes that the system clock's frequency is 50 MHz and that the
+ * PWM_Clock_Init function has been called before calling the Motor_Control_Init function.
+ */
+
+#ifndef MOTOR_CONTROL_H
+#define MOTOR_CONTROL_H
+
+#include "TM4C123GH6PM.h"
+#include "PWM_Clock.h"
+
+// Servo signal: 50 Hz with a 1 ms to 2 ms pulse for 0 to SERVO_MAX_ANGLE degrees
+#define SERVO_PWM_FREQUENCY 50
+#define SERVO_MIN_PULSE_US  1000
+#define SERVO_MAX_PULSE_US  2000
+#define SERVO_MAX_ANGLE     180
+
+// DC motor signal frequency
+#define DC_MOTOR_PWM_FREQUENCY 10000
+
+// PWM periods and pulse widths in PWM clock ticks, computed at compile time
+#define SERVO_PERIOD_TICKS    PWM_HZ_TO_TICKS(SERVO_PWM_FREQUENCY)
+#define SERVO_MIN_PULSE_TICKS PWM_US_TO_TICKS(SERVO_MIN_PULSE_US)
+#define SERVO_MAX_PULSE_TICKS PWM_US_TO_TICKS(SERVO_MAX_PULSE_US)
+#define DC_MOTOR_PERIOD_TICKS PWM_HZ_TO_TICKS(DC_MOTOR_PWM_FREQUENCY)
+
+// Default slew rates in units (degrees or percent) per second
+#define SERVO_DEFAULT_SLEW_RATE    90
+#define DC_MOTOR_DEFAULT_SLEW_RATE 50
+
+enum Motor_Control_Modes
+{
+	MOTOR_CONTROL_SERVO    = 0x00,
+	MOTOR_CONTROL_DC_MOTOR = 0x01
+};
+
+/**
+ * @brief Initializes the motor output on PB6.
+ *
+ * This function configures PB6 as the M0PWM0 output with the period of the selected mode, sets the
+ * output to 0 degrees (servo) or stopped (DC motor) and enables the PWM0_0 interrupt in the NVIC.
+ * The PWM Module 0 Generator 0 interrupt is enabled at level 5 of the priority plan (see Interrupt_Config.h).
+ *
+ * @param mode The type of actuator (see Motor_Control_Modes).
+ *
+ * @param update_frequency The rate of the ramp updates in Hz, up to the PWM frequency of the mode.
+ *
+ * @return None
+ */
+void Motor_Control_Init(uint8_t mode, uint16_t update_frequency);
+
+/**
+ * @brief Stops the motor output.
+ *
+ * This function stops the ramp and drives PB6 low as a GPIO output, so that the actuator
+ * receives no pulses. Motor_Control_Init must be called before the output is used again.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Motor_Control_Release(void);
+
+/**
+ * @brief Sets the maximum rate of change of the output.
+ *
+ * @param units_per_second The slew rate in degrees per second (servo) or percent per second (DC motor).
+ *                         A value of 0 disables the ramp and applies new targets at the next period.
+ *
+ * @return None
+ */
+void Motor_Control_Set_Slew_Rate(uint16_t units_per_second);
+
+/**
+ * @brief Moves the servo to an angle.
+ *
+ * @param degrees The target angle (0 - SERVO_MAX_ANGLE).
+ *
+ * @return None
+ */
+void Motor_Control_Set_Angle(uint16_t degrees);
+
+/**
+ * @brief Sets the speed of the DC motor.
+ *
+ * @param percent The target speed in percent of full speed (0 - 100).
+ *
+ * @return None
+ */
+void Motor_Control_Set_Speed(uint8_t percent);
+
+/**
+ * @brief Returns whether the output is still ramping towards its target.
+ *
+ * @param None
+ *
+ * @return 1 while the output is ramping, or 0 once it has reached the target.
+ */
+uint8_t Motor_Control_Is_Moving(void);
+
+/**
+ * @brief The interrupt service routine (ISR) for PWM Module 0 Generator 0.
+ *
+ * This function moves the pulse width one step towards the target on each update.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void PWM0_0_Handler(void);
+
+#endif
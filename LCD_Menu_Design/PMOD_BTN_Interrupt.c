@@ -1,4 +1,7 @@
 #include "PMOD_BTN_Interrupt.h"
+#include "Trace_Recorder.h"
+#include "Button_Debounce.h"
+#include "Interrupt_Config.h"
  
 // Declare pointer to the user-defined task
 void (*PMOD_BTN_Task)(uint8_t pmod_btn_state);
@@ -51,14 +54,69 @@ void PMOD_BTN_Interrupt_Init(void(*task)(uint8_t))
 	// Bits 5 to 2 in the IM register
 	GPIOA->IM |= 0x3C;
 	
-	// Clear the INTA field (Bits 7 to 5) of the IPR[0] register (PRI0)
-	NVIC->IPR[0] &= ~0x000000E0;
+	// Enable the GPIO Port A interrupt (IRQ 0) at its level in the priority plan
+	Interrupt_Config_Enable(INTERRUPT_PMOD_BTN);
+}
+
+static void PMOD_BTN_Enable_Interrupts(void)
+{
+	// Clear any pending edge and unmask the PA5, PA4, PA3, and PA2 pins
+	GPIOA->ICR = 0x3C;
+	GPIOA->IM |= 0x3C;
+}
+
+void PMOD_BTN_Init(void)
+{
+	// Use the debounce engine instead of a user-defined task
+	PMOD_BTN_Task = 0;
+	
+	// Enable the clock to Port A by setting the
+	// R0 bit (Bit 0) in the RCGCGPIO register
+	SYSCTL->RCGCGPIO |= 0x01;
+	
+	// Mask the interrupts of the PA5, PA4, PA3, and PA2 pins during configuration
+	// by clearing Bits 5 to 2 in the IM register. The debounce engine unmasks them.
+	GPIOA->IM &= ~0x3C;
+	
+	// Configure the PA5, PA4, PA3, and PA2 pins as input
+	// by clearing Bits 5 to 2 in the DIR register
+	GPIOA->DIR &= ~0x3C;
+	
+	// Configure the PA5, PA4, PA3, and PA2 pins to function as
+	// GPIO pins by clearing Bits 5 to 2 in the AFSEL register
+	GPIOA->AFSEL &= ~0x3C;
+	
+	// Enable the digital functionality for the PA5, PA4, PA3, and PA2 pins
+	// by setting Bits 5 to 2 in the DEN register
+	GPIOA->DEN |= 0x3C;
+	
+	// Enable the weak pull-down resistor for the PA5, PA4, PA3, and PA2 pins
+	// by setting Bits 5 to 2 in the PDR register
+	GPIOA->PDR |= 0x3C;
+	
+	// Configure the PA5, PA4, PA3, and PA2 pins to detect rising edges
+	// by clearing Bits 5 to 2 in the IS and IBE registers and setting them in the IEV register.
+	// The first edge of a press wakes the debounce engine, which then samples the pins.
+	GPIOA->IS &= ~0x3C;
+	GPIOA->IBE &= ~0x3C;
+	GPIOA->IEV |= 0x3C;
 	
-	// Set the priority level of the interrupts to 3. Port A has an Interrupt Request (IRQ) number of 0
-	NVIC->IPR[0] |= (3 << 5);
+	// Register the four buttons with the debounce engine as an interrupt-driven port
+	Button_Debounce_Add_Port(INPUT_SOURCE_PMOD_BTN, &PMOD_BTN_Read, 0x3C, &PMOD_BTN_Enable_Interrupts);
 	
-	// Enable IRQ 0 for GPIO Port A by setting Bit 0 in the ISER[0] register
-	NVIC->ISER[0] |= (1 << 0);
+	// Enable the GPIO Port A interrupt (IRQ 0) at its level in the priority plan
+	Interrupt_Config_Enable(INTERRUPT_PMOD_BTN);
+}
+
+void PMOD_BTN_Release(void)
+{
+	// Mask the interrupts of the PA5, PA4, PA3, and PA2 pins
+	// by clearing Bits 5 to 2 in the IM register
+	GPIOA->IM &= ~0x3C;
+	GPIOA->ICR = 0x3C;
+	
+	// Stop sampling the buttons, which could be woken before the interrupts were masked
+	Button_Debounce_Remove_Port(INPUT_SOURCE_PMOD_BTN);
 }
 
 uint8_t PMOD_BTN_Read(void)
@@ -74,15 +132,32 @@ uint8_t PMOD_BTN_Read(void)
 
 void GPIOA_Handler(void)
 {
+	TRACE_ISR_ENTER(GPIOA_IRQn);
+	
 	// Check if an interrupt has been triggered by any of
 	// the following pins: PA5, PA4, PA3, and PA2
-	if (GPIOA->MIS & 0x3C)
+	if ((GPIOA->MIS & 0x3C) && (PMOD_BTN_Task == 0))
 	{
+		// Mask the button interrupts so that contact bounce cannot cause an interrupt storm,
+		// and let the debounce engine sample the pins until they are stable again
+		GPIOA->IM &= ~0x3C;
+		GPIOA->ICR = 0x3C;
+		Button_Debounce_Wake(INPUT_SOURCE_PMOD_BTN);
+	}
+	else if (GPIOA->MIS & 0x3C)
+	{
+		uint8_t pmod_btn_state = PMOD_BTN_Read();
+		
+		// Record the button edge with the pins that caused the interrupt
+		TRACE_BUTTON_EDGE('A', ((GPIOA->MIS & 0x3C) << 8) | pmod_btn_state);
+		
 		// Execute the user-defined function
-		(*PMOD_BTN_Task)(PMOD_BTN_Read());
+		(*PMOD_BTN_Task)(pmod_btn_state);
 		
 		// Acknowledge the interrupt from any of the following pins
 		// and clear it: PA5, PA4, PA3, and PA2
 		GPIOA->ICR |= 0x3C;
 	}
+	
+	TRACE_ISR_EXIT(GPIOA_IRQn);
 }
\ No newline at end of file
@@ -33,7 +33,7 @@ extern void (*PMOD_BTN_Task)(uint8_t pmod_btn_state);
  *
  * It configures the specified pins to trigger interrupts on rising edges.
  * When an interrupt occurs, the provided task function is executed with the current button status.
- * Interrupt priority is set to 3 for GPIO Port A.
+ * The GPIO Port A interrupt is enabled at level 3 of the priority plan (see Interrupt_Config.h).
  *
  * @param task A pointer to the user-defined function to be executed upon button interrupts.
  *
@@ -41,6 +41,41 @@ extern void (*PMOD_BTN_Task)(uint8_t pmod_btn_state);
  */
 void PMOD_BTN_Interrupt_Init(void(*task)(uint8_t));
 
+/**
+ * @brief Initializes the PMOD BTN module for timer-sampled debouncing.
+ *
+ * This function configures the following pins as inputs with weak pull-down resistors:
+ * 	- BTN0 (PA2)
+ *	- BTN1 (PA3)
+ *	- BTN2 (PA4)
+ *	- BTN3 (PA5)
+ *
+ * The pins are registered with the Button_Debounce driver as INPUT_SOURCE_PMOD_BTN.
+ * The first rising edge of a press wakes the debounce engine and masks the pin interrupts,
+ * so contact bounce does not cause an interrupt storm. The engine samples the pins until they
+ * are released and stable, posts press, release, long-press, repeat and double-click events
+ * to the Input_Event queue, and then unmasks the interrupts again.
+ * The GPIO Port A interrupt is enabled at level 3 of the priority plan (see Interrupt_Config.h).
+ *
+ * @param None
+ *
+ * @return None
+ */
+void PMOD_BTN_Init(void);
+
+/**
+ * @brief Stops the PMOD BTN module so that its pins can be used by another driver.
+ *
+ * This function masks the interrupts of the PA5, PA4, PA3, and PA2 pins and removes them
+ * from the Button_Debounce driver. The pins are not reconfigured. PMOD_BTN_Init
+ * starts the module again.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void PMOD_BTN_Release(void);
+
 /**
  * @brief Reads the current status of the PMOD BTN module.
  *
@@ -0,0 +1,150 @@
+/**
+ * @file PMOD_ENC.c
+ *
+ * @brief Source code for the PMOD_ENC driver.
+ *
+ * This file contains the function definitions for the PMOD_ENC driver.
+ * It interfaces with the PMOD ENC rotary encoder module. The following pins are used:
+ *  - Encoder Channel A  [A]    (PE1)
+ *  - Encoder Channel B  [B]    (PE2)
+ *  - Push Button        [BTN]  (PE3)
+ *  - Slide Switch       [SWT]  (PE4)
+ */
+
+#include "PMOD_ENC.h"
+#include "Button_Debounce.h"
+#include "Trace_Recorder.h"
+#include "Interrupt_Config.h"
+
+// Quadrature state table indexed by ((previous AB state << 2) | current AB state).
+// Valid transitions give +1 or -1, while invalid transitions (both channels
+// changed at once) and bounces back to the previous state give 0.
+static const int8_t quadrature_table[16] =
+{
+	 0, -1,  1,  0,
+	 1,  0,  0, -1,
+	-1,  0,  0,  1,
+	 0,  1, -1,  0
+};
+
+static uint8_t previous_ab_state = 0;
+static int8_t step_count = 0;
+static volatile int32_t encoder_position = 0;
+
+static uint8_t PMOD_ENC_Read_AB(void)
+{
+	// Read the A (PE1) and B (PE2) channels as a 2-bit value
+	return (uint8_t)((GPIOE->DATA & 0x06) >> 1);
+}
+
+static void PMOD_ENC_Enable_Interrupts(void)
+{
+	// Clear any pending edge and unmask the PE4 and PE3 pins
+	GPIOE->ICR = 0x18;
+	GPIOE->IM |= 0x18;
+}
+
+void PMOD_ENC_Init(void)
+{
+	// Enable the clock to Port E by setting the
+	// R4 bit (Bit 4) in the RCGCGPIO register
+	SYSCTL->RCGCGPIO |= 0x10;
+	
+	// Mask the interrupts of the PE4 to PE1 pins during configuration
+	// by clearing Bits 4 to 1 in the IM register
+	GPIOE->IM &= ~0x1E;
+	
+	// Configure the PE4 to PE1 pins as input
+	// by clearing Bits 4 to 1 in the DIR register
+	GPIOE->DIR &= ~0x1E;
+	
+	// Configure the PE4 to PE1 pins to function as
+	// GPIO pins by clearing Bits 4 to 1 in the AFSEL register
+	GPIOE->AFSEL &= ~0x1E;
+	
+	// Disable the analog functionality for the PE4 to PE1 pins
+	// by clearing Bits 4 to 1 in the AMSEL register
+	GPIOE->AMSEL &= ~0x1E;
+	
+	// Enable the digital functionality for the PE4 to PE1 pins
+	// by setting Bits 4 to 1 in the DEN register
+	GPIOE->DEN |= 0x1E;
+	
+	// Configure the PE4 to PE1 pins to detect edges by clearing Bits 4 to 1 in the IS register
+	GPIOE->IS &= ~0x1E;
+	
+	// Configure the PE4, PE2 and PE1 pins to detect both edges by setting their bits in the IBE register.
+	// The slide switch must wake the debounce engine when it is turned off as well.
+	GPIOE->IBE |= 0x16;
+	
+	// Configure the PE3 pin to detect rising edges
+	GPIOE->IBE &= ~0x08;
+	GPIOE->IEV |= 0x08;
+	
+	// Start decoding from the current position of the channels
+	previous_ab_state = PMOD_ENC_Read_AB();
+	step_count = 0;
+	encoder_position = 0;
+	
+	// Register the push button and the slide switch with the debounce engine
+	Button_Debounce_Add_Port(INPUT_SOURCE_PMOD_ENC, &PMOD_ENC_Read_Buttons, 0x18, &PMOD_ENC_Enable_Interrupts);
+	Button_Debounce_Set_Switches(INPUT_SOURCE_PMOD_ENC, PMOD_ENC_SWT);
+	
+	// Clear any existing interrupt flags on the PE2 and PE1 pins and unmask them
+	GPIOE->ICR = 0x06;
+	GPIOE->IM |= 0x06;
+	
+	// Enable the GPIO Port E interrupt (IRQ 4) at its level in the priority plan
+	Interrupt_Config_Enable(INTERRUPT_PMOD_ENC);
+}
+
+uint8_t PMOD_ENC_Read_Buttons(void)
+{
+	// A "0x18" bit mask is used to capture only the BTN (PE3) and SWT (PE4) pins
+	return (uint8_t)(GPIOE->DATA & 0x18);
+}
+
+int32_t PMOD_ENC_Position(void)
+{
+	return encoder_position;
+}
+
+void GPIOE_Handler(void)
+{
+	TRACE_ISR_ENTER(GPIOE_IRQn);
+	
+	uint32_t status = GPIOE->MIS;
+	
+	// Decode a transition on channel A (PE1) or channel B (PE2)
+	if (status & 0x06)
+	{
+		GPIOE->ICR = 0x06;
+		
+		uint8_t ab_state = PMOD_ENC_Read_AB();
+		step_count += quadrature_table[(previous_ab_state << 2) | ab_state];
+		previous_ab_state = ab_state;
+		
+		if (step_count >= PMOD_ENC_STEPS_PER_DETENT)
+		{
+			step_count = 0;
+			encoder_position++;
+			Input_Event_Post(INPUT_SOURCE_PMOD_ENC, PMOD_ENC_ROTATION, INPUT_EVENT_ROTATE, 1);
+		}
+		else if (step_count <= -PMOD_ENC_STEPS_PER_DETENT)
+		{
+			step_count = 0;
+			encoder_position--;
+			Input_Event_Post(INPUT_SOURCE_PMOD_ENC, PMOD_ENC_ROTATION, INPUT_EVENT_ROTATE, -1);
+		}
+	}
+	
+	// Wake the debounce engine on an edge of the push button (PE3) or slide switch (PE4)
+	if (status & 0x18)
+	{
+		GPIOE->IM &= ~0x18;
+		GPIOE->ICR = 0x18;
+		Button_Debounce_Wake(INPUT_SOURCE_PMOD_ENC);
+	}
+	
+	TRACE_ISR_EXIT(GPIOE_IRQn);
+}
@@ -0,0 +1,77 @@
+/**
+ * @file PMOD_ENC.h
+ *
+ * @brief Header file for the PMOD_ENC driver.
+ *
+ * This file contains the function definitions for the PMOD_ENC driver.
+ * It interfaces with the PMOD ENC rotary encoder module. The following pins are used:
+ *  - Encoder Channel A  [A]    (PE1)
+ *  - Encoder Channel B  [B]    (PE2)
+ *  - Push Button        [BTN]  (PE3)
+ *  - Slide Switch       [SWT]  (PE4)
+ *
+ * Channels A and B interrupt on both edges and are decoded with a quadrature state table.
+ * Contact bounce on one channel only produces transitions that cancel out, so no extra
+ * debouncing is needed. An INPUT_EVENT_ROTATE event is posted for every detent, with a value
+ * of +1 for clockwise and -1 for counter-clockwise rotation.
+ *
+ * The push button and slide switch are debounced by the Button_Debounce engine. They post
+ * events as INPUT_SOURCE_PMOD_ENC with a code of PMOD_ENC_BTN or PMOD_ENC_SWT, in the same
+ * format as the PMOD BTN and EduBase button events. The slide switch only generates
+ * INPUT_EVENT_PRESS (on) and INPUT_EVENT_RELEASE (off) events.
+ */
+
+#include "TM4C123GH6PM.h"
+#include "Input_Event.h"
+
+// Event codes of the PMOD ENC inputs
+#define PMOD_ENC_ROTATION 0x00
+#define PMOD_ENC_BTN      0x08
+#define PMOD_ENC_SWT      0x10
+
+// Number of quadrature transitions between two detents
+#define PMOD_ENC_STEPS_PER_DETENT 4
+
+/**
+ * @brief Initializes the PMOD ENC module using Port E.
+ *
+ * This function configures the PE4 to PE1 pins as inputs. PE1 and PE2 interrupt on both edges
+ * to decode the rotation. PE3 and PE4 are registered with the Button_Debounce driver as an
+ * interrupt-driven port, with PE4 marked as a toggle switch.
+ * The GPIO Port E interrupt is enabled at level 3 of the priority plan (see Interrupt_Config.h).
+ *
+ * @param None
+ *
+ * @return None
+ */
+void PMOD_ENC_Init(void);
+
+/**
+ * @brief Reads the current status of the PMOD ENC push button and slide switch.
+ *
+ * @param None
+ *
+ * @return An 8-bit unsigned integer with PMOD_ENC_BTN and PMOD_ENC_SWT set when active.
+ */
+uint8_t PMOD_ENC_Read_Buttons(void);
+
+/**
+ * @brief Returns the accumulated encoder position.
+ *
+ * @param None
+ *
+ * @return The number of detents turned since initialization (positive for clockwise).
+ */
+int32_t PMOD_ENC_Position(void);
+
+/**
+ * @brief The interrupt service routine (ISR) for GPIO Port E.
+ *
+ * This function decodes the quadrature transitions of channels A and B, posts a rotation
+ * event for every detent, and wakes the debounce engine on push button and switch edges.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void GPIOE_Handler(void);
@@ -0,0 +1,353 @@
+/**
+ * @file PWM.c
+ *
+ * @brief Source file for the PWM driver.
+ *
+ * This file contains the function definitions for the PWM driver.
+ * It drives all of the generators of PWM Module 0 and PWM Module 1 from a pin table.
+ *
+ * @note This driver assumes that the system clock's frequency is 50 MHz.
+ */
+
+#include "PWM.h"
+#include "GPIO.h"
+
+// Register block of one PWM generator. The blocks of Generators 0 to 3
+// are 0x40 bytes apart, starting at offset 0x40 of the module
+typedef struct
+{
+	__IO uint32_t CTL;
+	__IO uint32_t INTEN;
+	__IO uint32_t RIS;
+	__IO uint32_t ISC;
+	__IO uint32_t LOAD;
+	__IO uint32_t COUNT;
+	__IO uint32_t CMP[2];
+	__IO uint32_t GEN[2];
+	__IO uint32_t DBCTL;
+	__IO uint32_t DBRISE;
+	__IO uint32_t DBFALL;
+	__IO uint32_t FLTSRC0;
+	__IO uint32_t FLTSRC1;
+	__IO uint32_t MINFLTPER;
+} PWM_Generator_Type;
+
+#define PWM_GENERATOR(module, generator) \
+	((PWM_Generator_Type *)((uint32_t)PWM_Module(module) + 0x40 + ((generator) * 0x40)))
+
+// Bits of the PWMnCTL register of a generator
+#define PWM_CTL_ENABLE        0x00000001
+#define PWM_CTL_MODE_UP_DOWN  0x00000002
+
+// Update modes of the PWMnCTL register: the LOAD, CMPA, CMPB, GENA, GENB, DBCTL, DBRISE
+// and DBFALL registers are either updated at the next zero of the counter (local),
+// or at the next zero after a PWM_Commit (global)
+#define PWM_CTL_LOCAL_UPDATES  0x0000AA80
+#define PWM_CTL_GLOBAL_UPDATES 0x0000FFF8
+
+// Actions of the PWMnGENA and PWMnGENB registers
+#define PWM_GEN_ALWAYS_LOW     0x0000000A
+#define PWM_GEN_ALWAYS_HIGH    0x0000000F
+
+// Count-Down mode: driven low on LOAD and high on the comparator match while counting down
+static const uint32_t pwm_gen_down[2] = { 0x000000C8, 0x00000C08 };
+
+// Count-Up/Down mode: driven low on the comparator match while counting up
+// and high on the comparator match while counting down
+static const uint32_t pwm_gen_up_down[2] = { 0x000000E0, 0x00000E00 };
+
+typedef struct
+{
+	GPIOA_Type *port;
+	uint8_t pin;
+	uint8_t pctl;
+} PWM_Pin;
+
+static const PWM_Pin pwm_pins[PWM_NUM_CHANNELS] =
+{
+	{ GPIOB, 6, 0x4 },	// M0PWM0
+	{ GPIOB, 7, 0x4 },	// M0PWM1
+	{ GPIOB, 4, 0x4 },	// M0PWM2
+	{ GPIOB, 5, 0x4 },	// M0PWM3
+	{ GPIOE, 4, 0x4 },	// M0PWM4
+	{ GPIOE, 5, 0x4 },	// M0PWM5
+	{ GPIOC, 4, 0x4 },	// M0PWM6
+	{ GPIOC, 5, 0x4 },	// M0PWM7
+	{ GPIOD, 0, 0x5 },	// M1PWM0
+	{ GPIOD, 1, 0x5 },	// M1PWM1
+	{ GPIOA, 6, 0x5 },	// M1PWM2
+	{ GPIOA, 7, 0x5 },	// M1PWM3
+	{ GPIOF, 0, 0x5 },	// M1PWM4
+	{ GPIOF, 1, 0x5 },	// M1PWM5
+	{ GPIOF, 2, 0x5 },	// M1PWM6
+	{ GPIOF, 3, 0x5 }	// M1PWM7
+};
+
+// Period and configuration flags of each generator
+static uint16_t generator_period[2][4];
+static uint8_t generator_flags[2][4];
+
+PWM0_Type *PWM_Module(uint8_t module)
+{
+	return (module == 0) ? PWM0 : PWM1;
+}
+
+static void PWM_Configure_Pin(uint8_t channel)
+{
+	const PWM_Pin *pin = &pwm_pins[channel];
+	uint8_t mask = (uint8_t)(1 << pin->pin);
+	
+	// PF0 is locked as an NMI pin and must be unlocked before it can be reconfigured
+	if ((pin->port == GPIOF) && (mask == 0x01))
+	{
+		GPIOF->LOCK = 0x4C4F434B;
+		GPIOF->CR |= 0x01;
+	}
+	
+	GPIO_Configure(pin->port, mask, GPIO_ALTERNATE);
+	
+	// Select the PWM function in the PMCx field of the PCTL register
+	pin->port->PCTL = (pin->port->PCTL & ~(0xFUL << (pin->pin * 4))) | ((uint32_t)pin->pctl << (pin->pin * 4));
+}
+
+static void PWM_Write_Duty_Cycle(uint8_t channel, uint16_t duty_cycle)
+{
+	uint8_t module = PWM_CHANNEL_MODULE(channel);
+	uint8_t generator = PWM_CHANNEL_GENERATOR(channel);
+	uint8_t output = PWM_CHANNEL_OUTPUT(channel);
+	uint16_t period = generator_period[module][generator];
+	uint8_t center_aligned = generator_flags[module][generator] & PWM_CENTER_ALIGNED;
+	PWM_Generator_Type *pwm_generator = PWM_GENERATOR(module, generator);
+	uint32_t action;
+	
+	if (duty_cycle == 0)
+	{
+		action = PWM_GEN_ALWAYS_LOW;
+	}
+	else if (duty_cycle >= period)
+	{
+		action = PWM_GEN_ALWAYS_HIGH;
+	}
+	else if (center_aligned)
+	{
+		// The output is high while the counter is below the comparator,
+		// which lasts twice the comparator value around the zero of the counter
+		uint16_t compare = duty_cycle / 2;
+		pwm_generator->CMP[output] = (compare == 0) ? 1 : compare;
+		action = pwm_gen_up_down[output];
+	}
+	else
+	{
+		// The output is high from the comparator match down to zero
+		pwm_generator->CMP[output] = duty_cycle - 1;
+		action = pwm_gen_down[output];
+	}
+	
+	// The action only changes when the duty cycle reaches or leaves 0 % or 100 %
+	if (pwm_generator->GEN[output] != action)
+	{
+		pwm_generator->GEN[output] = action;
+	}
+}
+
+static void PWM_Write_Period(uint8_t module, uint8_t generator, uint16_t period)
+{
+	generator_period[module][generator] = period;
+	
+	// In Count-Up/Down mode the counter goes from 0 to LOAD and back,
+	// so a period lasts twice the LOAD value
+	if (generator_flags[module][generator] & PWM_CENTER_ALIGNED)
+	{
+		PWM_GENERATOR(module, generator)->LOAD = period / 2;
+	}
+	else
+	{
+		PWM_GENERATOR(module, generator)->LOAD = period - 1;
+	}
+}
+
+void PWM_Init_Channel(const PWM_Channel_Config *config)
+{
+	uint8_t channel = config->channel;
+	uint8_t module = PWM_CHANNEL_MODULE(channel);
+	uint8_t generator = PWM_CHANNEL_GENERATOR(channel);
+	PWM0_Type *pwm_module = PWM_Module(module);
+	PWM_Generator_Type *pwm_generator = PWM_GENERATOR(module, generator);
+	
+	// Channels with a dead-band are driven from the A output of the generator
+	uint8_t output_mask = (uint8_t)(1 << (channel % 8));
+	if (config->flags & PWM_DEAD_BAND)
+	{
+		output_mask = (uint8_t)(0x03 << (generator * 2));
+	}
+	
+	// Enable the clock to the PWM module by setting its bit in the RCGCPWM register
+	// and wait until the module is ready
+	SYSCTL->RCGCPWM |= (1 << module);
+	while ((SYSCTL->PRPWM & (1 << module)) == 0);
+	
+	if (!(config->flags & PWM_NO_PIN))
+	{
+		PWM_Configure_Pin(channel);
+		
+		if (config->flags & PWM_DEAD_BAND)
+		{
+			PWM_Configure_Pin(channel | 0x01);
+		}
+	}
+	
+	// Disable the generator during configuration, then select
+	// the counting mode and how its registers are updated
+	pwm_generator->CTL = 0;
+	pwm_generator->CTL = ((config->flags & PWM_CENTER_ALIGNED) ? PWM_CTL_MODE_UP_DOWN : 0) |
+	                     ((config->flags & PWM_SYNC_GLOBAL) ? PWM_CTL_GLOBAL_UPDATES : PWM_CTL_LOCAL_UPDATES);
+	
+	generator_flags[module][generator] = config->flags;
+	PWM_Write_Period(module, generator, config->period);
+	PWM_Write_Duty_Cycle(channel, config->duty_cycle);
+	
+	// Configure the dead-band generator, which derives both outputs from the A output
+	if (config->flags & PWM_DEAD_BAND)
+	{
+		pwm_generator->DBRISE = config->dead_band_rise & 0x0FFF;
+		pwm_generator->DBFALL = config->dead_band_fall & 0x0FFF;
+		pwm_generator->DBCTL = 0x01;
+	}
+	else
+	{
+		pwm_generator->DBCTL = 0x00;
+	}
+	
+	// Invert the outputs in the PWMINVERT register if needed
+	if (config->flags & PWM_INVERTED)
+	{
+		pwm_module->INVERT |= output_mask;
+	}
+	else
+	{
+		pwm_module->INVERT &= ~output_mask;
+	}
+	
+	// Synchronize the enabling and disabling of the outputs in the PWMENUPD register
+	for (uint8_t i = 0; i < 8; i++)
+	{
+		if (output_mask & (1 << i))
+		{
+			pwm_module->ENUPD = (pwm_module->ENUPD & ~(0x3UL << (i * 2))) |
+			                    (((config->flags & PWM_SYNC_GLOBAL) ? 0x3UL : 0x2UL) << (i * 2));
+		}
+	}
+	
+	// Enable the generator and pass its signal to the pins in the PWMENABLE register
+	pwm_generator->CTL |= PWM_CTL_ENABLE;
+	pwm_module->ENABLE |= output_mask;
+	
+	// A global update is needed to load the initial values of a globally synchronized generator
+	if (config->flags & PWM_SYNC_GLOBAL)
+	{
+		PWM_Commit(module, (uint8_t)(1 << generator));
+	}
+}
+
+void PWM_Init_Channels(const PWM_Channel_Config *table, uint8_t num_channels)
+{
+	uint8_t generator_masks[2] = { 0, 0 };
+	
+	for (uint8_t i = 0; i < num_channels; i++)
+	{
+		PWM_Init_Channel(&table[i]);
+		generator_masks[PWM_CHANNEL_MODULE(table[i].channel)] |= (uint8_t)(1 << PWM_CHANNEL_GENERATOR(table[i].channel));
+	}
+	
+	// Restart the counters of the generators of each module together
+	for (uint8_t module = 0; module < 2; module++)
+	{
+		if (generator_masks[module])
+		{
+			PWM_Synchronize_Counters(module, generator_masks[module]);
+		}
+	}
+}
+
+void PWM_Set_Duty_Cycle(uint8_t channel, uint16_t duty_cycle)
+{
+	PWM_Write_Duty_Cycle(channel, duty_cycle);
+}
+
+void PWM_Set_Period(uint8_t channel, uint16_t period)
+{
+	PWM_Write_Period(PWM_CHANNEL_MODULE(channel), PWM_CHANNEL_GENERATOR(channel), period);
+}
+
+void PWM_Update_Duty_Cycles(const PWM_Duty_Update *updates, uint8_t num_updates)
+{
+	uint8_t commit_masks[2] = { 0, 0 };
+	
+	for (uint8_t i = 0; i < num_updates; i++)
+	{
+		uint8_t channel = updates[i].channel;
+		uint8_t module = PWM_CHANNEL_MODULE(channel);
+		uint8_t generator = PWM_CHANNEL_GENERATOR(channel);
+		
+		PWM_Write_Duty_Cycle(channel, updates[i].duty_cycle);
+		
+		if (generator_flags[module][generator] & PWM_SYNC_GLOBAL)
+		{
+			commit_masks[module] |= (uint8_t)(1 << generator);
+		}
+	}
+	
+	// Apply all of the globally synchronized updates of a module with one write
+	for (uint8_t module = 0; module < 2; module++)
+	{
+		if (commit_masks[module])
+		{
+			PWM_Commit(module, commit_masks[module]);
+		}
+	}
+}
+
+void PWM_Commit(uint8_t module, uint8_t generator_mask)
+{
+	// Set the GLOBALSYNCn bits (Bits 3 to 0) in the PWMCTL register.
+	// The bits are cleared by the hardware once the updates have been applied
+	PWM_Module(module)->CTL |= (generator_mask & 0x0F);
+}
+
+void PWM_Synchronize_Counters(uint8_t module, uint8_t generator_mask)
+{
+	// Reset the counters by setting the SYNCn bits (Bits 3 to 0) in the PWMSYNC register
+	PWM_Module(module)->SYNC = (generator_mask & 0x0F);
+}
+
+void PWM_Enable_Output(uint8_t channel, uint8_t enable)
+{
+	PWM0_Type *pwm_module = PWM_Module(PWM_CHANNEL_MODULE(channel));
+	uint8_t output_mask = (uint8_t)(1 << (channel % 8));
+	
+	if (enable)
+	{
+		pwm_module->ENABLE |= output_mask;
+	}
+	else
+	{
+		pwm_module->ENABLE &= ~output_mask;
+	}
+}
+
+void PWM_Claim_Pin(uint8_t channel)
+{
+	PWM_Configure_Pin(channel);
+	PWM_Enable_Output(channel, 1);
+}
+
+void PWM_Release_Pin(uint8_t channel)
+{
+	const PWM_Pin *pin = &pwm_pins[channel];
+	
+	PWM_Enable_Output(channel, 0);
+	GPIO_Configure(pin->port, (uint8_t)(1 << pin->pin), GPIO_OUTPUT);
+	
+	// Select the GPIO function again in the PMCx field of the PCTL register
+	pin->port->PCTL &= ~(0xFUL << (pin->pin * 4));
+}
@@ -0,0 +1,237 @@
+/**
+ * @file PWM.h
+ *
+ * @brief Header file for the PWM driver.
+ *
+ * This file contains the function definitions for the PWM driver.
+ * It covers both PWM modules, all four generators of each module and both the A and B
+ * outputs of each generator. The sixteen outputs (MnPWMx) are selected with PWM_Channels
+ * and are routed to the following pins:
+ *  - M0PWM0 (PB6)  M0PWM1 (PB7)  M0PWM2 (PB4)  M0PWM3 (PB5)
+ *  - M0PWM4 (PE4)  M0PWM5 (PE5)  M0PWM6 (PC4)  M0PWM7 (PC5)
+ *  - M1PWM0 (PD0)  M1PWM1 (PD1)  M1PWM2 (PA6)  M1PWM3 (PA7)
+ *  - M1PWM4 (PF0)  M1PWM5 (PF1)  M1PWM6 (PF2)  M1PWM7 (PF3)
+ *
+ * The two outputs of a generator share its counter, so they share the period and the
+ * counting mode. Period and duty cycle values are in PWM clock ticks.
+ *
+ * Register updates are never applied in the middle of a period:
+ *  - Locally synchronized channels (the default) apply a new period or duty cycle
+ *    when their counter reaches zero.
+ *  - Globally synchronized channels (PWM_SYNC_GLOBAL) hold their new values until
+ *    PWM_Commit is called, and then apply them at the next zero of their counter.
+ *    This lets several channels change on the same period boundary.
+ *
+ * @note This driver assumes that the system clock's frequency is 50 MHz.
+ *
+ * @note This driver assumes that the PWM_Clock_Init function has been called
+ * before calling the PWM_Init_Channel function.
+ */
+
+#ifndef PWM_H
+#define PWM_H
+
+#include "TM4C123GH6PM.h"
+
+enum PWM_Channels
+{
+	PWM_M0PWM0 = 0x00,
+	PWM_M0PWM1 = 0x01,
+	PWM_M0PWM2 = 0x02,
+	PWM_M0PWM3 = 0x03,
+	PWM_M0PWM4 = 0x04,
+	PWM_M0PWM5 = 0x05,
+	PWM_M0PWM6 = 0x06,
+	PWM_M0PWM7 = 0x07,
+	PWM_M1PWM0 = 0x08,
+	PWM_M1PWM1 = 0x09,
+	PWM_M1PWM2 = 0x0A,
+	PWM_M1PWM3 = 0x0B,
+	PWM_M1PWM4 = 0x0C,
+	PWM_M1PWM5 = 0x0D,
+	PWM_M1PWM6 = 0x0E,
+	PWM_M1PWM7 = 0x0F
+};
+
+#define PWM_NUM_CHANNELS 16
+
+// Module (0 or 1), generator (0 to 3) and output (0 for A, 1 for B) of a channel
+#define PWM_CHANNEL_MODULE(channel)    ((channel) >> 3)
+#define PWM_CHANNEL_GENERATOR(channel) (((channel) >> 1) & 0x03)
+#define PWM_CHANNEL_OUTPUT(channel)    ((channel) & 0x01)
+
+// Configuration flags of a channel
+enum PWM_Config_Flags
+{
+	PWM_CENTER_ALIGNED = 0x01,
+	PWM_INVERTED       = 0x02,
+	PWM_DEAD_BAND      = 0x04,
+	PWM_SYNC_GLOBAL    = 0x08,
+	PWM_NO_PIN         = 0x10
+};
+
+typedef struct
+{
+	uint8_t channel;
+	uint8_t flags;
+	uint16_t period;
+	uint16_t duty_cycle;
+	
+	// Dead-band delays in PWM clock ticks, used with PWM_DEAD_BAND
+	uint16_t dead_band_rise;
+	uint16_t dead_band_fall;
+} PWM_Channel_Config;
+
+typedef struct
+{
+	uint8_t channel;
+	uint16_t duty_cycle;
+} PWM_Duty_Update;
+
+/**
+ * @brief Initializes a PWM channel.
+ *
+ * This function enables the clocks to the PWM module and the GPIO port of the channel,
+ * routes the output to its pin, and configures the generator with the given period,
+ * counting mode and dead-band. The generator counts down by default, or up and down with
+ * PWM_CENTER_ALIGNED, in which case the pulse is centered on the zero of the counter.
+ *
+ * With PWM_DEAD_BAND, the A output of the generator is used to drive both outputs:
+ * the A output is delayed by dead_band_rise on its rising edge, and the B output is
+ * its complement delayed by dead_band_fall. Only the A channel must be initialized,
+ * and the pin of the B channel is configured as well.
+ *
+ * @param config A pointer to the channel configuration.
+ *
+ * @return None
+ */
+void PWM_Init_Channel(const PWM_Channel_Config *config);
+
+/**
+ * @brief Initializes the PWM channels listed in a table.
+ *
+ * The generators of the channels that share a module are started together, so
+ * their counters stay aligned.
+ *
+ * @param table A pointer to the configuration table.
+ *
+ * @param num_channels The number of entries in the table.
+ *
+ * @return None
+ */
+void PWM_Init_Channels(const PWM_Channel_Config *table, uint8_t num_channels);
+
+/**
+ * @brief Updates the duty cycle of a channel.
+ *
+ * A duty cycle of 0 keeps the output low and a duty cycle equal to or greater than
+ * the period keeps it high.
+ *
+ * @param channel The PWM channel (see PWM_Channels).
+ *
+ * @param duty_cycle The new duty cycle in PWM clock ticks.
+ *
+ * @return None
+ */
+void PWM_Set_Duty_Cycle(uint8_t channel, uint16_t duty_cycle);
+
+/**
+ * @brief Updates the period of the generator of a channel.
+ *
+ * The period is shared by both outputs of the generator. The duty cycles are not
+ * rescaled and must be updated by the caller if needed.
+ *
+ * @param channel The PWM channel (see PWM_Channels).
+ *
+ * @param period The new period in PWM clock ticks.
+ *
+ * @return None
+ */
+void PWM_Set_Period(uint8_t channel, uint16_t period);
+
+/**
+ * @brief Updates the duty cycles of several channels at once.
+ *
+ * This function writes all of the new duty cycles and then commits the globally
+ * synchronized generators of each module with a single write, so that all of the
+ * channels configured with PWM_SYNC_GLOBAL change on the same period boundary.
+ *
+ * @param updates A pointer to the array of updates.
+ *
+ * @param num_updates The number of entries in the array.
+ *
+ * @return None
+ */
+void PWM_Update_Duty_Cycles(const PWM_Duty_Update *updates, uint8_t num_updates);
+
+/**
+ * @brief Applies the pending updates of the globally synchronized generators.
+ *
+ * The updates take effect at the next zero of each generator's counter.
+ *
+ * @param module The PWM module (0 or 1).
+ *
+ * @param generator_mask The generators to update (Bit 0 for Generator 0, ...).
+ *
+ * @return None
+ */
+void PWM_Commit(uint8_t module, uint8_t generator_mask);
+
+/**
+ * @brief Resets the counters of several generators of a module at the same time.
+ *
+ * @param module The PWM module (0 or 1).
+ *
+ * @param generator_mask The generators to synchronize (Bit 0 for Generator 0, ...).
+ *
+ * @return None
+ */
+void PWM_Synchronize_Counters(uint8_t module, uint8_t generator_mask);
+
+/**
+ * @brief Enables or disables the output of a channel.
+ *
+ * A disabled output is held low (or high if the channel is inverted).
+ *
+ * @param channel The PWM channel (see PWM_Channels).
+ *
+ * @param enable 1 to enable the output, or 0 to disable it.
+ *
+ * @return None
+ */
+void PWM_Enable_Output(uint8_t channel, uint8_t enable);
+
+/**
+ * @brief Connects the pin of a channel to the PWM output again.
+ *
+ * This function is used after PWM_Release_Pin, once the pin has been given back by
+ * the driver that used it as GPIO. The channel keeps its period and duty cycle.
+ *
+ * @param channel The PWM channel (see PWM_Channels).
+ *
+ * @return None
+ */
+void PWM_Claim_Pin(uint8_t channel);
+
+/**
+ * @brief Disables the output of a channel and gives its pin back to GPIO.
+ *
+ * The pin is left as a low output. The generator keeps running, so the channel
+ * can be reconnected with PWM_Claim_Pin without being initialized again.
+ *
+ * @param channel The PWM channel (see PWM_Channels).
+ *
+ * @return None
+ */
+void PWM_Release_Pin(uint8_t channel);
+
+/**
+ * @brief Returns the register block of a PWM module.
+ *
+ * @param module The PWM module (0 or 1).
+ *
+ * @return A pointer to PWM0 or PWM1.
+ */
+PWM0_Type *PWM_Module(uint8_t module);
+
+#endif
@@ -5,6 +5,7 @@
  *
  * This file contains the function definitions for the PWM0_0 driver.
  * It uses the Module 0 PWM Generator 0 to generate a PWM signal with the PB6 pin.
+ * It is a thin wrapper around the generic PWM driver.
  *
  * @note This driver assumes that the system clock's frequency is 50 MHz.
  *
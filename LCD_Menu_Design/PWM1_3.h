@@ -5,6 +5,7 @@
  *
  * This file contains the function definitions for the PWM1_3 driver.
  * It uses the Module 1 PWM Generator 3 to generate a PWM signal with the PF2 pin.
+ * It is a thin wrapper around the generic PWM driver.
  *
  * @note This driver assumes that the system clock's frequency is 50 MHz.
  *
@@ -16,6 +16,14 @@
 
 #include "TM4C123GH6PM.h"
 
+// Frequency of the PWM clock in Hz (50 MHz / 16)
+#define PWM_CLOCK_FREQUENCY 3125000
+
+// Convert a time in microseconds or a frequency in Hz to PWM clock ticks.
+// The conversions are evaluated at compile time when their arguments are constants
+#define PWM_US_TO_TICKS(microseconds) ((uint32_t)(((uint64_t)(microseconds) * PWM_CLOCK_FREQUENCY) / 1000000))
+#define PWM_HZ_TO_TICKS(frequency)    ((uint32_t)(PWM_CLOCK_FREQUENCY / (frequency)))
+
 /**
  * @brief Initializes the PWM clock source.
  *
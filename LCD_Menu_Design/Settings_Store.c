@@ -0,0 +1,329 @@
+/**
+ * @file Settings_Store.c
+ *
+ * @brief Source code for the Settings_Store driver.
+ *
+ * This file contains the function definitions for the Settings_Store driver.
+ * It writes the settings records to the EEPROM with a word-by-word state machine.
+ */
+
+#include "Settings_Store.h"
+
+// Record layout (16 words, one EEPROM block)
+#define RECORD_WORDS        16
+#define RECORD_HEADER_WORD  0
+#define RECORD_SEQUENCE     1
+#define RECORD_VALUES       2
+#define RECORD_CRC          15
+
+// Header: magic number (Bits 31 to 16) and number of settings (Bits 7 to 0)
+#define RECORD_MAGIC        0x53540000
+
+// WORKING bit (Bit 0) of the EEDONE register
+#define EEDONE_WORKING      0x01
+
+enum Settings_Write_States
+{
+	SETTINGS_IDLE     = 0x00,
+	SETTINGS_PENDING  = 0x01,
+	SETTINGS_WRITING  = 0x02
+};
+
+static const Settings_Definition *settings_definitions = 0;
+static uint8_t settings_count = 0;
+
+// Values of the last record written or loaded, and the values
+// seen by the last call to Settings_Store_Process while a write is pending
+static int32_t saved_values[SETTINGS_MAX_SETTINGS];
+static int32_t pending_values[SETTINGS_MAX_SETTINGS];
+
+// Record being written, and the position of the next word to write
+static uint32_t record[RECORD_WORDS];
+static uint8_t record_word = 0;
+
+static uint8_t write_state = SETTINGS_IDLE;
+static uint32_t last_change_ms = 0;
+static uint32_t sequence = 0;
+static uint8_t next_block = SETTINGS_FIRST_BLOCK;
+
+volatile uint32_t Settings_Writes = 0;
+
+static uint32_t Settings_CRC32(const uint32_t *words, uint8_t num_words)
+{
+	// CRC-32 (polynomial 0xEDB88320) computed 4 bits at a time
+	static const uint32_t crc_table[16] =
+	{
+		0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+		0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+	};
+	
+	uint32_t crc = 0xFFFFFFFF;
+	
+	for (uint8_t i = 0; i < num_words; i++)
+	{
+		uint32_t word = words[i];
+		
+		for (uint8_t nibble = 0; nibble < 8; nibble++)
+		{
+			crc = (crc >> 4) ^ crc_table[(crc ^ word) & 0x0F];
+			word >>= 4;
+		}
+	}
+	
+	return ~crc;
+}
+
+static void Settings_Wait_EEPROM(void)
+{
+	while (EEPROM->EEDONE & EEDONE_WORKING);
+}
+
+static void Settings_EEPROM_Init(void)
+{
+	// Enable the clock to the EEPROM module by setting the
+	// R0 bit (Bit 0) in the RCGCEEPROM register
+	SYSCTL->RCGCEEPROM |= 0x01;
+	while ((SYSCTL->PREEPROM & 0x01) == 0);
+	
+	// Wait for the EEPROM to finish its power-on initialization
+	Settings_Wait_EEPROM();
+	
+	// Reset the module if a previous operation failed, as recommended by the datasheet
+	// (PRETRY and ERETRY bits, Bits 3 and 2 of the EESUPP register)
+	if (EEPROM->EESUPP & 0x0C)
+	{
+		SYSCTL->SREEPROM |= 0x01;
+		SYSCTL->SREEPROM &= ~0x01;
+		while ((SYSCTL->PREEPROM & 0x01) == 0);
+		Settings_Wait_EEPROM();
+	}
+}
+
+static void Settings_Apply_Defaults(void)
+{
+	for (uint8_t i = 0; i < settings_count; i++)
+	{
+		*settings_definitions[i].value = settings_definitions[i].default_value;
+	}
+}
+
+static uint8_t Settings_Changed(void)
+{
+	for (uint8_t i = 0; i < settings_count; i++)
+	{
+		if (*settings_definitions[i].value != saved_values[i])
+		{
+			return 1;
+		}
+	}
+	
+	return 0;
+}
+
+uint8_t Settings_Store_Init(const Settings_Definition *definitions, uint8_t num_settings)
+{
+	uint32_t block_words[RECORD_WORDS];
+	uint8_t found = 0;
+	
+	settings_definitions = definitions;
+	settings_count = (num_settings > SETTINGS_MAX_SETTINGS) ? SETTINGS_MAX_SETTINGS : num_settings;
+	write_state = SETTINGS_IDLE;
+	
+	Settings_Apply_Defaults();
+	Settings_EEPROM_Init();
+	
+	// Read every block of the store once and keep the newest valid record
+	for (uint8_t block = SETTINGS_FIRST_BLOCK; block < (SETTINGS_FIRST_BLOCK + SETTINGS_NUM_BLOCKS); block++)
+	{
+		EEPROM->EEBLOCK = block;
+		EEPROM->EEOFFSET = 0;
+		
+		for (uint8_t i = 0; i < RECORD_WORDS; i++)
+		{
+			block_words[i] = EEPROM->EERDWRINC;
+		}
+		
+		if (((block_words[RECORD_HEADER_WORD] & 0xFFFF0000) != RECORD_MAGIC) ||
+		    (block_words[RECORD_CRC] != Settings_CRC32(block_words, RECORD_CRC)))
+		{
+			continue;
+		}
+		
+		if (!found || ((int32_t)(block_words[RECORD_SEQUENCE] - sequence) > 0))
+		{
+			found = 1;
+			sequence = block_words[RECORD_SEQUENCE];
+			next_block = (block + 1 < SETTINGS_FIRST_BLOCK + SETTINGS_NUM_BLOCKS) ? (block + 1) : SETTINGS_FIRST_BLOCK;
+			
+			for (uint8_t i = 0; i < RECORD_WORDS; i++)
+			{
+				record[i] = block_words[i];
+			}
+		}
+	}
+	
+	if (found)
+	{
+		// Load the settings stored in the record. Settings added since the record
+		// was written, or whose value is out of range, keep their default value
+		uint8_t stored_count = (uint8_t)(record[RECORD_HEADER_WORD] & 0xFF);
+		
+		for (uint8_t i = 0; (i < settings_count) && (i < stored_count); i++)
+		{
+			int32_t value = (int32_t)record[RECORD_VALUES + i];
+			
+			if ((value >= settings_definitions[i].min) && (value <= settings_definitions[i].max))
+			{
+				*settings_definitions[i].value = value;
+			}
+		}
+	}
+	
+	for (uint8_t i = 0; i < settings_count; i++)
+	{
+		saved_values[i] = *settings_definitions[i].value;
+	}
+	
+	return found;
+}
+
+uint8_t Settings_Store_Set(uint8_t key, int32_t value)
+{
+	if ((key >= settings_count) || (value < settings_definitions[key].min) || (value > settings_definitions[key].max))
+	{
+		return 0;
+	}
+	
+	*settings_definitions[key].value = value;
+	
+	return 1;
+}
+
+static void Settings_Start_Record(void)
+{
+	sequence++;
+	
+	for (uint8_t i = 0; i < RECORD_WORDS; i++)
+	{
+		record[i] = 0xFFFFFFFF;
+	}
+	
+	record[RECORD_HEADER_WORD] = RECORD_MAGIC | settings_count;
+	record[RECORD_SEQUENCE] = sequence;
+	
+	for (uint8_t i = 0; i < settings_count; i++)
+	{
+		saved_values[i] = *settings_definitions[i].value;
+		record[RECORD_VALUES + i] = (uint32_t)saved_values[i];
+	}
+	
+	record[RECORD_CRC] = Settings_CRC32(record, RECORD_CRC);
+	record_word = 0;
+	
+	EEPROM->EEBLOCK = next_block;
+	EEPROM->EEOFFSET = 0;
+	
+	write_state = SETTINGS_WRITING;
+}
+
+static void Settings_Write_Next_Word(void)
+{
+	// The CRC is the last word written, so a record interrupted
+	// by a reset is never mistaken for a valid one
+	EEPROM->EERDWRINC = record[record_word++];
+	
+	if (record_word == RECORD_WORDS)
+	{
+		next_block = (next_block + 1 < SETTINGS_FIRST_BLOCK + SETTINGS_NUM_BLOCKS) ? (next_block + 1) : SETTINGS_FIRST_BLOCK;
+		write_state = SETTINGS_IDLE;
+		Settings_Writes++;
+	}
+}
+
+void Settings_Store_Process(uint32_t now_ms)
+{
+	switch (write_state)
+	{
+		case SETTINGS_IDLE:
+		{
+			if (Settings_Changed())
+			{
+				for (uint8_t i = 0; i < settings_count; i++)
+				{
+					pending_values[i] = *settings_definitions[i].value;
+				}
+				
+				write_state = SETTINGS_PENDING;
+				last_change_ms = now_ms;
+			}
+			break;
+		}
+		
+		case SETTINGS_PENDING:
+		{
+			// Restart the delay on every change so that bursts of changes produce a single record
+			uint8_t changed = 0;
+			
+			for (uint8_t i = 0; i < settings_count; i++)
+			{
+				if (*settings_definitions[i].value != pending_values[i])
+				{
+					pending_values[i] = *settings_definitions[i].value;
+					changed = 1;
+				}
+			}
+			
+			if (changed)
+			{
+				last_change_ms = now_ms;
+			}
+			else if (!Settings_Changed())
+			{
+				// The settings were changed back to their saved values
+				write_state = SETTINGS_IDLE;
+			}
+			else if ((now_ms - last_change_ms) >= SETTINGS_FLUSH_DELAY_MS)
+			{
+				Settings_Start_Record();
+			}
+			break;
+		}
+		
+		case SETTINGS_WRITING:
+		{
+			// Write the next word once the EEPROM has finished the previous one
+			if (!(EEPROM->EEDONE & EEDONE_WORKING))
+			{
+				Settings_Write_Next_Word();
+			}
+			break;
+		}
+		
+		default:
+		{
+			write_state = SETTINGS_IDLE;
+			break;
+		}
+	}
+}
+
+void Settings_Store_Flush(void)
+{
+	if ((write_state != SETTINGS_WRITING) && Settings_Changed())
+	{
+		Settings_Start_Record();
+	}
+	
+	while (write_state == SETTINGS_WRITING)
+	{
+		Settings_Wait_EEPROM();
+		Settings_Write_Next_Word();
+	}
+	
+	Settings_Wait_EEPROM();
+}
+
+void Settings_Store_Reset(void)
+{
+	Settings_Apply_Defaults();
+}
@@ -0,0 +1,115 @@
+/**
+ * @file Settings_Store.h
+ *
+ * @brief Header file for the Settings_Store driver.
+ *
+ * This file contains the function definitions for the Settings_Store driver.
+ * It keeps application settings in the 2 KB EEPROM of the TM4C123GH6PM across resets.
+ *
+ * Each setting is an int32_t variable of the application, described in a table with its
+ * default value and valid range. The variables themselves are the RAM cache: reading a setting
+ * is a plain variable access. Settings_Store_Process detects changed variables, waits until
+ * they have not changed for SETTINGS_FLUSH_DELAY_MS so that bursts of changes are coalesced
+ * into one record, and then writes the record one word at a time without blocking.
+ *
+ * A record fills one 64-byte EEPROM block and holds every setting, a sequence number and a
+ * CRC-32. Successive records are written to successive blocks, which spreads the wear over
+ * SETTINGS_NUM_BLOCKS blocks. At boot, all of the blocks are read in one pass and the valid
+ * record with the highest sequence number is loaded. A record interrupted by a reset fails its
+ * CRC, so the previous record is used instead.
+ *
+ * @note For more information regarding the EEPROM, refer to the "Internal Memory" chapter
+ * of the TM4C123GH6PM Microcontroller Datasheet.
+ * Link: https://www.ti.com/lit/ds/symlink/tm4c123gh6pm.pdf
+ */
+
+#ifndef SETTINGS_STORE_H
+#define SETTINGS_STORE_H
+
+#include "TM4C123GH6PM.h"
+
+// EEPROM blocks used by the store (each block holds one record)
+#define SETTINGS_FIRST_BLOCK 0
+#define SETTINGS_NUM_BLOCKS 16
+
+// Maximum number of settings in a record
+#define SETTINGS_MAX_SETTINGS 13
+
+// Time in milliseconds without changes before the settings are written
+#define SETTINGS_FLUSH_DELAY_MS 2000
+
+typedef struct
+{
+	// Application variable holding the value of the setting
+	int32_t *value;
+	int32_t default_value;
+	int32_t min;
+	int32_t max;
+} Settings_Definition;
+
+// Number of records written since reset
+extern volatile uint32_t Settings_Writes;
+
+/**
+ * @brief Initializes the EEPROM and loads the settings.
+ *
+ * This function enables the EEPROM module, reads all of the store's blocks in one pass and
+ * loads the newest valid record into the application variables. Settings that are missing
+ * or out of range are set to their default values. The position of a setting in the table is
+ * its key, so new settings must be added at the end of the table.
+ *
+ * @param definitions A pointer to the table of settings.
+ *
+ * @param num_settings The number of entries in the table (at most SETTINGS_MAX_SETTINGS).
+ *
+ * @return 1 if a valid record was loaded, or 0 if the defaults are used.
+ */
+uint8_t Settings_Store_Init(const Settings_Definition *definitions, uint8_t num_settings);
+
+/**
+ * @brief Changes a setting.
+ *
+ * The value is written to the application variable if it is in range. It is saved
+ * to the EEPROM later by Settings_Store_Process.
+ *
+ * @param key The position of the setting in the table.
+ *
+ * @param value The new value.
+ *
+ * @return 1 if the value was accepted, or 0 if it is out of range.
+ */
+uint8_t Settings_Store_Set(uint8_t key, int32_t value);
+
+/**
+ * @brief Saves the changed settings in the background.
+ *
+ * This function must be called from the main loop. It returns immediately, and writes
+ * at most one EEPROM word per call.
+ *
+ * @param now_ms The current time in milliseconds.
+ *
+ * @return None
+ */
+void Settings_Store_Process(uint32_t now_ms);
+
+/**
+ * @brief Writes the changed settings immediately.
+ *
+ * This function blocks until the record has been written, e.g. before a reset.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Settings_Store_Flush(void);
+
+/**
+ * @brief Restores the default value of every setting.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Settings_Store_Reset(void);
+
+#endif
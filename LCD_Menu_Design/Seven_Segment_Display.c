@@ -12,6 +12,10 @@
  */
  
 #include "Seven_Segment_Display.h"
+#include "GPIO.h"
+
+// SSI2 Slave Select pin (PC7)
+static const GPIO_Pin SSI2_SS_PIN = { GPIOC, 0x80 };
 
 // Values used to represent numbers on the Seven-Segment Display module
 const uint8_t number_pattern[16] =
@@ -34,6 +38,41 @@ const uint8_t number_pattern[16] =
 	0x8E  // F
 };
 
+// Values used to represent letters on the Seven-Segment Display module,
+// where 0 marks the letters that cannot be drawn
+const uint8_t letter_pattern[26] =
+{
+	0x88, // A
+	0x83, // b
+	0xC6, // C
+	0xA1, // d
+	0x86, // E
+	0x8E, // F
+	0xC2, // G
+	0x89, // H
+	0xCF, // I
+	0xE1, // J
+	0x00, // K
+	0xC7, // L
+	0x00, // M
+	0xAB, // n
+	0xA3, // o
+	0x8C, // P
+	0x98, // q
+	0xAF, // r
+	0x92, // S
+	0x87, // t
+	0xC1, // U
+	0x00, // V
+	0x00, // W
+	0x00, // X
+	0x91, // y
+	0xA4  // Z
+};
+
+// Pattern of the characters that cannot be drawn (segments a, d and g)
+#define SEVEN_SEGMENT_UNKNOWN 0xB6
+
 void Seven_Segment_Display_Init(void)
 {
 	// Enable the clock to Port B (Bit 1)
@@ -58,17 +97,8 @@ void Seven_Segment_Display_Init(void)
 	GPIOB->DEN |= 0x90;
 
 	// Set PC7 as an output GPIO pin for SSI2 Slave Select (SSI2 SS)
-	// Note: Slave Select pin is active low
-	GPIOC->DIR |= 0x80;
-
-	// Configure PC7 (SSI2 SS) to function as a GPIO pin
-	GPIOC->AFSEL &= ~0x80;
-
-	// Enable digital functionality for PC7 (SSI2 SS)
-	GPIOC->DEN |= 0x80;
-
-	// Initialize the output of PC7 (SSI2 SS) to high
-	GPIOC->DATA |= 0x80;
+	// initialized to high. Note: Slave Select pin is active low
+	GPIO_Configure(GPIOC, 0x80, GPIO_OUTPUT | GPIO_INIT_HIGH);
 
 	// Disable SSI2 during configuration
 	SSI2->CR1 = 0;
@@ -95,9 +125,8 @@ void Seven_Segment_Display_Init(void)
 
 void SSI2_Write(uint8_t data)
 {
-	// Assert the slave select pin by clearing Bit 7
-	// of the DATA register for Port C
-	GPIOC->DATA &= ~0x80;
+	// Assert the slave select pin (PC7)
+	GPIO_Clear(SSI2_SS_PIN);
 
 	// Write the data to the SSI Data Register (SSIDR)
 	SSI2->DR = data;
@@ -106,9 +135,54 @@ void SSI2_Write(uint8_t data)
 	// the BSY bit of the SSI Status Register (SSISR)
 	while (SSI2->SR & 0x10);
 
-	// Deassert the slave select pin by setting Bit 7
-	// of the DATA register for Port C
-	GPIOC->DATA |= 0x80;
+	// Deassert the slave select pin (PC7)
+	GPIO_Set(SSI2_SS_PIN);
+}
+
+void Seven_Segment_Display_Digit(uint8_t digit, uint8_t pattern)
+{
+	// The segment pattern is shifted out first, followed by the digit select bits
+	SSI2_Write(pattern);
+	SSI2_Write((uint8_t)(1 << (digit & 0x03)));
+}
+
+void Seven_Segment_Display_Blank(void)
+{
+	// Select every digit with all of its segments off
+	SSI2_Write(0xFF);
+	SSI2_Write(0x0F);
+}
+
+uint8_t Seven_Segment_Display_Pattern(char character)
+{
+	if ((character >= '0') && (character <= '9'))
+	{
+		return number_pattern[character - '0'];
+	}
+
+	// Fold lowercase letters onto the uppercase ones
+	if ((character >= 'a') && (character <= 'z'))
+	{
+		character = (char)(character - 'a' + 'A');
+	}
+
+	if ((character >= 'A') && (character <= 'Z'))
+	{
+		uint8_t pattern = letter_pattern[character - 'A'];
+		return (pattern != 0) ? pattern : SEVEN_SEGMENT_UNKNOWN;
+	}
+
+	switch (character)
+	{
+		case ' ':  return SEVEN_SEGMENT_BLANK;
+		case '-':  return 0xBF;
+		case '_':  return 0xF7;
+		case '=':  return 0xB7;
+		case '?':  return 0xAC;
+		case '\'': return 0xDF;
+		case '"':  return 0xDD;
+		default:   return SEVEN_SEGMENT_UNKNOWN;
+	}
 }
 
 int Count_Digits(int value)
@@ -14,8 +14,14 @@
 #include "TM4C123GH6PM.h"
 #include "SysTick_Delay.h"
 
+// Segment bits of a pattern, active low (bit 0 is segment a, bit 6 is segment g)
+#define SEVEN_SEGMENT_DP    0x80
+#define SEVEN_SEGMENT_BLANK 0xFF
+
 extern const uint8_t number_pattern[16];
 
+extern const uint8_t letter_pattern[26];
+
 /**
  * @brief Initializes the Seven-Segment Display module on the EduBase board.
  *
@@ -44,6 +50,43 @@ void Seven_Segment_Display_Init(void);
  */
 void SSI2_Write(uint8_t data);
 
+/**
+ * @brief Lights one digit of the Seven-Segment Display module.
+ *
+ * The other digits are turned off, so the four digits are shown by calling this function
+ * for each of them in turn, at least every few milliseconds.
+ *
+ * @param digit The position of the digit (0 for the rightmost digit to 3).
+ *
+ * @param pattern The segments to light, active low (e.g. an entry of number_pattern).
+ *
+ * @return None
+ */
+void Seven_Segment_Display_Digit(uint8_t digit, uint8_t pattern);
+
+/**
+ * @brief Turns off every digit of the Seven-Segment Display module.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Seven_Segment_Display_Blank(void);
+
+/**
+ * @brief Returns the segment pattern of a character.
+ *
+ * Digits use number_pattern and letters use letter_pattern, in upper or lower case as they can
+ * be drawn (e.g. "b" and "d"). Letters that cannot be drawn on seven segments (K, M, V, W and X)
+ * and other unsupported characters are shown as three horizontal bars. The decimal point
+ * is not lit, and can be added by clearing SEVEN_SEGMENT_DP.
+ *
+ * @param character The character to display.
+ *
+ * @return The segments to light, active low.
+ */
+uint8_t Seven_Segment_Display_Pattern(char character);
+
 /**
  * @brief Counts the number of digits in an integer value.
  *
@@ -0,0 +1,173 @@
+/**
+ * @file Seven_Segment_Marquee.c
+ *
+ * @brief Source code for the Seven_Segment_Marquee driver.
+ *
+ * This file contains the function definitions for the Seven_Segment_Marquee driver.
+ * The patterns are kept in a ring buffer, and the scroll position counts the patterns
+ * that have moved onto the display, so the rightmost digit shows the pattern just before it.
+ * A shown text is kept at the start of the buffer followed by a blank gap, and the scroll
+ * position wraps around both.
+ */
+
+#include "Seven_Segment_Marquee.h"
+#include "Seven_Segment_Display.h"
+#include "GPTM.h"
+#include "Interrupt_Config.h"
+
+static volatile uint8_t patterns[SEVEN_SEGMENT_MARQUEE_SIZE];
+
+// Patterns written and patterns scrolled onto the display, as free-running counters
+static volatile uint32_t written = 0;
+static volatile uint32_t shown = 0;
+
+// Length of a shown text with its gap, or 0 while the characters are appended
+static volatile uint32_t loop_length = 0;
+static volatile uint8_t scrolling = 0;
+
+static int8_t marquee_timer = -1;
+static uint32_t step_ticks = 1;
+static uint32_t tick_count = 0;
+static uint8_t refresh_digit = 0;
+
+// Lights the next digit, and scrolls the text once per step
+static void Seven_Segment_Marquee_Refresh(void)
+{
+	uint32_t position = shown;
+	uint8_t pattern = SEVEN_SEGMENT_BLANK;
+
+	if (loop_length != 0)
+	{
+		pattern = patterns[(position + loop_length - 1 - refresh_digit) % loop_length];
+	}
+	else if (position > refresh_digit)
+	{
+		pattern = patterns[(position - 1 - refresh_digit) & (SEVEN_SEGMENT_MARQUEE_SIZE - 1)];
+	}
+
+	Seven_Segment_Display_Digit(refresh_digit, pattern);
+	refresh_digit = (refresh_digit + 1) & (SEVEN_SEGMENT_MARQUEE_DIGITS - 1);
+
+	tick_count++;
+
+	if (tick_count >= step_ticks)
+	{
+		tick_count = 0;
+
+		if (loop_length != 0)
+		{
+			if (scrolling)
+			{
+				shown = (position + 1) % loop_length;
+			}
+		}
+		else if (position != written)
+		{
+			shown = position + 1;
+		}
+	}
+}
+
+uint8_t Seven_Segment_Marquee_Start(uint32_t step_ms)
+{
+	step_ticks = (step_ms * SEVEN_SEGMENT_MARQUEE_REFRESH_HZ) / 1000;
+
+	if (step_ticks == 0)
+	{
+		step_ticks = 1;
+	}
+
+	if (marquee_timer < 0)
+	{
+		marquee_timer = GPTM_Allocate(0);
+
+		if (marquee_timer < 0) return 0;
+	}
+
+	tick_count = 0;
+
+	return GPTM_Start_Periodic((uint8_t)marquee_timer, SEVEN_SEGMENT_MARQUEE_REFRESH_HZ,
+	                           &Seven_Segment_Marquee_Refresh, INTERRUPT_MARQUEE);
+}
+
+void Seven_Segment_Marquee_Stop(void)
+{
+	if (marquee_timer >= 0)
+	{
+		GPTM_Release((uint8_t)marquee_timer);
+		marquee_timer = -1;
+	}
+
+	Seven_Segment_Display_Blank();
+}
+
+void Seven_Segment_Marquee_Show(const char *text)
+{
+	uint32_t length = 0;
+
+	// The timer must not show the text while it is being converted
+	uint32_t basepri = Interrupt_Lock(INTERRUPT_LEVEL_MARQUEE);
+
+	for (; (*text != '\0') && (length < (SEVEN_SEGMENT_MARQUEE_SIZE - SEVEN_SEGMENT_MARQUEE_DIGITS)); text++)
+	{
+		if ((*text == '.') && (length > 0) && (patterns[length - 1] & SEVEN_SEGMENT_DP))
+		{
+			patterns[length - 1] &= ~SEVEN_SEGMENT_DP;
+		}
+		else
+		{
+			patterns[length++] = (*text == '.') ? (SEVEN_SEGMENT_BLANK & ~SEVEN_SEGMENT_DP) : Seven_Segment_Display_Pattern(*text);
+		}
+	}
+
+	// A text that fits is shown from the leftmost digit, and a longer one
+	// scrolls in from the right, followed by a blank display
+	scrolling = (length > SEVEN_SEGMENT_MARQUEE_DIGITS);
+	loop_length = scrolling ? (length + SEVEN_SEGMENT_MARQUEE_DIGITS) : SEVEN_SEGMENT_MARQUEE_DIGITS;
+
+	for (uint32_t i = length; i < loop_length; i++)
+	{
+		patterns[i] = SEVEN_SEGMENT_BLANK;
+	}
+
+	shown = 0;
+	written = 0;
+
+	Interrupt_Unlock(INTERRUPT_LEVEL_MARQUEE, basepri);
+}
+
+void Seven_Segment_Marquee_Append(char character)
+{
+	if (loop_length != 0)
+	{
+		Seven_Segment_Marquee_Clear();
+	}
+
+	uint32_t last = (written - 1) & (SEVEN_SEGMENT_MARQUEE_SIZE - 1);
+
+	// A decimal point is lit on the last character, even if it is already shown
+	if ((character == '.') && (written > 0) && (patterns[last] & SEVEN_SEGMENT_DP))
+	{
+		patterns[last] &= ~SEVEN_SEGMENT_DP;
+		return;
+	}
+
+	// Keep the patterns that are on the display
+	if ((written - shown) >= (SEVEN_SEGMENT_MARQUEE_SIZE - SEVEN_SEGMENT_MARQUEE_DIGITS)) return;
+
+	patterns[written & (SEVEN_SEGMENT_MARQUEE_SIZE - 1)] =
+		(character == '.') ? (SEVEN_SEGMENT_BLANK & ~SEVEN_SEGMENT_DP) : Seven_Segment_Display_Pattern(character);
+	written = written + 1;
+}
+
+void Seven_Segment_Marquee_Clear(void)
+{
+	uint32_t basepri = Interrupt_Lock(INTERRUPT_LEVEL_MARQUEE);
+
+	loop_length = 0;
+	scrolling = 0;
+	written = 0;
+	shown = 0;
+
+	Interrupt_Unlock(INTERRUPT_LEVEL_MARQUEE, basepri);
+}
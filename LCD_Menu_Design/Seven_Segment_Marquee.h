@@ -0,0 +1,91 @@
+/**
+ * @file Seven_Segment_Marquee.h
+ *
+ * @brief Header file for the Seven_Segment_Marquee driver.
+ *
+ * This file contains the function definitions for the Seven_Segment_Marquee driver.
+ * It scrolls text across the four digits of the Seven-Segment Display module from a
+ * timer interrupt, so the main loop never redraws the display.
+ *
+ * A timer allocated from the GPTM driver lights one digit on every interrupt, at
+ * SEVEN_SEGMENT_MARQUEE_REFRESH_HZ, and moves the text one digit to the left at a fixed
+ * step. The text is kept as segment patterns (see Seven_Segment_Display_Pattern), and a
+ * '.' lights the decimal point of the character before it instead of taking a digit.
+ *
+ * The text is shown in one of two ways:
+ *  - Seven_Segment_Marquee_Show    The text scrolls through the display, followed by a blank
+ *                                  display, and starts again (a text that fits is not scrolled)
+ *  - Seven_Segment_Marquee_Append  The characters are queued and scroll in from the right one
+ *                                  at a time, and the last four stay on the display (e.g. for
+ *                                  the decoded Morse text)
+ *
+ * @note Seven_Segment_Display_Init must be called before the marquee is started.
+ */
+
+#ifndef SEVEN_SEGMENT_MARQUEE_H
+#define SEVEN_SEGMENT_MARQUEE_H
+
+#include "TM4C123GH6PM.h"
+
+// Number of digits of the display, and digit refresh rate (each digit is lit at a quarter of it)
+#define SEVEN_SEGMENT_MARQUEE_DIGITS 4
+#define SEVEN_SEGMENT_MARQUEE_REFRESH_HZ 1000
+
+// Number of patterns that can be held (must be a power of two)
+#define SEVEN_SEGMENT_MARQUEE_SIZE 64
+
+// Default time between two steps of the scrolling
+#define SEVEN_SEGMENT_MARQUEE_STEP_MS 300
+
+/**
+ * @brief Allocates a timer and starts refreshing and scrolling the display.
+ *
+ * @param step_ms The time between two steps of the scrolling in milliseconds.
+ *
+ * @return 1 if the marquee was started, or 0 if no timer is free.
+ */
+uint8_t Seven_Segment_Marquee_Start(uint32_t step_ms);
+
+/**
+ * @brief Releases the timer and turns off the display.
+ *
+ * The text is kept, and is shown again by Seven_Segment_Marquee_Start.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Seven_Segment_Marquee_Stop(void);
+
+/**
+ * @brief Scrolls a text through the display repeatedly.
+ *
+ * @param text The text, which is copied. Only the first SEVEN_SEGMENT_MARQUEE_SIZE - 4
+ *             characters are shown.
+ *
+ * @return None
+ */
+void Seven_Segment_Marquee_Show(const char *text);
+
+/**
+ * @brief Queues a character, which scrolls in from the right after the queued ones.
+ *
+ * A text shown by Seven_Segment_Marquee_Show is cleared first. The character is dropped
+ * if the queue is full.
+ *
+ * @param character The character, or '.' to light the decimal point of the last character.
+ *
+ * @return None
+ */
+void Seven_Segment_Marquee_Append(char character);
+
+/**
+ * @brief Clears the text.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Seven_Segment_Marquee_Clear(void);
+
+#endif
@@ -0,0 +1,72 @@
+/**
+ * @file Stack_Monitor.c
+ *
+ * @brief Source code for the Stack_Monitor driver.
+ *
+ * This file contains the function definitions for the Stack_Monitor driver.
+ * The top of the stack is read from the first entry of the vector table, so the driver
+ * does not depend on the symbols of the startup file. The stack grows down from the top,
+ * so the scan starts at the bottom and stops at the first overwritten word.
+ */
+
+#include "Stack_Monitor.h"
+
+// Time between two scans of the stack
+#define STACK_MONITOR_PERIOD_MS 1000
+
+static uint32_t *stack_bottom = 0;
+static uint32_t *stack_top = 0;
+static uint32_t last_scan_ms = 0;
+
+volatile uint32_t Stack_Max_Used = 0;
+volatile uint32_t Stack_Min_Free = STACK_MONITOR_SIZE;
+volatile uint32_t Stack_Overflowed = 0;
+
+void Stack_Monitor_Init(void)
+{
+	// The first entry of the vector table (at address 0) is the initial stack pointer
+	stack_top = (uint32_t *)(*(volatile uint32_t *)0x00000000);
+	stack_bottom = stack_top - (STACK_MONITOR_SIZE / 4);
+
+	// Paint from the bottom up to a margin below the current frame
+	uint32_t *limit = (uint32_t *)__get_MSP() - STACK_MONITOR_MARGIN;
+
+	for (uint32_t *word = stack_bottom; word < limit; word++)
+	{
+		*word = STACK_MONITOR_PATTERN;
+	}
+}
+
+uint32_t Stack_Monitor_High_Water(void)
+{
+	uint32_t *word = stack_bottom;
+
+	if (word == 0) return 0;
+
+	while ((word < stack_top) && (*word == STACK_MONITOR_PATTERN))
+	{
+		word++;
+	}
+
+	return (uint32_t)(stack_top - word) * 4;
+}
+
+void Stack_Monitor_Process(uint32_t now_ms)
+{
+	if ((now_ms - last_scan_ms) < STACK_MONITOR_PERIOD_MS) return;
+
+	last_scan_ms = now_ms;
+
+	uint32_t used = Stack_Monitor_High_Water();
+
+	if (used > Stack_Max_Used)
+	{
+		Stack_Max_Used = used;
+		Stack_Min_Free = STACK_MONITOR_SIZE - used;
+	}
+
+	if ((stack_bottom != 0) && (*stack_bottom != STACK_MONITOR_PATTERN))
+	{
+		Stack_Overflowed = 1;
+	}
+}
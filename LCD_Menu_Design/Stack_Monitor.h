@@ -0,0 +1,68 @@
+/**
+ * @file Stack_Monitor.h
+ *
+ * @brief Header file for the Stack_Monitor driver.
+ *
+ * This file contains the function definitions for the Stack_Monitor driver.
+ * It paints the unused part of the main stack with a known pattern at boot, and later
+ * finds the lowest word that was overwritten, which is the deepest the stack has grown
+ * (high-water mark) including nested interrupts.
+ *
+ * The worst case that can happen is computed on the host by Tools/stack_depth.py from the
+ * static call graph of the linker, so that STACK_MONITOR_SIZE (Stack_Size in the startup file)
+ * can be sized from both.
+ */
+
+#ifndef STACK_MONITOR_H
+#define STACK_MONITOR_H
+
+#include "TM4C123GH6PM.h"
+
+// Size of the main stack in bytes, which must match Stack_Size in startup_TM4C123.s
+#define STACK_MONITOR_SIZE 0x800
+
+// Words of the current frame that are not painted by Stack_Monitor_Init
+#define STACK_MONITOR_MARGIN 16
+
+#define STACK_MONITOR_PATTERN 0xC5C5C5C5UL
+
+// Deepest stack usage and smallest free space seen by Stack_Monitor_Process, in bytes
+extern volatile uint32_t Stack_Max_Used;
+extern volatile uint32_t Stack_Min_Free;
+
+// Set when the lowest word of the stack was overwritten, so the stack may have overflowed
+extern volatile uint32_t Stack_Overflowed;
+
+/**
+ * @brief Paints the unused part of the main stack.
+ *
+ * This function must be called at the start of main, before the stack has been used
+ * by the interrupts.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Stack_Monitor_Init(void);
+
+/**
+ * @brief Finds the high-water mark of the main stack.
+ *
+ * @param None
+ *
+ * @return The deepest stack usage since Stack_Monitor_Init in bytes.
+ */
+uint32_t Stack_Monitor_High_Water(void);
+
+/**
+ * @brief Updates Stack_Max_Used, Stack_Min_Free and Stack_Overflowed once per second.
+ *
+ * This function is called from the main loop.
+ *
+ * @param now_ms The current time in milliseconds.
+ *
+ * @return None
+ */
+void Stack_Monitor_Process(uint32_t now_ms);
+
+#endif
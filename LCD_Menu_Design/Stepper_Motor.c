@@ -15,6 +15,12 @@
  */
 
 #include "Stepper_Motor.h"
+#include "GPIO.h"
+
+// Coils energized at each full step, on PB0 to PB3
+static const uint8_t step_sequence[4] = { 0x03, 0x06, 0x0C, 0x09 };
+
+static uint8_t step_index = 0;
  
 void Stepper_Motor_Init()
 {
@@ -54,3 +60,18 @@ void Stepper_Motor_Init()
 	// by setting Bits 3 to 2 in the DATA register
 	GPIOF->DATA |= 0x0C;
 }
+
+void Stepper_Motor_Step(int8_t direction)
+{
+	step_index = (uint8_t)((step_index + direction) & 0x03);
+	
+	// Write only PB0 to PB3 through the masked DATA address of Port B
+	GPIO_Write_Bus(GPIOB, 0x0F, step_sequence[step_index]);
+}
+
+void Stepper_Motor_Release(void)
+{
+	// Clear PB0 to PB3, PF2 and PF3 through the masked DATA addresses of Port B and Port F
+	GPIO_Write_Bus(GPIOB, 0x0F, 0x00);
+	GPIO_Write_Bus(GPIOF, 0x0C, 0x00);
+}
@@ -24,3 +24,28 @@
  * @return None
  */
 void Stepper_Motor_Init();
+
+/**
+ * @brief Moves the stepper motor by one full step.
+ *
+ * Two adjacent coils (PB0 to PB3) are energized at a time. The 28BYJ-48 needs about 2 ms
+ * between two steps.
+ *
+ * @param direction 1 to step clockwise, or -1 to step counterclockwise.
+ *
+ * @return None
+ */
+void Stepper_Motor_Step(int8_t direction);
+
+/**
+ * @brief De-energizes the coils of the stepper motor.
+ *
+ * This function drives PB0 to PB3, PF2 and PF3 low, so that the motor draws no current
+ * and the pins can be reconfigured by another driver. Stepper_Motor_Init must be called
+ * before the motor is stepped again.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Stepper_Motor_Release(void);
@@ -0,0 +1,236 @@
+/**
+ * @file Stopwatch.c
+ *
+ * @brief Source code for the Stopwatch driver.
+ *
+ * This file contains the function definitions for the Stopwatch driver.
+ * It claims Wide Timer 2A and 2B from the GPTM driver as free-running 48-bit timers
+ * that capture the edges of SW5 and SW4, and measures the elapsed time and the laps in timer ticks.
+ */
+
+#include "Stopwatch.h"
+#include "Seven_Segment_Display.h"
+#include "GPTM.h"
+#include "Interrupt_Config.h"
+#include <stdio.h>
+
+// The timer and its prescaler extension count over 48 bits
+#define STOPWATCH_MASK 0x0000FFFFFFFFFFFFULL
+
+#define BOUNCE_TICKS ((uint64_t)STOPWATCH_BOUNCE_MS * STOPWATCH_TICKS_PER_MS)
+
+// A press is posted a few milliseconds after its first edge, so an older capture
+// belongs to another press (e.g. one that started before the capture was enabled)
+#define MAX_PRESS_DELAY_TICKS (1000ULL * STOPWATCH_TICKS_PER_MS)
+
+// Hundredths of a second shown as "SS.hh" before the display switches to "MM.SS"
+#define SECONDS_DISPLAY_LIMIT 6000
+
+// Time of the last captured edge, and of the first edge of the current bounce, of each button
+static volatile uint64_t last_edge[2];
+static volatile uint64_t press_edge[2];
+
+static uint8_t running = 0;
+static uint64_t start_ticks = 0;
+static uint64_t accumulated_ticks = 0;
+
+static Stopwatch_Lap laps[STOPWATCH_MAX_LAPS];
+static uint16_t lap_count = 0;
+
+// Segment patterns of the four digits, and the digit written by the next refresh
+static uint8_t display_patterns[4];
+static uint8_t display_digit = 0;
+static uint32_t last_refresh_ms = 0;
+
+static void Stopwatch_Capture(uint8_t button, uint64_t edge)
+{
+	// An edge that follows a quiet period starts a new press or release
+	if (((edge - last_edge[button]) & STOPWATCH_MASK) >= BOUNCE_TICKS)
+	{
+		press_edge[button] = edge;
+	}
+
+	last_edge[button] = edge;
+}
+
+static void Stopwatch_Capture_Start_Stop(uint64_t edge)
+{
+	Stopwatch_Capture(0, edge);
+}
+
+static void Stopwatch_Capture_Lap_Reset(uint64_t edge)
+{
+	Stopwatch_Capture(1, edge);
+}
+
+void Stopwatch_Init(void)
+{
+	// Enable the clock to Port D
+	SYSCTL->RCGCGPIO |= 0x08;
+
+	// Assign PD0 and PD1 to WT2CCP0 and WT2CCP1 (PCTL encoding 7).
+	// The pins stay digital inputs with their pull-down resistors
+	GPIOD->AFSEL |= 0x03;
+	GPIOD->PCTL = (GPIOD->PCTL & ~0x000000FF) | 0x00000077;
+	GPIOD->DEN |= 0x03;
+
+	// Wide Timer 2 is the only timer whose CCP pins are PD0 and PD1
+	if (!GPTM_Claim(GPTM_WTIMER2A, 0) || !GPTM_Claim(GPTM_WTIMER2B, 0)) return;
+
+	GPTM_Start_Capture(GPTM_WTIMER2A, GPTM_RISING_EDGE, &Stopwatch_Capture_Start_Stop, INTERRUPT_STOPWATCH_START);
+	GPTM_Start_Capture(GPTM_WTIMER2B, GPTM_RISING_EDGE, &Stopwatch_Capture_Lap_Reset, INTERRUPT_STOPWATCH_LAP);
+
+	// Restart both halves on the same cycle, so that they count in step
+	// and a time captured by one half can be compared with the other
+	GPTM_Synchronize(GPTM_SYNC(GPTM_WTIMER2A) | GPTM_SYNC(GPTM_WTIMER2B));
+}
+
+uint64_t Stopwatch_Now(void)
+{
+	return GPTM_Read(GPTM_WTIMER2A);
+}
+
+// Returns the time of the first edge of the press that has just been debounced
+static uint64_t Stopwatch_Press_Time(uint8_t button)
+{
+	uint32_t basepri = Interrupt_Lock(INTERRUPT_LEVEL_STOPWATCH);
+	uint64_t edge = press_edge[button];
+	Interrupt_Unlock(INTERRUPT_LEVEL_STOPWATCH, basepri);
+
+	uint64_t now = Stopwatch_Now();
+
+	if (((now - edge) & STOPWATCH_MASK) > MAX_PRESS_DELAY_TICKS)
+	{
+		return now;
+	}
+
+	return edge;
+}
+
+void Stopwatch_Handler(const Input_Event *event)
+{
+	if (event->type != INPUT_EVENT_PRESS) return;
+
+	if (event->code == STOPWATCH_START_STOP)
+	{
+		uint64_t edge = Stopwatch_Press_Time(0);
+
+		if (running)
+		{
+			accumulated_ticks += (edge - start_ticks) & STOPWATCH_MASK;
+			running = 0;
+		}
+		else
+		{
+			start_ticks = edge;
+			running = 1;
+		}
+	}
+	else if (event->code == STOPWATCH_LAP_RESET)
+	{
+		if (running)
+		{
+			uint64_t edge = Stopwatch_Press_Time(1);
+			uint64_t split = accumulated_ticks + ((edge - start_ticks) & STOPWATCH_MASK);
+			uint64_t previous_split = 0;
+
+			if (lap_count > 0)
+			{
+				previous_split = laps[(lap_count - 1) % STOPWATCH_MAX_LAPS].split_ticks;
+			}
+
+			Stopwatch_Lap *lap = &laps[lap_count % STOPWATCH_MAX_LAPS];
+			lap->number = lap_count + 1;
+			lap->split_ticks = split;
+			lap->lap_ticks = split - previous_split;
+			lap_count++;
+		}
+		else
+		{
+			accumulated_ticks = 0;
+			lap_count = 0;
+		}
+	}
+}
+
+uint64_t Stopwatch_Elapsed(void)
+{
+	if (running)
+	{
+		return accumulated_ticks + ((Stopwatch_Now() - start_ticks) & STOPWATCH_MASK);
+	}
+
+	return accumulated_ticks;
+}
+
+uint8_t Stopwatch_Running(void)
+{
+	return running;
+}
+
+uint16_t Stopwatch_Lap_Count(void)
+{
+	return lap_count;
+}
+
+uint8_t Stopwatch_Read_Lap(uint8_t age, Stopwatch_Lap *lap)
+{
+	if ((age >= STOPWATCH_MAX_LAPS) || (age >= lap_count)) return 0;
+
+	*lap = laps[(lap_count - 1 - age) % STOPWATCH_MAX_LAPS];
+
+	return 1;
+}
+
+void Stopwatch_Format(uint64_t ticks, char *text)
+{
+	uint32_t hundredths = (uint32_t)(ticks / (STOPWATCH_TICKS_PER_MS * 10));
+
+	snprintf(text, STOPWATCH_TEXT_SIZE, "%02lu:%02lu.%02lu",
+	         (unsigned long)(hundredths / 6000),
+	         (unsigned long)((hundredths / 100) % 60),
+	         (unsigned long)(hundredths % 100));
+}
+
+static void Stopwatch_Compute_Digits(void)
+{
+	uint32_t hundredths = (uint32_t)(Stopwatch_Elapsed() / (STOPWATCH_TICKS_PER_MS * 10));
+	uint32_t value;
+
+	if (hundredths < SECONDS_DISPLAY_LIMIT)
+	{
+		value = hundredths;
+	}
+	else
+	{
+		uint32_t seconds = hundredths / 100;
+		value = (((seconds / 60) % 100) * 100) + (seconds % 60);
+	}
+
+	// The first digit is the rightmost one
+	for (uint8_t i = 0; i < 4; i++)
+	{
+		display_patterns[i] = number_pattern[value % 10];
+		value = value / 10;
+	}
+
+	// Light the decimal point (active low) after the second digit from the left
+	display_patterns[2] &= ~0x80;
+}
+
+void Stopwatch_Refresh(uint32_t now_ms)
+{
+	if (now_ms == last_refresh_ms) return;
+
+	last_refresh_ms = now_ms;
+
+	// Compute the digits from the timer once per refresh of the whole display
+	if (display_digit == 0)
+	{
+		Stopwatch_Compute_Digits();
+	}
+
+	Seven_Segment_Display_Digit(display_digit, display_patterns[display_digit]);
+
+	display_digit = (display_digit + 1) & 0x03;
+}
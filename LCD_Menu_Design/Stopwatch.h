@@ -0,0 +1,155 @@
+/**
+ * @file Stopwatch.h
+ *
+ * @brief Header file for the Stopwatch driver.
+ *
+ * This file contains the function definitions for the Stopwatch driver.
+ * It times intervals with a free-running hardware timer, so the elapsed time does not
+ * depend on interrupt latency or on how often the main loop runs. The following pins are used:
+ *  - SW5 (PD0, WT2CCP0)  Start / stop
+ *  - SW4 (PD1, WT2CCP1)  Lap / reset
+ *
+ * Wide Timer 2A and 2B are claimed from the GPTM driver and count up together at the system clock, extended to 48 bits by their
+ * prescalers, which only wraps after about 65 days at 50 MHz. Both halves capture the rising
+ * edges of their button in hardware. The debounce engine still reads the pins and posts the
+ * press events of SW4 and SW5, and Stopwatch_Handler stamps each press with the time of the
+ * first edge of its contact bounce, so a press is timed to within one timer tick.
+ *
+ * The elapsed time is kept as timer ticks and is only converted to digits when it is shown,
+ * so no rounding error accumulates over hours. Laps are kept in a ring buffer of the
+ * STOPWATCH_MAX_LAPS most recent laps.
+ *
+ * @note The pins stay digital inputs when they are assigned to the timer, so the GPIO data
+ * and interrupt logic of EduBase_Button_Interrupt keep working. Stopwatch_Init must be called
+ * after EduBase_Button_Interrupt_Init, which assigns the pins to the GPIO function.
+ */
+
+#ifndef STOPWATCH_H
+#define STOPWATCH_H
+
+#include "TM4C123GH6PM.h"
+#include "Input_Event.h"
+
+// Timer ticks per millisecond, since the timers count at the system clock
+#define STOPWATCH_TICKS_PER_MS (SystemCoreClock / 1000)
+
+// Number of laps kept in the ring buffer
+#define STOPWATCH_MAX_LAPS 8
+
+// Edges closer than this are contact bounce of the same press or release
+#define STOPWATCH_BOUNCE_MS 20
+
+// Codes of the EduBase button events handled by the stopwatch
+#define STOPWATCH_START_STOP 0x01
+#define STOPWATCH_LAP_RESET 0x02
+
+// Length of the text written by Stopwatch_Format, including the null terminator
+#define STOPWATCH_TEXT_SIZE 12
+
+typedef struct
+{
+	// Number of the lap since the last reset, starting at 1
+	uint16_t number;
+
+	// Elapsed time at the end of the lap, and the length of the lap, in timer ticks
+	uint64_t split_ticks;
+	uint64_t lap_ticks;
+} Stopwatch_Lap;
+
+/**
+ * @brief Starts the free-running timer and the edge capture of SW4 and SW5.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Stopwatch_Init(void);
+
+/**
+ * @brief Reads the free-running timer.
+ *
+ * @param None
+ *
+ * @return The current time in timer ticks (48 bits).
+ */
+uint64_t Stopwatch_Now(void);
+
+/**
+ * @brief Handles the debounced events of the EduBase buttons.
+ *
+ * A press of SW5 starts or stops the stopwatch. A press of SW4 records a lap while the
+ * stopwatch is running, and resets it while it is stopped. Events of the other buttons
+ * are ignored.
+ *
+ * @param event The event posted by the debounce engine for INPUT_SOURCE_EDUBASE_BTN.
+ *
+ * @return None
+ */
+void Stopwatch_Handler(const Input_Event *event);
+
+/**
+ * @brief Returns the time measured by the stopwatch.
+ *
+ * @param None
+ *
+ * @return The elapsed time in timer ticks, up to now if the stopwatch is running.
+ */
+uint64_t Stopwatch_Elapsed(void);
+
+/**
+ * @brief Returns the state of the stopwatch.
+ *
+ * @param None
+ *
+ * @return 1 if the stopwatch is running, or 0 if it is stopped.
+ */
+uint8_t Stopwatch_Running(void);
+
+/**
+ * @brief Returns the number of laps recorded since the last reset.
+ *
+ * Only the last STOPWATCH_MAX_LAPS laps can be read with Stopwatch_Read_Lap.
+ *
+ * @param None
+ *
+ * @return The number of laps.
+ */
+uint16_t Stopwatch_Lap_Count(void);
+
+/**
+ * @brief Reads a recent lap.
+ *
+ * @param age The position of the lap from the newest one (0 is the newest lap).
+ *
+ * @param lap A pointer to where the lap is copied.
+ *
+ * @return 1 if the lap was read, or 0 if it is no longer in the ring buffer.
+ */
+uint8_t Stopwatch_Read_Lap(uint8_t age, Stopwatch_Lap *lap);
+
+/**
+ * @brief Formats a time as minutes, seconds and hundredths ("MM:SS.hh").
+ *
+ * @param ticks The time in timer ticks.
+ *
+ * @param text A buffer of at least STOPWATCH_TEXT_SIZE characters.
+ *
+ * @return None
+ */
+void Stopwatch_Format(uint64_t ticks, char *text);
+
+/**
+ * @brief Refreshes one digit of the Seven-Segment Display module.
+ *
+ * This function must be called from the main loop, and shows the elapsed time as "SS.hh"
+ * during the first minute and as "MM.SS" after it. The digits are computed from the timer
+ * once per refresh of the whole display, and one digit is written every millisecond.
+ * Seven_Segment_Display_Init must have been called.
+ *
+ * @param now_ms The current time in milliseconds.
+ *
+ * @return None
+ */
+void Stopwatch_Refresh(uint32_t now_ms);
+
+#endif
@@ -15,6 +15,7 @@
  */
 
 #include "SysTick_Delay.h"
+#include "Interrupt_Config.h"
 
 // Global variable used to keep track of elapsed time in microseconds
 static uint32_t us_elapsed = 0;
@@ -34,6 +35,9 @@ void SysTick_Delay_Init(void)
 	// Clear the VAL register by writing any value to it
 	SysTick->VAL = 0;
 	
+	// Give the SysTick exception the highest level of the priority plan
+	Interrupt_Config_Enable(INTERRUPT_SYSTICK);
+	
 	// Enable the SysTick timer and its interrupt
 	// with the Peripheral Internal Oscillator (PIOSC) as the clock source
 	SysTick->CTRL |= 0x03;
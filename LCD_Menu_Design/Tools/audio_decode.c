@@ -0,0 +1,200 @@
+/**
+ * @file audio_decode.c
+ *
+ * @brief Host replay of the audio Morse decoder.
+ *
+ * This program runs the firmware's Goertzel detector and Morse classifier on a
+ * recorded or synthesized WAV file (16-bit PCM) and prints the decoded text.
+ * The samples are converted to 12-bit unsigned values like those of the ADC, and
+ * processed in blocks of 10 ms as on the target.
+ *
+ * Build:
+ *   gcc -O2 -I.. -o audio_decode audio_decode.c ../Goertzel.c ../Morse_Classifier.c -lm
+ *
+ * Usage:
+ *   audio_decode recording.wav [tone_hz] [wpm] [fixed|adaptive]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Goertzel.h"
+#include "Morse_Classifier.h"
+
+// Same tables as MorseDecoder.c, which cannot be built on the host
+const char *morse_table[36] = {
+	".-", "-...", "-.-.", "-..", ".", "..-.", "--.", "....", "..", ".---",
+	"-.-", ".-..", "--", "-.", "---", ".--.", "--.-", ".-.", "...", "-",
+	"..-", "...-", ".--", "-..-", "-.--", "--..", "-----", ".----", "..---",
+	"...--", "....-", ".....", "-....", "--...", "---..", "----."
+};
+
+const char char_table[36] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+
+static unsigned elements = 0;
+
+static void Decode_Handler(uint8_t event, uint32_t timestamp_ms)
+{
+	(void)timestamp_ms;
+
+	if ((event == MORSE_EVENT_DOT) || (event == MORSE_EVENT_DASH))
+	{
+		elements++;
+	}
+	else if (event == MORSE_EVENT_CHARACTER_END)
+	{
+		char decoded = '?';
+
+		for (int i = 0; i < 36; i++)
+		{
+			if (strcmp(Morse_Classifier_Pattern(), morse_table[i]) == 0)
+			{
+				decoded = char_table[i];
+			}
+		}
+
+		putchar(decoded);
+	}
+	else if (event == MORSE_EVENT_WORD_END)
+	{
+		putchar(' ');
+	}
+}
+
+static uint32_t Read_U32(const unsigned char *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc < 2)
+	{
+		fprintf(stderr, "usage: %s recording.wav [tone_hz] [wpm] [fixed|adaptive]\n", argv[0]);
+		return 2;
+	}
+
+	uint32_t tone_hz = (argc > 2) ? (uint32_t)atoi(argv[2]) : 800;
+	int32_t wpm = (argc > 3) ? atoi(argv[3]) : 12;
+	uint8_t mode = ((argc > 4) && (strcmp(argv[4], "adaptive") == 0)) ? MORSE_CLASSIFIER_ADAPTIVE : MORSE_CLASSIFIER_FIXED;
+
+	FILE *file = fopen(argv[1], "rb");
+
+	if (file == NULL)
+	{
+		perror(argv[1]);
+		return 1;
+	}
+
+	fseek(file, 0, SEEK_END);
+	long size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	unsigned char *data = malloc((size_t)size);
+
+	if ((data == NULL) || (fread(data, 1, (size_t)size, file) != (size_t)size) || (size < 12) ||
+	    (memcmp(data, "RIFF", 4) != 0) || (memcmp(data + 8, "WAVE", 4) != 0))
+	{
+		fprintf(stderr, "%s: not a WAV file\n", argv[1]);
+		return 1;
+	}
+
+	fclose(file);
+
+	// Find the format and data chunks
+	uint32_t sample_rate = 0;
+	uint32_t channels = 1;
+	const unsigned char *pcm = NULL;
+	uint32_t pcm_size = 0;
+
+	for (long offset = 12; (offset + 8) <= size; )
+	{
+		uint32_t chunk_size = Read_U32(data + offset + 4);
+
+		if ((memcmp(data + offset, "fmt ", 4) == 0) && (chunk_size >= 16))
+		{
+			channels = data[offset + 10] | (data[offset + 11] << 8);
+			sample_rate = Read_U32(data + offset + 12);
+
+			if ((data[offset + 22] | (data[offset + 23] << 8)) != 16)
+			{
+				fprintf(stderr, "%s: only 16-bit PCM is supported\n", argv[1]);
+				return 1;
+			}
+		}
+		else if (memcmp(data + offset, "data", 4) == 0)
+		{
+			pcm = data + offset + 8;
+			pcm_size = chunk_size;
+
+			if ((offset + 8 + (long)pcm_size) > size)
+			{
+				pcm_size = (uint32_t)(size - offset - 8);
+			}
+		}
+
+		offset += 8 + chunk_size + (chunk_size & 1);
+	}
+
+	if ((pcm == NULL) || (sample_rate == 0))
+	{
+		fprintf(stderr, "%s: missing fmt or data chunk\n", argv[1]);
+		return 1;
+	}
+
+	// Same timing thresholds as MorseDecoder_Set_WPM
+	MorseDecoder_Timing timing;
+	int32_t dot_ms = 1200 / wpm;
+	timing.wpm = wpm;
+	timing.dot_threshold = dot_ms;
+	timing.dash_threshold = 3 * dot_ms;
+	timing.char_pause = 4 * dot_ms;
+	timing.word_pause = 10 * dot_ms;
+
+	uint16_t block_size = (uint16_t)(sample_rate / 100);
+	uint16_t *block = malloc(block_size * sizeof(uint16_t));
+	uint32_t num_samples = pcm_size / (2 * channels);
+	uint32_t num_blocks = num_samples / block_size;
+	uint32_t time_ms = 0;
+	unsigned edges = 0;
+
+	Goertzel_Detector detector;
+	Goertzel_Init(&detector, tone_hz, sample_rate, block_size);
+	Morse_Classifier_Init(&timing, &Decode_Handler);
+	Morse_Classifier_Set_Mode(mode);
+
+	for (uint32_t b = 0; b < num_blocks; b++)
+	{
+		for (uint32_t i = 0; i < block_size; i++)
+		{
+			const unsigned char *p = pcm + (((b * block_size) + i) * 2 * channels);
+			int16_t sample = (int16_t)(p[0] | (p[1] << 8));
+
+			// Convert to a 12-bit reading centered at half of the ADC range
+			block[i] = (uint16_t)((sample >> 4) + 2048);
+		}
+
+		uint8_t previous = detector.tone;
+		uint8_t tone = Goertzel_Detect(&detector, block);
+
+		time_ms += 10;
+
+		if (tone != previous)
+		{
+			edges++;
+			Morse_Classifier_Key(tone, time_ms);
+		}
+
+		Morse_Classifier_Process(time_ms);
+	}
+
+	printf("\n");
+	fprintf(stderr, "%u Hz, %u blocks of %u samples, %u tone edges, %u elements, estimated %u WPM\n",
+	        (unsigned)sample_rate, (unsigned)num_blocks, (unsigned)block_size, edges, elements,
+	        (unsigned)Morse_Classifier_WPM);
+
+	free(block);
+	free(data);
+
+	return 0;
+}
@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+"""
+Measures the accuracy of the fixed and adaptive Morse classifiers on the host.
+
+Test recordings are synthesized with morse_wav.py at several keying speeds,
+amounts of timing jitter and noise levels, and replayed through audio_decode
+(the firmware's Goertzel detector and Morse classifier built for the host) in
+both classifier modes. The decoder is always configured for --wpm, so the
+recordings at other speeds show how well each mode follows a speed change.
+
+The character error rate is the edit distance between the decoded and the
+keyed text divided by the length of the keyed text.
+
+Usage:
+    gcc -O2 -I.. -o audio_decode audio_decode.c ../Goertzel.c ../Morse_Classifier.c -lm
+    decoder_accuracy.py [--decoder ./audio_decode] [--wpm 12] [--trials 3]
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+
+TEXTS = [
+    "CQ CQ DE W1AW K",
+    "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG",
+    "PARIS 73 ES 88 TU",
+]
+
+SPEEDS = [8, 12, 18, 25]
+JITTERS = [0.0, 0.1, 0.2]
+NOISES = [0.0, 0.5]
+
+
+def edit_distance(a, b):
+    previous = list(range(len(b) + 1))
+    for i, ca in enumerate(a, 1):
+        current = [i]
+        for j, cb in enumerate(b, 1):
+            current.append(min(previous[j] + 1, current[j - 1] + 1, previous[j - 1] + (ca != cb)))
+        previous = current
+    return previous[-1]
+
+
+def decode(decoder, path, wpm, mode):
+    result = subprocess.run([decoder, path, "800", str(wpm), mode], capture_output=True, text=True, check=True)
+    return " ".join(result.stdout.split())
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--decoder", default="./audio_decode", help="host build of audio_decode.c")
+    parser.add_argument("--wpm", type=int, default=12, help="speed configured in the decoder")
+    parser.add_argument("--trials", type=int, default=3, help="random seeds per condition")
+    args = parser.parse_args()
+
+    generator = os.path.join(os.path.dirname(os.path.abspath(__file__)), "morse_wav.py")
+    totals = {"fixed": [0, 0], "adaptive": [0, 0]}
+
+    print("%5s %6s %5s %9s %9s" % ("wpm", "jitter", "noise", "fixed", "adaptive"))
+
+    with tempfile.TemporaryDirectory() as directory:
+        path = os.path.join(directory, "test.wav")
+
+        for speed in SPEEDS:
+            for jitter in JITTERS:
+                for noise in NOISES:
+                    errors = {"fixed": 0, "adaptive": 0}
+                    length = 0
+
+                    for trial in range(args.trials):
+                        for text in TEXTS:
+                            subprocess.run([sys.executable, generator, text, path, "--wpm", str(speed),
+                                            "--jitter", str(jitter), "--noise", str(noise),
+                                            "--seed", str(trial + 1)], check=True)
+                            length += len(text)
+                            for mode in errors:
+                                errors[mode] += edit_distance(decode(args.decoder, path, args.wpm, mode), text)
+
+                    for mode in errors:
+                        totals[mode][0] += errors[mode]
+                        totals[mode][1] += length
+
+                    print("%5d %6.2f %5.2f %8.1f%% %8.1f%%" % (speed, jitter, noise,
+                                                              100.0 * errors["fixed"] / length,
+                                                              100.0 * errors["adaptive"] / length))
+
+    print("%18s %8.1f%% %8.1f%%" % ("overall",
+                                     100.0 * totals["fixed"][0] / totals["fixed"][1],
+                                     100.0 * totals["adaptive"][0] / totals["adaptive"][1]))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,152 @@
+/**
+ * @file input_replay.c
+ *
+ * @brief Host replay of synthetic Morse streams through the input replay engine.
+ *
+ * This program runs the firmware's Input_Replay engine and Morse classifier on a
+ * simulated millisecond clock. The events injected by the engine are keyed into the
+ * classifier like the audio key events on the target, and the decoded characters are
+ * checked by the engine against the keyed text. With "sweep", the text is keyed at
+ * increasing speeds until it is no longer decoded correctly.
+ *
+ * Build:
+ *   gcc -O2 -I.. -o input_replay input_replay.c ../Input_Replay.c ../Morse_Classifier.c
+ *
+ * Usage:
+ *   input_replay [wpm] [jitter_percent] [text] [fixed|adaptive] [sweep]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Input_Replay.h"
+#include "Morse_Classifier.h"
+
+// Same tables as MorseDecoder.c, which cannot be built on the host
+const char *morse_table[36] = {
+	".-", "-...", "-.-.", "-..", ".", "..-.", "--.", "....", "..", ".---",
+	"-.-", ".-..", "--", "-.", "---", ".--.", "--.-", ".-.", "...", "-",
+	"..-", "...-", ".--", "-..-", "-.--", "--..", "-----", ".----", "..---",
+	"...--", "....-", ".....", "-....", "--...", "---..", "----."
+};
+
+const char char_table[36] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+
+// Input_Event stubs: the events are delivered as soon as they are posted
+volatile uint32_t Input_Events_Dropped = 0;
+
+static uint32_t time_ms = 0;
+
+void Input_Event_Post(uint8_t source, uint8_t code, uint8_t type, int32_t value)
+{
+	(void)source;
+	(void)code;
+	(void)value;
+
+	if (type == INPUT_EVENT_PRESS)
+	{
+		Morse_Classifier_Key(1, time_ms);
+	}
+	else if (type == INPUT_EVENT_RELEASE)
+	{
+		Morse_Classifier_Key(0, time_ms);
+	}
+}
+
+uint8_t Input_Event_Subscribe(uint8_t source_mask, uint8_t type_mask, void (*handler)(const Input_Event *event))
+{
+	(void)source_mask;
+	(void)type_mask;
+	(void)handler;
+
+	return 1;
+}
+
+static void Decode_Handler(uint8_t event, uint32_t timestamp_ms)
+{
+	(void)timestamp_ms;
+
+	if (event == MORSE_EVENT_CHARACTER_END)
+	{
+		char decoded = '?';
+
+		for (int i = 0; i < 36; i++)
+		{
+			if (strcmp(Morse_Classifier_Pattern(), morse_table[i]) == 0)
+			{
+				decoded = char_table[i];
+			}
+		}
+
+		Input_Replay_Check(decoded);
+		putchar(decoded);
+	}
+	else if (event == MORSE_EVENT_WORD_END)
+	{
+		Input_Replay_Check(' ');
+		putchar(' ');
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	int32_t wpm = (argc > 1) ? atoi(argv[1]) : 12;
+	uint8_t jitter_percent = (argc > 2) ? (uint8_t)atoi(argv[2]) : 0;
+	const char *text = (argc > 3) ? argv[3] : "PARIS PARIS";
+	uint8_t mode = ((argc > 4) && (strcmp(argv[4], "adaptive") == 0)) ? MORSE_CLASSIFIER_ADAPTIVE : MORSE_CLASSIFIER_FIXED;
+	uint8_t sweep = (argc > 5) && (strcmp(argv[5], "sweep") == 0);
+
+	// Same timing thresholds as MorseDecoder_Set_WPM
+	MorseDecoder_Timing timing;
+	int32_t dot_ms = 1200 / wpm;
+	timing.wpm = wpm;
+	timing.dot_threshold = dot_ms;
+	timing.dash_threshold = 3 * dot_ms;
+	timing.char_pause = 4 * dot_ms;
+	timing.word_pause = 10 * dot_ms;
+
+	Morse_Classifier_Init(&timing, &Decode_Handler);
+	Morse_Classifier_Set_Mode(mode);
+	Input_Replay_Init(INPUT_SOURCE_AUDIO, 0);
+
+	uint8_t started = sweep ? Input_Replay_Sweep(text, wpm, jitter_percent, time_ms)
+	                        : Input_Replay_Synthesize(text, wpm, jitter_percent, time_ms);
+
+	if (!started)
+	{
+		fprintf(stderr, "usage: %s [wpm] [jitter_percent] [text] [fixed|adaptive] [sweep]\n", argv[0]);
+		return 2;
+	}
+
+	const Input_Replay_Result *result = Input_Replay_Get_Result();
+
+	// A sweep starts its next run one millisecond after the previous run has ended
+	while (1)
+	{
+		uint8_t ended = Input_Replay_Process(time_ms);
+
+		Morse_Classifier_Process(time_ms);
+
+		if (ended)
+		{
+			printf("\n");
+			fprintf(stderr, "%ld WPM: %lu events, %lu/%lu decoded, %lu errors, %lu ms\n",
+			        (long)result->wpm, (unsigned long)result->events, (unsigned long)result->decoded,
+			        (unsigned long)result->expected, (unsigned long)result->errors,
+			        (unsigned long)result->duration_ms);
+		}
+		else if (Input_Replay_State() != INPUT_REPLAY_PLAYING)
+		{
+			break;
+		}
+
+		time_ms++;
+	}
+
+	if (sweep)
+	{
+		fprintf(stderr, "maximum speed without errors: %lu WPM\n", (unsigned long)Input_Replay_Max_WPM);
+	}
+
+	return (result->errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+"""
+Precompiles static LCD screens into the streams played by the LCD_Stream driver.
+
+Each screen of the description file is encoded into the nibbles written to the
+HD44780 in 4-bit mode, with the register select flag of each nibble and a wait
+code after each byte for its execution time (37 us, or 1.52 ms for Clear
+Display and Return Home). The streams are written as const arrays, so they are
+kept in flash and showing a screen needs no formatting on the target.
+
+Usage:
+    lcd_stream_gen.py [Tools/lcd_screens.txt] [--out LCD_Screens]
+"""
+
+import argparse
+import re
+import shlex
+
+# Codes of LCD_Stream.h
+WAIT_UNIT_US = 20
+COMMAND_WAIT_US = 40
+CLEAR_WAIT_US = 1600
+
+CLEAR_DISPLAY = 0x01
+SET_DDRAM_ADDR = 0x80
+
+
+def nibble(control_flag, value):
+    return (control_flag << 4) | (value & 0x0F)
+
+
+def wait(us):
+    units = -(-us // WAIT_UNIT_US)
+    assert 0 < units <= 0x7F, us
+    return 0x80 | units
+
+
+class Screen:
+    def __init__(self, name):
+        self.name = name
+        self.codes = []
+        self.comments = []
+        self.address = 0x00
+
+    def byte(self, control_flag, value, wait_us, comment):
+        self.codes += [nibble(control_flag, value >> 4), nibble(control_flag, value), wait(wait_us)]
+        self.comments.append(comment)
+
+    def clear(self):
+        self.byte(0, CLEAR_DISPLAY, CLEAR_WAIT_US, "Clear Display")
+        self.address = 0x00
+
+    def cursor(self, row, column):
+        if not (0 <= row <= 1 and 0 <= column <= 15):
+            raise ValueError("%s: position %d,%d is off the screen" % (self.name, row, column))
+        self.address = (0x40 if row else 0x00) | column
+        self.byte(0, SET_DDRAM_ADDR | self.address, COMMAND_WAIT_US, "Set DDRAM Address 0x%02X" % self.address)
+
+    def text(self, row, column, text):
+        if column + len(text) > 16:
+            raise ValueError("%s: \"%s\" does not fit on the row" % (self.name, text))
+        self.cursor(row, column)
+        for character in text.encode("ascii"):
+            self.byte(1, character, COMMAND_WAIT_US, repr(chr(character)))
+            # Same address counter as EduBase_LCD_Send_Data
+            self.address += 1
+            if self.address == 0x28:
+                self.address = 0x40
+            elif self.address == 0x68:
+                self.address = 0x00
+
+
+def parse(path):
+    screens = []
+    with open(path) as f:
+        for number, line in enumerate(f, 1):
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            match = re.fullmatch(r"\[([A-Z0-9_]+)\]", line)
+            if match:
+                screens.append(Screen(match.group(1)))
+                continue
+            if not screens:
+                raise SystemExit("%s:%d: command before the first screen" % (path, number))
+            words = shlex.split(line)
+            screen = screens[-1]
+            try:
+                if words == ["clear"]:
+                    screen.clear()
+                elif words[0] == "at" and len(words) == 4:
+                    screen.text(int(words[1]), int(words[2]), words[3])
+                elif words[0] == "cursor" and len(words) == 3:
+                    screen.cursor(int(words[1]), int(words[2]))
+                else:
+                    raise ValueError("unknown command")
+            except ValueError as error:
+                raise SystemExit("%s:%d: %s" % (path, number, error))
+    return screens
+
+
+def write_header(screens, base, source):
+    guard = base.upper().split("/")[-1] + "_H"
+    with open(base + ".h", "w", newline="\n") as f:
+        f.write("/**\n * @file %s.h\n *\n" % base.split("/")[-1])
+        f.write(" * @brief Precompiled LCD screens.\n *\n")
+        f.write(" * This file is generated by Tools/lcd_stream_gen.py from %s.\n" % source)
+        f.write(" * Do not edit it. Each screen is played with LCD_Stream_Play.\n */\n\n")
+        f.write("#ifndef %s\n#define %s\n\n#include \"LCD_Stream.h\"\n\n" % (guard, guard))
+        for screen in screens:
+            f.write("extern const LCD_Stream LCD_SCREEN_%s;\n" % screen.name)
+        f.write("\n#endif\n")
+
+
+def write_source(screens, base, source):
+    name = base.split("/")[-1]
+    with open(base + ".c", "w", newline="\n") as f:
+        f.write("/**\n * @file %s.c\n *\n" % name)
+        f.write(" * @brief Precompiled LCD screens.\n *\n")
+        f.write(" * This file is generated by Tools/lcd_stream_gen.py from %s.\n" % source)
+        f.write(" * Do not edit it.\n */\n\n#include \"%s.h\"\n" % name)
+        for screen in screens:
+            array = "lcd_screen_%s_codes" % screen.name.lower()
+            f.write("\nstatic const uint8_t %s[%d] =\n{\n" % (array, len(screen.codes)))
+            for i, comment in enumerate(screen.comments):
+                codes = ", ".join("0x%02X" % code for code in screen.codes[3 * i:3 * i + 3])
+                f.write("\t%s,%s// %s\n" % (codes, " " * 2, comment))
+            f.write("};\n\n")
+            f.write("const LCD_Stream LCD_SCREEN_%s = { %s, %d, 0x%02X };\n"
+                    % (screen.name, array, len(screen.codes), screen.address))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("screens", nargs="?", default="Tools/lcd_screens.txt", help="screen description file")
+    parser.add_argument("--out", default="LCD_Screens", help="path of the generated files, without extension")
+    args = parser.parse_args()
+
+    screens = parse(args.screens)
+    write_header(screens, args.out, args.screens)
+    write_source(screens, args.out, args.screens)
+
+    for screen in screens:
+        print("LCD_SCREEN_%s: %d codes" % (screen.name, len(screen.codes)))
+
+
+if __name__ == "__main__":
+    main()
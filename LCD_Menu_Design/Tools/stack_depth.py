@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+"""
+Computes the worst-case stack depth of main and of each interrupt handler.
+
+The static call graph written by the ARM linker (Objects/LCD_Menu_Design.htm,
+enabled with the "Callgraph" option of the Listing tab) gives the stack frame
+of each function and its direct calls. The calls made through function
+pointers and the priority of each interrupt are read from a configuration
+file (Tools/stack_config.txt).
+
+An interrupt can only preempt the handlers of a lower priority (higher level),
+so the worst case nests the deepest handler of each priority level on top of
+main, each with its exception frame (8 words, or 26 words when the FPU
+context is stacked).
+
+Usage:
+    stack_depth.py [Objects/LCD_Menu_Design.htm] [--config Tools/stack_config.txt]
+                   [--startup RTE/Device/TM4C123GH6PM/startup_TM4C123.s] [--no-fpu]
+"""
+
+import argparse
+import html
+import re
+import sys
+
+FUNCTION = re.compile(r'<P><STRONG><a name="\[(\w+)\]"></a>(.+?)</STRONG> \((?:Thumb|ARM), \d+ bytes, '
+                      r'Stack size (\d+|unknown) bytes, (.+?)\)')
+LINK = re.compile(r'<a href="#\[(\w+)\]">')
+VECTOR = re.compile(r'<LI><a href="#\[\w+\]">(\w+)</a> from (\S+) referenced from startup_\w+\.o\(RESET\)')
+STACK_SIZE = re.compile(r'^Stack_Size\s+EQU\s+(0x[0-9A-Fa-f]+|\d+)', re.M)
+
+LOWEST_PRIORITY = 7
+
+
+def parse_call_graph(path):
+    """Returns {name: (stack size or None, [callees])} and the implemented handlers."""
+    text = open(path, encoding="latin-1").read()
+    names = {}
+    functions = {}
+    calls = {}
+    current = None
+    for line in text.splitlines():
+        match = FUNCTION.match(line)
+        if match:
+            ident, name, size = match.group(1), html.unescape(match.group(2)), match.group(3)
+            names[ident] = name
+            functions[name] = None if size == "unknown" else int(size)
+            calls[name] = []
+            current = name
+            section = None
+            continue
+        if current is None:
+            continue
+        if line.startswith("<BR>[Calls]"):
+            section = "calls"
+        elif line.startswith("<BR>["):
+            section = None
+        if section == "calls":
+            calls[current] += LINK.findall(line)
+    graph = {name: (functions[name], [names[i] for i in calls[name] if i in names]) for name in functions}
+    # Handlers left at the default handler of the startup file are never used
+    handlers = [name for name, source in VECTOR.findall(text) if not source.startswith("startup_")]
+    return graph, handlers
+
+
+def parse_config(path, graph):
+    priorities = {}
+    for number, line in enumerate(open(path), 1):
+        words = line.split("#", 1)[0].split()
+        if not words:
+            continue
+        if words[0] == "priority" and len(words) == 3:
+            priorities[words[1]] = int(words[2])
+        elif words[0] == "call" and len(words) == 3:
+            if words[1] in graph:
+                size, callees = graph[words[1]]
+                graph[words[1]] = (size, callees + [words[2]])
+            else:
+                print("%s:%d: %s is not in the call graph" % (path, number, words[1]), file=sys.stderr)
+        else:
+            sys.exit("%s:%d: unknown line" % (path, number))
+    return priorities
+
+
+def depth(graph, name, memo, path=()):
+    """Returns (depth in bytes, call chain, set of unknown functions) of the deepest call chain."""
+    if name in memo:
+        return memo[name]
+    if name in path or name not in graph:
+        # Recursion, or a function that is not linked (e.g. an inlined static function)
+        return 0, [name], {name} if name in path else set()
+    size, callees = graph[name]
+    unknown = set() if size is not None else {name}
+    best, chain = 0, []
+    for callee in callees:
+        callee_depth, callee_chain, callee_unknown = depth(graph, callee, memo, path + (name,))
+        unknown |= callee_unknown
+        if callee_depth > best or not chain:
+            best, chain = callee_depth, callee_chain
+    result = ((size or 0) + best, [name] + chain, unknown)
+    memo[name] = result
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("callgraph", nargs="?", default="Objects/LCD_Menu_Design.htm")
+    parser.add_argument("--config", default="Tools/stack_config.txt")
+    parser.add_argument("--startup", default="RTE/Device/TM4C123GH6PM/startup_TM4C123.s")
+    parser.add_argument("--no-fpu", action="store_true", help="the FPU context is never stacked")
+    args = parser.parse_args()
+
+    graph, handlers = parse_call_graph(args.callgraph)
+    priorities = parse_config(args.config, graph)
+    frame = 32 if args.no_fpu else 104
+    memo = {}
+
+    main_depth, main_chain, unknown = depth(graph, "main", memo)
+    print("%-22s %5s %5s %6s  %s" % ("Function", "Level", "Frame", "Depth", "Deepest call chain"))
+    print("%-22s %5s %5d %6d  %s" % ("main", "-", 0, main_depth, " > ".join(main_chain)))
+
+    # Deepest handler of each priority level, including its exception frame
+    levels = {}
+    for handler in sorted(handlers, key=lambda h: (priorities.get(h, LOWEST_PRIORITY), h)):
+        level = priorities.get(handler, LOWEST_PRIORITY)
+        handler_depth, chain, handler_unknown = depth(graph, handler, memo)
+        unknown |= handler_unknown
+        total = handler_depth + frame
+        print("%-22s %5d %5d %6d  %s" % (handler, level, frame, total, " > ".join(chain)))
+        if total > levels.get(level, (0, None))[0]:
+            levels[level] = (total, handler)
+
+    worst = main_depth + sum(total for total, _ in levels.values())
+    print()
+    print("Worst-case nesting: main (%d)" % main_depth)
+    for level in sorted(levels, reverse=True):
+        print("  + level %d: %-20s (%d)" % (level, levels[level][1], levels[level][0]))
+    print("  = %d bytes" % worst)
+
+    match = STACK_SIZE.search(open(args.startup).read())
+    if match:
+        size = int(match.group(1), 0)
+        print("Stack_Size = %d bytes, margin = %d bytes" % (size, size - worst))
+    if unknown:
+        print("Functions with unknown stack usage or recursion: " + ", ".join(sorted(unknown)))
+
+    if match and worst > int(match.group(1), 0):
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
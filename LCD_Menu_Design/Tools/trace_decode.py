@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+"""
+Decodes a binary stream captured from Trace_Recorder into a timeline.
+
+The stream is the sequence of 9-byte frames produced by Trace_Recorder_Drain
+(either an SWO capture of ITM stimulus port 1 or a raw UART capture):
+
+    0xA5, id, arg0, arg1 (u16 LE), timestamp (u32 LE, DWT CYCCNT)
+
+Usage:
+    trace_decode.py capture.bin [--clock-hz 50000000] [--summary]
+
+The timeline lists each event with its absolute time and the time since the
+previous event. ISR enter/exit pairs are matched to report handler durations,
+and --summary prints per-ISR and per-event statistics to help find latency
+spikes and dropped inputs.
+"""
+
+import argparse
+import struct
+import sys
+
+FRAME_SYNC = 0xA5
+FRAME_SIZE = 9
+
+EVENT_NAMES = {
+    0x01: "CLOCK_INFO",
+    0x02: "OVERFLOW",
+    0x10: "ISR_ENTER",
+    0x11: "ISR_EXIT",
+    0x20: "BUTTON_EDGE",
+    0x30: "MORSE_SYMBOL",
+    0x31: "MORSE_DECODED",
+    0x40: "LCD_COMMAND",
+    0x41: "LCD_DATA",
+    0x50: "TIMER_EXPIRY",
+    0x60: "LATENCY_SPAN",
+}
+
+IRQ_NAMES = {0: "GPIOA", 5: "UART0", 19: "TIMER0A"}
+
+
+def read_frames(data):
+    """Yields (id, arg0, arg1, timestamp) tuples, resynchronizing on corrupt data."""
+    i = 0
+    while i + FRAME_SIZE <= len(data):
+        if data[i] != FRAME_SYNC:
+            i += 1
+            continue
+        event_id, arg0, arg1, timestamp = struct.unpack_from("<BBHI", data, i + 1)
+        if event_id not in EVENT_NAMES and event_id < 0x80:
+            i += 1
+            continue
+        yield event_id, arg0, arg1, timestamp
+        i += FRAME_SIZE
+
+
+def describe(event_id, arg0, arg1):
+    if event_id in (0x10, 0x11):
+        return IRQ_NAMES.get(arg0, "IRQ%d" % arg0)
+    if event_id == 0x01:
+        return "%d kHz" % ((arg0 << 16) | arg1)
+    if event_id == 0x02:
+        return "%d events dropped" % arg1
+    if event_id == 0x20:
+        return "port %s pins 0x%02X state 0x%02X" % (chr(arg0), arg1 >> 8, arg1 & 0xFF)
+    if event_id in (0x30, 0x31, 0x41):
+        return repr(chr(arg0))
+    if event_id == 0x40:
+        return "0x%02X" % arg0
+    if event_id == 0x50:
+        return "timer %d" % arg0
+    if event_id == 0x60:
+        return "source %d %d ms" % (arg0, arg1)
+    return "arg0=0x%02X arg1=0x%04X" % (arg0, arg1)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("capture", help="binary capture file")
+    parser.add_argument("--clock-hz", type=float, default=50e6,
+                        help="CYCCNT frequency, overridden by a CLOCK_INFO record")
+    parser.add_argument("--summary", action="store_true", help="print statistics only")
+    args = parser.parse_args()
+
+    with open(args.capture, "rb") as f:
+        data = f.read()
+
+    clock_hz = args.clock_hz
+    elapsed = 0
+    previous = None
+    open_isrs = {}
+    isr_stats = {}
+    counts = {}
+    dropped = 0
+
+    for event_id, arg0, arg1, timestamp in read_frames(data):
+        if event_id == 0x01:
+            clock_hz = ((arg0 << 16) | arg1) * 1000.0
+        if event_id == 0x02:
+            dropped += arg1
+
+        # CYCCNT is 32 bits wide, so unwrap it using modular differences
+        delta = 0 if previous is None else (timestamp - previous) & 0xFFFFFFFF
+        previous = timestamp
+        elapsed += delta
+
+        name = EVENT_NAMES.get(event_id, "USER_%02X" % event_id)
+        counts[name] = counts.get(name, 0) + 1
+        detail = describe(event_id, arg0, arg1)
+
+        if event_id == 0x10:
+            open_isrs[arg0] = elapsed
+        elif event_id == 0x11 and arg0 in open_isrs:
+            duration = elapsed - open_isrs.pop(arg0)
+            stats = isr_stats.setdefault(arg0, [0, 0, 0])
+            stats[0] += 1
+            stats[1] += duration
+            stats[2] = max(stats[2], duration)
+            detail += "  (%.2f us)" % (duration * 1e6 / clock_hz)
+
+        if not args.summary:
+            print("%14.3f us  +%10.3f us  %-14s %s" % (
+                elapsed * 1e6 / clock_hz, delta * 1e6 / clock_hz, name, detail))
+
+    print()
+    print("Events:")
+    for name in sorted(counts):
+        print("  %-14s %d" % (name, counts[name]))
+    print("  %-14s %d" % ("DROPPED", dropped))
+    if isr_stats:
+        print("ISR durations:")
+        for irq, (count, total, longest) in sorted(isr_stats.items()):
+            print("  %-8s count %-6d mean %9.2f us  max %9.2f us" % (
+                IRQ_NAMES.get(irq, "IRQ%d" % irq), count,
+                total * 1e6 / clock_hz / count, longest * 1e6 / clock_hz))
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,140 @@
+/**
+ * @file Trace_Recorder.c
+ *
+ * @brief Source code for the Trace_Recorder driver.
+ *
+ * This file contains the function definitions for the Trace_Recorder driver.
+ * It records timestamped binary events into a RAM ring buffer and drains them
+ * lazily through ITM stimulus port 1 (SWO) or a user-supplied output function.
+ *
+ * Frame format (little-endian), as decoded by Tools/trace_decode.py:
+ *  - Byte 0      Sync (0xA5)
+ *  - Byte 1      Event ID
+ *  - Byte 2      arg0
+ *  - Bytes 3-4   arg1
+ *  - Bytes 5-8   Timestamp (DWT CYCCNT)
+ */
+
+#include "Trace_Recorder.h"
+
+Trace_Record Trace_Buffer[TRACE_BUFFER_SIZE];
+volatile uint32_t Trace_Head = 0;
+volatile uint32_t Trace_Tail = 0;
+volatile uint32_t Trace_Dropped = 0;
+
+// Number of dropped events that have already been reported in an overflow frame
+static uint32_t dropped_reported = 0;
+
+// Optional output function used instead of the ITM stimulus port
+static uint32_t (*trace_output)(const uint8_t *data, uint32_t length) = 0;
+
+void Trace_Recorder_Init(void)
+{
+	// Enable the DWT unit by setting the TRCENA bit in the DEMCR register
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+
+	// Reset and start the cycle counter used to timestamp records
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	// Empty the ring buffer
+	Trace_Head = 0;
+	Trace_Tail = 0;
+	Trace_Dropped = 0;
+	dropped_reported = 0;
+
+	// Record the system clock frequency in kHz (24 bits split across arg0 and arg1)
+	// so that the host decoder can convert cycle counts to time
+	uint32_t clock_khz = SystemCoreClock / 1000;
+	Trace_Event(TRACE_ID_CLOCK_INFO, (uint8_t)(clock_khz >> 16), (uint16_t)clock_khz);
+}
+
+void Trace_Recorder_Set_Output(uint32_t (*output)(const uint8_t *data, uint32_t length))
+{
+	trace_output = output;
+}
+
+uint32_t Trace_Recorder_Pending(void)
+{
+	return Trace_Head - Trace_Tail;
+}
+
+static void Trace_Encode_Frame(uint8_t frame[TRACE_FRAME_SIZE], const Trace_Record *record)
+{
+	frame[0] = TRACE_FRAME_SYNC;
+	frame[1] = record->id;
+	frame[2] = record->arg0;
+	frame[3] = (uint8_t)(record->arg1);
+	frame[4] = (uint8_t)(record->arg1 >> 8);
+	frame[5] = (uint8_t)(record->timestamp);
+	frame[6] = (uint8_t)(record->timestamp >> 8);
+	frame[7] = (uint8_t)(record->timestamp >> 16);
+	frame[8] = (uint8_t)(record->timestamp >> 24);
+}
+
+static uint8_t Trace_ITM_Ready(void)
+{
+	// The stimulus port can only be used if the debugger has enabled both
+	// the ITM and the port, otherwise the writes would be lost
+	if ((ITM->TCR & ITM_TCR_ITMENA_Msk) == 0) return 0;
+	if ((ITM->TER & (1UL << TRACE_ITM_PORT)) == 0) return 0;
+
+	// A non-zero read indicates that the stimulus port FIFO can accept data
+	return (ITM->PORT[TRACE_ITM_PORT].u32 != 0);
+}
+
+static uint8_t Trace_Send_Frame(const uint8_t frame[TRACE_FRAME_SIZE])
+{
+	if (trace_output != 0)
+	{
+		return (trace_output(frame, TRACE_FRAME_SIZE) == TRACE_FRAME_SIZE);
+	}
+
+	if (!Trace_ITM_Ready()) return 0;
+
+	// Once the first byte of a frame has been accepted, the remaining bytes are sent
+	// back to back. The stimulus port drains within a few SWO bit times.
+	for (uint32_t i = 0; i < TRACE_FRAME_SIZE; i++)
+	{
+		while (ITM->PORT[TRACE_ITM_PORT].u32 == 0);
+		ITM->PORT[TRACE_ITM_PORT].u8 = frame[i];
+	}
+
+	return 1;
+}
+
+uint32_t Trace_Recorder_Drain(uint32_t max_records)
+{
+	uint8_t frame[TRACE_FRAME_SIZE];
+	uint32_t sent = 0;
+
+	// Report events that were dropped because the buffer was full
+	uint32_t dropped = Trace_Dropped;
+	if (dropped != dropped_reported)
+	{
+		uint32_t count = dropped - dropped_reported;
+		Trace_Record overflow;
+		overflow.timestamp = DWT->CYCCNT;
+		overflow.id = TRACE_ID_OVERFLOW;
+		overflow.arg0 = 0;
+		overflow.arg1 = (count > 0xFFFF) ? 0xFFFF : (uint16_t)count;
+
+		Trace_Encode_Frame(frame, &overflow);
+		if (!Trace_Send_Frame(frame)) return 0;
+		dropped_reported = dropped;
+	}
+
+	while ((sent < max_records) && (Trace_Tail != Trace_Head))
+	{
+		// Only the main loop advances the tail, so the record cannot be
+		// overwritten by an interrupt until the tail moves past it
+		Trace_Encode_Frame(frame, &Trace_Buffer[Trace_Tail & (TRACE_BUFFER_SIZE - 1)]);
+
+		if (!Trace_Send_Frame(frame)) break;
+
+		Trace_Tail = Trace_Tail + 1;
+		sent++;
+	}
+
+	return sent;
+}
@@ -0,0 +1,191 @@
+/**
+ * @file Trace_Recorder.h
+ *
+ * @brief Header file for the Trace_Recorder driver.
+ *
+ * This file contains the function definitions for the Trace_Recorder driver.
+ * It records timestamped binary events into a RAM ring buffer so that the
+ * timing of interrupts, button edges, decoded characters, LCD commands,
+ * timer expiries and input latency spans can be inspected without printf-style slowdowns.
+ *
+ * Each record is 8 bytes long and is timestamped with the DWT cycle counter
+ * (CYCCNT), which counts at the system clock frequency. Recording an event
+ * takes a handful of instructions with interrupts briefly masked.
+ *
+ * The buffer is drained lazily from the main loop by calling Trace_Recorder_Drain.
+ * Records are sent through ITM stimulus port 1 (SWO) when a debugger has enabled it,
+ * or through a user-supplied output function (e.g. a UART driver).
+ *
+ * The buffer can also be viewed directly in the uVision Component Viewer
+ * through EventRecorderStub.scvd, and captured streams can be decoded on the host
+ * with Tools/trace_decode.py.
+ *
+ * Set TRACE_ENABLED to 0 to compile all of the TRACE_* macros out of the firmware.
+ */
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include "TM4C123GH6PM.h"
+#include "Interrupt_Config.h"
+
+// Set to 0 to remove all trace instrumentation at compile time
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED 1
+#endif
+
+// Number of records held by the ring buffer (must be a power of two)
+#define TRACE_BUFFER_SIZE 256
+
+// ITM stimulus port used to stream trace records over SWO
+#define TRACE_ITM_PORT 1
+
+// Synchronization byte that starts every record sent by Trace_Recorder_Drain
+#define TRACE_FRAME_SYNC 0xA5
+
+// Size of an encoded record in bytes (sync byte + 8-byte record)
+#define TRACE_FRAME_SIZE 9
+
+enum Trace_Event_IDs
+{
+	TRACE_ID_CLOCK_INFO     = 0x01,
+	TRACE_ID_OVERFLOW       = 0x02,
+	TRACE_ID_ISR_ENTER      = 0x10,
+	TRACE_ID_ISR_EXIT       = 0x11,
+	TRACE_ID_BUTTON_EDGE    = 0x20,
+	TRACE_ID_MORSE_SYMBOL   = 0x30,
+	TRACE_ID_MORSE_DECODED  = 0x31,
+	TRACE_ID_LCD_COMMAND    = 0x40,
+	TRACE_ID_LCD_DATA       = 0x41,
+	TRACE_ID_TIMER_EXPIRY   = 0x50,
+	TRACE_ID_LATENCY_SPAN   = 0x60,
+	TRACE_ID_USER           = 0x80
+};
+
+typedef struct
+{
+	uint32_t timestamp;
+	uint8_t id;
+	uint8_t arg0;
+	uint16_t arg1;
+} Trace_Record;
+
+// Ring buffer and its indices. Trace_Head and Trace_Tail are free-running counters.
+extern Trace_Record Trace_Buffer[TRACE_BUFFER_SIZE];
+extern volatile uint32_t Trace_Head;
+extern volatile uint32_t Trace_Tail;
+extern volatile uint32_t Trace_Dropped;
+
+/**
+ * @brief Records an event in the trace buffer.
+ *
+ * This function stores a timestamped record in the trace buffer. Interrupts are masked
+ * for the few instructions it takes to claim a slot so that it can be called from any
+ * interrupt service routine. If the buffer is full, the event is discarded and
+ * Trace_Dropped is incremented.
+ *
+ * @param id The event identifier (see Trace_Event_IDs).
+ *
+ * @param arg0 An 8-bit argument stored with the event.
+ *
+ * @param arg1 A 16-bit argument stored with the event.
+ *
+ * @return None
+ */
+static __inline void Trace_Event(uint8_t id, uint8_t arg0, uint16_t arg1)
+{
+	uint32_t basepri = Interrupt_Lock(INTERRUPT_LEVEL_ALL);
+
+	uint32_t head = Trace_Head;
+
+	if ((head - Trace_Tail) < TRACE_BUFFER_SIZE)
+	{
+		Trace_Record *record = &Trace_Buffer[head & (TRACE_BUFFER_SIZE - 1)];
+		record->timestamp = DWT->CYCCNT;
+		record->id = id;
+		record->arg0 = arg0;
+		record->arg1 = arg1;
+		Trace_Head = head + 1;
+	}
+	else
+	{
+		Trace_Dropped = Trace_Dropped + 1;
+	}
+
+	Interrupt_Unlock(INTERRUPT_LEVEL_ALL, basepri);
+}
+
+#if TRACE_ENABLED
+#define TRACE_ISR_ENTER(irq)            Trace_Event(TRACE_ID_ISR_ENTER, (uint8_t)(irq), 0)
+#define TRACE_ISR_EXIT(irq)             Trace_Event(TRACE_ID_ISR_EXIT, (uint8_t)(irq), 0)
+#define TRACE_BUTTON_EDGE(port, status) Trace_Event(TRACE_ID_BUTTON_EDGE, (uint8_t)(port), (uint16_t)(status))
+#define TRACE_MORSE_SYMBOL(symbol)      Trace_Event(TRACE_ID_MORSE_SYMBOL, (uint8_t)(symbol), 0)
+#define TRACE_MORSE_DECODED(character)  Trace_Event(TRACE_ID_MORSE_DECODED, (uint8_t)(character), 0)
+#define TRACE_LCD_COMMAND(command)      Trace_Event(TRACE_ID_LCD_COMMAND, (uint8_t)(command), 0)
+#define TRACE_LCD_DATA(data)            Trace_Event(TRACE_ID_LCD_DATA, (uint8_t)(data), 0)
+#define TRACE_TIMER_EXPIRY(timer)       Trace_Event(TRACE_ID_TIMER_EXPIRY, (uint8_t)(timer), 0)
+#define TRACE_LATENCY_SPAN(source, ms)  Trace_Event(TRACE_ID_LATENCY_SPAN, (uint8_t)(source), (uint16_t)(ms))
+#else
+#define TRACE_ISR_ENTER(irq)
+#define TRACE_ISR_EXIT(irq)
+#define TRACE_BUTTON_EDGE(port, status)
+#define TRACE_MORSE_SYMBOL(symbol)
+#define TRACE_MORSE_DECODED(character)
+#define TRACE_LCD_COMMAND(command)
+#define TRACE_LCD_DATA(data)
+#define TRACE_TIMER_EXPIRY(timer)
+#define TRACE_LATENCY_SPAN(source, ms)
+#endif
+
+/**
+ * @brief Initializes the trace recorder.
+ *
+ * This function enables the DWT cycle counter used to timestamp records, empties the
+ * ring buffer and records a TRACE_ID_CLOCK_INFO event that holds the system clock
+ * frequency in kHz so that the host decoder can convert timestamps to time.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Trace_Recorder_Init(void);
+
+/**
+ * @brief Sets the output function used to drain the trace buffer.
+ *
+ * When an output function is set, Trace_Recorder_Drain sends records through it
+ * instead of the ITM stimulus port. The function must not block and must accept either
+ * all of the bytes or none of them. It returns the number of bytes accepted, and a record
+ * is only removed from the buffer once its whole frame has been accepted.
+ *
+ * @param output A pointer to the output function, or 0 to use the ITM stimulus port.
+ *
+ * @return None
+ */
+void Trace_Recorder_Set_Output(uint32_t (*output)(const uint8_t *data, uint32_t length));
+
+/**
+ * @brief Sends pending trace records to the selected output.
+ *
+ * This function is intended to be called from the main loop. It encodes up to max_records
+ * records as TRACE_FRAME_SIZE-byte frames and sends them to the selected output. It stops
+ * early when the output cannot accept more data, so it never blocks. If events have been
+ * dropped since the last call, a TRACE_ID_OVERFLOW frame holding the number of dropped
+ * events is sent first.
+ *
+ * @param max_records The maximum number of records to send.
+ *
+ * @return The number of records sent.
+ */
+uint32_t Trace_Recorder_Drain(uint32_t max_records);
+
+/**
+ * @brief Returns the number of records waiting to be drained.
+ *
+ * @param None
+ *
+ * @return The number of records in the trace buffer.
+ */
+uint32_t Trace_Recorder_Pending(void);
+
+#endif
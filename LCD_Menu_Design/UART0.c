@@ -0,0 +1,264 @@
+/**
+ * @file UART0.c
+ *
+ * @brief Source code for the UART0 driver.
+ *
+ * This file contains the function definitions for the UART0 driver.
+ * It uses the UART0 module, which is connected to the ICDI virtual COM port
+ * on the TM4C123G LaunchPad. The following pins are used:
+ *  - U0RX (PA0)
+ *  - U0TX (PA1)
+ *
+ * Transmitted data is copied into a RAM ring buffer and moved to the UART
+ * by µDMA channel 9 (UART0 TX), with a scatter-gather transfer when the data
+ * wraps around the end of the buffer. Received characters are moved into a RAM
+ * ring buffer by the UART0 interrupt service routine.
+ *
+ * @note Refer to Table 9-1 (µDMA Channel Assignments) on page 587 of the
+ * TM4C123G Microcontroller Datasheet for the channel encodings.
+ */
+
+#include "UART0.h"
+#include "uDMA.h"
+#include "Trace_Recorder.h"
+#include "Interrupt_Config.h"
+#include <stdio.h>
+
+// µDMA channel used by UART0 TX
+#define UART0_TX_DMA_CHANNEL (UDMA_UART0_TX & 0x1F)
+
+// Transmit ring buffer. The head and tail are free-running counters.
+static uint8_t tx_buffer[UART0_TX_BUFFER_SIZE];
+static volatile uint32_t tx_head = 0;
+static volatile uint32_t tx_tail = 0;
+
+// Number of bytes moved by the µDMA transfer in progress (0 when idle)
+static volatile uint32_t tx_dma_length = 0;
+
+// Receive ring buffer. The head and tail are free-running counters.
+static char rx_buffer[UART0_RX_BUFFER_SIZE];
+static volatile uint32_t rx_head = 0;
+static volatile uint32_t rx_tail = 0;
+
+volatile uint32_t UART0_TX_Dropped = 0;
+volatile uint32_t UART0_RX_Overruns = 0;
+
+// Scatter-gather tasks of a transfer whose data wraps around the end of the ring buffer
+static UDMA_Control_Structure tx_tasks[2];
+
+// Bytes are written to the fixed data register, 4 per arbitration
+#define UART0_TX_DMA_FLAGS (UDMA_SIZE_8 | UDMA_DESTINATION_FIXED | UDMA_ARBITRATE(2))
+
+static void UART0_TX_Start_DMA(void)
+{
+	// Return if a transfer is already in progress or if there is nothing to send
+	if (tx_dma_length != 0) return;
+	if (tx_head == tx_tail) return;
+
+	uint32_t index = tx_tail & (UART0_TX_BUFFER_SIZE - 1);
+	uint32_t length = tx_head - tx_tail;
+
+	tx_dma_length = length;
+
+	// The UART requests data as space becomes available in its FIFO
+	if ((index + length) <= UART0_TX_BUFFER_SIZE)
+	{
+		uDMA_Basic(UART0_TX_DMA_CHANNEL, &tx_buffer[index], &UART0->DR, length, UART0_TX_DMA_FLAGS);
+	}
+	else
+	{
+		// Send the end of the ring buffer, then its start, in a single transfer
+		uint32_t first_length = UART0_TX_BUFFER_SIZE - index;
+
+		uDMA_Task(&tx_tasks[0], &tx_buffer[index], &UART0->DR, first_length, UART0_TX_DMA_FLAGS);
+		uDMA_Task(&tx_tasks[1], &tx_buffer[0], &UART0->DR, length - first_length, UART0_TX_DMA_FLAGS);
+		uDMA_Scatter_Gather(UART0_TX_DMA_CHANNEL, tx_tasks, 2);
+	}
+}
+
+static void UART0_TX_Complete(uint8_t channel, uint8_t completed)
+{
+	// Release the transmitted bytes and start sending the rest
+	tx_tail = tx_tail + tx_dma_length;
+	tx_dma_length = 0;
+	UART0_TX_Start_DMA();
+}
+
+void UART0_Init(uint32_t baud_rate)
+{
+	// Enable the clock to UART0 by setting the
+	// R0 bit (Bit 0) in the RCGCUART register
+	SYSCTL->RCGCUART |= 0x01;
+
+	// Enable the clock to Port A by setting the
+	// R0 bit (Bit 0) in the RCGCGPIO register
+	SYSCTL->RCGCGPIO |= 0x01;
+
+	// Configure the PA1 and PA0 pins to use the alternate function
+	// by setting Bits 1 to 0 in the AFSEL register
+	GPIOA->AFSEL |= 0x03;
+
+	// Clear the PMC1 and PMC0 fields (Bits 7 to 0) in the PCTL register
+	GPIOA->PCTL &= ~0x000000FF;
+
+	// Configure the PA1 and PA0 pins to operate as U0TX and U0RX
+	// by writing 0x1 to the PMC1 and PMC0 fields in the PCTL register
+	GPIOA->PCTL |= 0x00000011;
+
+	// Enable the digital functionality for the PA1 and PA0 pins
+	// by setting Bits 1 to 0 in the DEN register
+	GPIOA->DEN |= 0x03;
+
+	// Disable UART0 before configuration by clearing
+	// the UARTEN bit (Bit 0) in the UARTCTL register
+	UART0->CTL &= ~0x01;
+
+	// Compute the baud rate divisor in units of 1/64 from the system clock
+	// BRD = SystemCoreClock / (16 * baud_rate), so (BRD * 64) = (SystemCoreClock * 4) / baud_rate
+	uint32_t divisor = ((SystemCoreClock * 4) + (baud_rate / 2)) / baud_rate;
+	UART0->IBRD = divisor >> 6;
+	UART0->FBRD = divisor & 0x3F;
+
+	// Select 8-bit word length (WLEN = 0x3) and enable the FIFOs (FEN)
+	// in the UARTLCRH register. This also latches the divisors.
+	UART0->LCRH = 0x70;
+
+	// Use the system clock as the UART clock source
+	UART0->CC = 0x0;
+
+	// Trigger the receive interrupt when the RX FIFO is 1/8 full (RXIFLSEL = 0x0, Bits 5 to 3)
+	// and request µDMA bursts when the TX FIFO is 1/2 empty (TXIFLSEL = 0x2, Bits 2 to 0).
+	// A single byte left in the RX FIFO is picked up by the receive time-out interrupt,
+	// and the 8 free TX entries always hold a burst of 4 bytes (UART0_TX_DMA_FLAGS)
+	UART0->IFLS = 0x02;
+
+	// Claim channel 9 for UART0 TX with default priority, single and burst requests
+	uDMA_Claim(UDMA_UART0_TX, 0, &UART0_TX_Complete);
+
+	// Enable µDMA requests for the transmit FIFO by setting
+	// the TXDMAE bit (Bit 1) in the UARTDMACTL register
+	UART0->DMACTL |= 0x02;
+
+	// Clear any pending interrupts and enable the receive (RXIM, Bit 4)
+	// and receive time-out (RTIM, Bit 6) interrupts
+	UART0->ICR = 0x7F2;
+	UART0->IM |= 0x50;
+
+	// Enable the UART0 interrupt (IRQ 5) at its level in the priority plan
+	Interrupt_Config_Enable(INTERRUPT_UART0);
+
+	// Enable UART0, its transmitter (TXE, Bit 8) and receiver (RXE, Bit 9)
+	UART0->CTL |= 0x301;
+}
+
+uint32_t UART0_Write(const uint8_t *data, uint32_t length)
+{
+	uint32_t basepri = Interrupt_Lock(INTERRUPT_LEVEL_UART);
+
+	// Drop the whole message if it does not fit in the transmit buffer
+	if ((UART0_TX_BUFFER_SIZE - (tx_head - tx_tail)) < length)
+	{
+		UART0_TX_Dropped = UART0_TX_Dropped + 1;
+		Interrupt_Unlock(INTERRUPT_LEVEL_UART, basepri);
+		return 0;
+	}
+
+	for (uint32_t i = 0; i < length; i++)
+	{
+		tx_buffer[(tx_head + i) & (UART0_TX_BUFFER_SIZE - 1)] = data[i];
+	}
+
+	tx_head = tx_head + length;
+
+	UART0_TX_Start_DMA();
+
+	Interrupt_Unlock(INTERRUPT_LEVEL_UART, basepri);
+
+	return length;
+}
+
+uint32_t UART0_Write_String(const char *string)
+{
+	uint32_t length = 0;
+
+	while (string[length] != '\0')
+	{
+		length++;
+	}
+
+	return UART0_Write((const uint8_t *)string, length);
+}
+
+uint32_t UART0_VPrintf(const char *format, va_list args)
+{
+	char message[UART0_PRINTF_BUFFER_SIZE];
+
+	int length = vsnprintf(message, sizeof(message), format, args);
+
+	if (length < 0) return 0;
+
+	if (length >= (int)sizeof(message))
+	{
+		length = sizeof(message) - 1;
+	}
+
+	return UART0_Write((const uint8_t *)message, (uint32_t)length);
+}
+
+uint32_t UART0_Printf(const char *format, ...)
+{
+	va_list args;
+
+	va_start(args, format);
+	uint32_t length = UART0_VPrintf(format, args);
+	va_end(args);
+
+	return length;
+}
+
+uint8_t UART0_Read_Char(char *character)
+{
+	if (rx_tail == rx_head) return 0;
+
+	*character = rx_buffer[rx_tail & (UART0_RX_BUFFER_SIZE - 1)];
+	rx_tail = rx_tail + 1;
+
+	return 1;
+}
+
+uint32_t UART0_TX_Pending(void)
+{
+	return tx_head - tx_tail;
+}
+
+void UART0_Handler(void)
+{
+	TRACE_ISR_ENTER(UART0_IRQn);
+
+	// Acknowledge the receive and receive time-out interrupts
+	if (UART0->MIS & 0x50)
+	{
+		UART0->ICR = 0x50;
+	}
+
+	// Empty the receive FIFO until the RXFE bit (Bit 4) in the UARTFR register is set
+	while ((UART0->FR & 0x10) == 0)
+	{
+		char character = (char)(UART0->DR & 0xFF);
+
+		if ((rx_head - rx_tail) < UART0_RX_BUFFER_SIZE)
+		{
+			rx_buffer[rx_head & (UART0_RX_BUFFER_SIZE - 1)] = character;
+			rx_head = rx_head + 1;
+		}
+		else
+		{
+			UART0_RX_Overruns = UART0_RX_Overruns + 1;
+		}
+	}
+
+	// The completion of the µDMA channel used by UART0 TX is signalled on this vector
+	uDMA_Interrupt(UART0_TX_DMA_CHANNEL);
+
+	TRACE_ISR_EXIT(UART0_IRQn);
+}
@@ -0,0 +1,138 @@
+/**
+ * @file UART0.h
+ *
+ * @brief Header file for the UART0 driver.
+ *
+ * This file contains the function definitions for the UART0 driver.
+ * It uses the UART0 module, which is connected to the ICDI virtual COM port
+ * on the TM4C123G LaunchPad. The following pins are used:
+ *  - U0RX (PA0)
+ *  - U0TX (PA1)
+ *
+ * Transmitted data is copied into a RAM ring buffer and moved to the UART
+ * by µDMA channel 9 (UART0 TX), so writes never wait for the UART. When the
+ * ring buffer cannot hold a whole message, the message is dropped and
+ * UART0_TX_Dropped is incremented.
+ *
+ * Received characters are moved into a RAM ring buffer by the UART0 interrupt
+ * service routine and read with UART0_Read_Char.
+ *
+ * @note The baud rate divisors are computed from SystemCoreClock.
+ */
+
+#ifndef UART0_H
+#define UART0_H
+
+#include "TM4C123GH6PM.h"
+#include <stdarg.h>
+
+// Default baud rate used by UART0_Init
+#define UART0_BAUD_RATE 115200
+
+// Size of the transmit and receive ring buffers (must be powers of two)
+#define UART0_TX_BUFFER_SIZE 1024
+#define UART0_RX_BUFFER_SIZE 64
+
+// Maximum length of a single formatted message
+#define UART0_PRINTF_BUFFER_SIZE 96
+
+// Number of messages dropped because the transmit buffer was full
+extern volatile uint32_t UART0_TX_Dropped;
+
+// Number of characters lost because the receive buffer was full
+extern volatile uint32_t UART0_RX_Overruns;
+
+/**
+ * @brief Initializes UART0 with µDMA transmit and interrupt-driven receive.
+ *
+ * This function configures PA0 and PA1 as U0RX and U0TX, sets up UART0 for 8 data bits,
+ * no parity and one stop bit (8-N-1) at the specified baud rate, and enables the transmit
+ * and receive FIFOs. It enables the µDMA controller, assigns channel 9 to UART0 TX, and
+ * enables the receive and receive time-out interrupts. The UART0 interrupt is enabled at
+ * level 4 of the priority plan (see Interrupt_Config.h).
+ *
+ * @param baud_rate The baud rate in bits per second.
+ *
+ * @return None
+ */
+void UART0_Init(uint32_t baud_rate);
+
+/**
+ * @brief Queues data for transmission without blocking.
+ *
+ * This function copies the data into the transmit ring buffer and starts a µDMA transfer
+ * if one is not already running. The data is either queued as a whole or dropped as a whole,
+ * in which case UART0_TX_Dropped is incremented. It can be called from any context.
+ *
+ * @param data A pointer to the data to be transmitted.
+ *
+ * @param length The number of bytes to transmit.
+ *
+ * @return The number of bytes queued (either length or 0).
+ */
+uint32_t UART0_Write(const uint8_t *data, uint32_t length);
+
+/**
+ * @brief Queues a null-terminated string for transmission without blocking.
+ *
+ * @param string The string to be transmitted.
+ *
+ * @return The number of bytes queued.
+ */
+uint32_t UART0_Write_String(const char *string);
+
+/**
+ * @brief Formats a message and queues it for transmission without blocking.
+ *
+ * This function formats the message with vsnprintf into a local buffer of
+ * UART0_PRINTF_BUFFER_SIZE bytes and queues it with UART0_Write. Longer messages are truncated.
+ *
+ * @param format The printf-style format string.
+ *
+ * @return The number of bytes queued.
+ */
+uint32_t UART0_Printf(const char *format, ...);
+
+/**
+ * @brief Formats a message from a va_list and queues it for transmission without blocking.
+ *
+ * @param format The printf-style format string.
+ *
+ * @param args The arguments for the format string.
+ *
+ * @return The number of bytes queued.
+ */
+uint32_t UART0_VPrintf(const char *format, va_list args);
+
+/**
+ * @brief Reads a received character without blocking.
+ *
+ * @param character A pointer to where the received character is stored.
+ *
+ * @return 1 if a character was read, or 0 if the receive buffer is empty.
+ */
+uint8_t UART0_Read_Char(char *character);
+
+/**
+ * @brief Returns the number of bytes waiting in the transmit ring buffer.
+ *
+ * @param None
+ *
+ * @return The number of bytes that have not been transmitted yet.
+ */
+uint32_t UART0_TX_Pending(void);
+
+/**
+ * @brief The interrupt service routine (ISR) for UART0.
+ *
+ * This function moves received characters from the receive FIFO into the receive
+ * ring buffer. When µDMA channel 9 has completed a transfer, it releases the transmitted
+ * bytes from the transmit ring buffer and starts the next transfer.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void UART0_Handler(void);
+
+#endif
@@ -1,244 +1,1206 @@
-/**
-#include "TM4C123GH6PM.h"
-#include "PMOD_BTN_Interrupt.h"
-#include "SysTick_Delay.h"
-#include "EduBase_LCD.h"
-
-//Declare the user-defined function prototype for PMOD_BTN_Interrupt
-void PMOD_BTN_Handler(uint8_t pmod_btn_status);
-
-//Declare the user-defined function prototype for EduBase_Button_Interrupt
-void EduBase_Button_Handler(uint8_t edubase_button_status);
-
-//Initialize a global variable for an 8-bit counter
-static uint8_t counter = 0;
-
-static uint8_t milliseconds = 0;
-static uint8_t seconds = 0;
-static uint8_t minutes = 0;
-
-int main(void)
-{
-	//Initialize the push buttons on the PMOD BTN module (Port A)
-	PMOD_BTN_Interrupt_Init(&PMOD_BTN_Handler);
-	
-	//Initialize the SysTick timer used to provide blocking delay function
-	SysTick_Delay_Init();
-	
-	
-}
-
-void PMOD_BTN_Handler(uint8_t pmod_btn_status)
-{
-	switch(pmod_btn_status)
-	{
-		//BTN0 (PA2) is pressed
-		case 0x04:
-		{
-			
-			break;
-		}
-		
-		//BTN1 (PA3) is pressed
-		case 0x08:
-		{
-			
-			break;
-		}
-		
-		//BTN2 (PA4) is pressed
-		case 0x10:
-		{
-			
-			break;
-		}
-		
-		//BTN3 (PA5) is pressed
-		case 0x20:
-		{
-			
-			break;
-		}
-		
-		default:
-		{
-			
-			break;
-		}
-	}
-}
-*/
-
-/**
 #include "TM4C123GH6PM.h"
 #include "PMOD_BTN_Interrupt.h"
 #include "SysTick_Delay.h"
 #include "EduBase_LCD.h"
 #include "MorseDecoder.h"
+#include "Trace_Recorder.h"
+#include "PWM_Clock.h"
+#include "LED_Effects.h"
+#include "LCD_Glyph_Cache.h"
+#include "LCD_Graphics.h"
+#include "UART0.h"
+#include "Console.h"
+#include "Timer_0A_Interrupt.h"
+#include "Input_Event.h"
+#include "EduBase_Button_Interrupt.h"
+#include "PMOD_ENC.h"
+#include "Settings_Store.h"
+#include "Flash_Log.h"
+#include "Audio_Input.h"
+#include "Morse_Classifier.h"
+#include "Seven_Segment_Display.h"
+#include "Seven_Segment_Marquee.h"
+#include "Stopwatch.h"
+#include "uDMA.h"
+#include "LCD_Screens.h"
+#include "Boot_Sequencer.h"
+#include "Stack_Monitor.h"
+#include "App_Framework.h"
+#include "Button_Debounce.h"
+#include "GPTM.h"
+#include "Buzzer.h"
+#include "Stepper_Motor.h"
+#include "Motor_Control.h"
+#include "Input_Replay.h"
+#include "Latency_Trace.h"
+#include "Interrupt_Config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Global variables for timing
+static uint32_t last_press_time = 0;
+static uint8_t symbols_pending = 0;  // Number of symbols keyed for the current character
+static uint8_t audio_symbols = 0;    // Set while the pending symbols come from the Morse classifier
+static uint8_t wpm_shown = 0;        // Set while the keying speed is shown on the second row
+
+// Applications, in the order of the launcher menu
+enum Apps
+{
+    APP_LAUNCHER  = 0,
+    APP_MORSE     = 1,
+    APP_STOPWATCH = 2,
+    APP_NOTES     = 3,
+    APP_STEPPER   = 4,
+    APP_SERVO     = 5
+};
+
+// Peripherals shared by the applications, in the order of the peripheral table
+enum App_Peripherals
+{
+    PERIPHERAL_LCD           = 0,
+    PERIPHERAL_PMOD_BTN      = 1,
+    PERIPHERAL_SEVEN_SEGMENT = 2,
+    PERIPHERAL_BUZZER        = 3,
+    PERIPHERAL_LEDS          = 4,
+    PERIPHERAL_STEPPER       = 5,
+    PERIPHERAL_SERVO         = 6
+};
+
+// Application selected in the launcher menu
+static uint8_t launcher_selection = APP_MORSE;
+
+// Laps shown on the LCD by the stopwatch application
+static uint16_t stopwatch_laps_shown = 0;
+
+// Timer toggling the buzzer while a note is held, and the number of notes played
+static int8_t notes_timer = -1;
+static uint8_t buzzer_level = 0;
+static uint32_t notes_played = 0;
+
+// Position of the stepper motor and the position that it moves to, in steps
+static volatile int32_t stepper_position = 0;
+static volatile int32_t stepper_target = 0;
+static int8_t stepper_timer = -1;
+static int32_t stepper_move_start = 0;
+
+// Angle of the servo on PB6 that the knob sets, in degrees
+static uint16_t servo_angle = SERVO_MAX_ANGLE / 2;
+
+// Runtime parameters exposed through the console
+static int32_t led_brightness = 50;
+static int32_t audio_tone_hz = AUDIO_TONE_HZ;
+static int32_t audio_decoder = MORSE_CLASSIFIER_ADAPTIVE;
+
+// Performance counters reported by the console's stats command
+static volatile uint32_t button_presses = 0;
+static volatile uint32_t decoded_characters = 0;
+
+static void Set_LED_Brightness(int32_t brightness)
+{
+    // Convert the brightness (0 - 100 %) to the master brightness of the RGB LED
+    LED_Effects_Set_Brightness((uint8_t)((brightness * 255) / 100));
+}
+
+static void Set_WPM(int32_t wpm)
+{
+    MorseDecoder_Set_WPM(wpm);
+}
+
+static void Set_Tone(int32_t tone_hz)
+{
+    Audio_Input_Set_Tone((uint32_t)tone_hz);
+}
+
+static void Set_Decoder(int32_t mode)
+{
+    Morse_Classifier_Set_Mode((uint8_t)mode);
+}
+
+static const Console_Parameter console_parameters[] = {
+    { "dot",        &Morse_Timing.dot_threshold,  10, 2000,  0 },
+    { "dash",       &Morse_Timing.dash_threshold, 10, 6000,  0 },
+    { "char_pause", &Morse_Timing.char_pause,     10, 8000,  0 },
+    { "word_pause", &Morse_Timing.word_pause,     10, 20000, 0 },
+    { "wpm",        &Morse_Timing.wpm,            1,  60,    &Set_WPM },
+    { "brightness", &led_brightness,              0,  100,   &Set_LED_Brightness },
+    { "tone",       &audio_tone_hz,               300, 2000, &Set_Tone },
+    { "decoder",    &audio_decoder,               0,  1,     &Set_Decoder }
+};
+
+// Settings kept in the EEPROM, in the same order as the console parameters.
+// New settings must be added at the end of the table
+static const Settings_Definition settings[] = {
+    { &Morse_Timing.dot_threshold,  DOT_THRESHOLD,  10, 2000  },
+    { &Morse_Timing.dash_threshold, DASH_THRESHOLD, 10, 6000  },
+    { &Morse_Timing.char_pause,     CHAR_PAUSE,     10, 8000  },
+    { &Morse_Timing.word_pause,     WORD_PAUSE,     10, 20000 },
+    { &Morse_Timing.wpm,            6,              1,  60    },
+    { &led_brightness,              50,             0,  100   },
+    { &audio_tone_hz,               AUDIO_TONE_HZ,  300, 2000  },
+    { &audio_decoder,               MORSE_CLASSIFIER_ADAPTIVE, 0, 1 }
+};
+
+static void Save_Command(int argc, char *argv[])
+{
+    Settings_Store_Flush();
+    UART0_Printf("settings saved (%lu writes)\r\n", (unsigned long)Settings_Writes);
+}
 
-// SysTick delay initialization
-void SysTick_Delay_Init(void) {
-    SysTick->LOAD = 16000 - 1;  // Load value for 1 ms delay (16 MHz clock)
-    SysTick->VAL = 0;           // Clear current value
-    SysTick->CTRL = 0x5;        // Enable SysTick with system clock
+static void Defaults_Command(int argc, char *argv[])
+{
+    Settings_Store_Reset();
+    
+    // Apply the restored values that drivers keep a copy of
+    Set_LED_Brightness(led_brightness);
+    Set_Tone(audio_tone_hz);
+    Set_Decoder(audio_decoder);
+    UART0_Write_String("settings restored to defaults\r\n");
 }
 
-// SysTick delay function
-void SysTick_Delay(uint32_t delay_ms) {
-    for (uint32_t i = 0; i < delay_ms; i++) {
-        while ((SysTick->CTRL & 0x10000) == 0);  // Wait for COUNT flag
+// Print the most recent records of the message log, oldest first
+static void Log_Command(int argc, char *argv[])
+{
+    uint8_t count = (argc > 1) ? (uint8_t)strtol(argv[1], 0, 0) : 8;
+    Flash_Log_Entry entry;
+    
+    if (count > Flash_Log_Count()) {
+        count = Flash_Log_Count();
+    }
+    
+    for (uint8_t age = count; age > 0; age--) {
+        if (Flash_Log_Read(age - 1, &entry)) {
+            UART0_Printf("#%lu %lu ms: ", (unsigned long)entry.sequence, (unsigned long)entry.start_ms);
+            UART0_Write((const uint8_t *)entry.text, entry.length);
+            UART0_Write_String((entry.flags & FLASH_LOG_CONTINUES) ? "...\r\n" : "\r\n");
+        }
     }
 }
 
-// Global variables for time tracking
-static uint32_t last_press_time = 0;
-static uint32_t current_time = 0;
-
-// Timing thresholds for Morse decoding (in ms)
-#define DOT_THRESHOLD 200
-#define DASH_THRESHOLD 600
-#define CHAR_PAUSE 800
-#define WORD_PAUSE 2000
-
-// PMOD Button interrupt handler
-void PMOD_BTN_Handler(uint8_t pmod_btn_status) {
-    current_time = SysTick->VAL;  // Get current SysTick value
-
-    switch (pmod_btn_status) {
-        // BTN0 (PA2) is pressed - Add a dot (.)
-        case 0x04:
-            MorseDecoder_AddSymbol('.');
-            last_press_time = current_time;
-            break;
+// Show the two most recent laps, newest first
+static void Show_Stopwatch_Laps(void)
+{
+    char text[STOPWATCH_TEXT_SIZE];
+    char line[17];
+    Stopwatch_Lap lap;
+    
+    if (Stopwatch_Lap_Count() == 0) {
+        LCD_Stream_Play(&LCD_SCREEN_STOPWATCH);
+    }
+    else {
+        EduBase_LCD_Clear_Display();
+    }
+    LCD_Glyph_Cache_Begin_Frame();
+    
+    for (uint8_t age = 0; age < 2; age++) {
+        if (Stopwatch_Read_Lap(age, &lap)) {
+            Stopwatch_Format(lap.lap_ticks, text);
+            snprintf(line, sizeof(line), "L%-3u %s", lap.number, text);
+            EduBase_LCD_Set_Cursor(age, 0);
+            EduBase_LCD_Display_String(line);
+        }
+    }
+    
+    stopwatch_laps_shown = Stopwatch_Lap_Count();
+}
 
-        // BTN1 (PA3) is pressed - Add a dash (-)
-        case 0x08:
-            MorseDecoder_AddSymbol('-');
-            last_press_time = current_time;
-            break;
+// Print every lap kept by the stopwatch, oldest first
+static void Laps_Command(int argc, char *argv[])
+{
+    char text[STOPWATCH_TEXT_SIZE];
+    Stopwatch_Lap lap;
+    
+    for (uint8_t age = STOPWATCH_MAX_LAPS; age > 0; age--) {
+        if (Stopwatch_Read_Lap(age - 1, &lap)) {
+            Stopwatch_Format(lap.lap_ticks, text);
+            UART0_Printf("lap %u: %s", lap.number, text);
+            Stopwatch_Format(lap.split_ticks, text);
+            UART0_Printf(" (split %s, %llu ticks)\r\n", text, (unsigned long long)lap.split_ticks);
+        }
+    }
+}
 
-        // BTN2 (PA4) is pressed - Decode and display the current input
-        case 0x10: {
-            char decoded_char = MorseDecoder_Decode();
-            EduBase_LCD_Clear_Display();
-            EduBase_LCD_PrintChar(decoded_char);
-            break;
+// Switch to an application, or list them with the current one marked
+static void App_Command(int argc, char *argv[])
+{
+    if (argc > 1) {
+        int8_t index = App_Framework_Find(argv[1]);
+        
+        if ((index < 0) || !App_Framework_Switch((uint8_t)index)) {
+            UART0_Printf("unknown app: %s\r\n", argv[1]);
         }
+        return;
+    }
+    
+    for (uint8_t i = 0; i < App_Framework_Count(); i++) {
+        UART0_Printf("%c %s\r\n", (i == App_Framework_Current()) ? '*' : ' ', App_Framework_App(i)->name);
+    }
+}
 
-        // BTN3 (PA5) is pressed - Clear the input buffer
-        case 0x20:
-            MorseDecoder_Clear();
-            EduBase_LCD_Clear_Display();
-            break;
+// Record the input events, or print the recorded events
+static void Record_Command(int argc, char *argv[])
+{
+    Input_Event event;
+    
+    if ((argc > 1) && (strcmp(argv[1], "start") == 0)) {
+        Input_Replay_Record_Start();
+    }
+    else if ((argc > 1) && (strcmp(argv[1], "stop") == 0)) {
+        Input_Replay_Record_Stop();
+        UART0_Printf("%u events recorded\r\n", Input_Replay_Count());
+    }
+    else {
+        for (uint16_t i = 0; Input_Replay_Read(i, &event); i++) {
+            UART0_Printf("%lu %u 0x%02X %u %ld\r\n", (unsigned long)event.timestamp_ms, event.source,
+                         event.code, event.type, (long)event.value);
+        }
     }
 }
 
-int main(void) {
-    // Initialize the PMOD BTN module (Port A)
-    PMOD_BTN_Interrupt_Init(&PMOD_BTN_Handler);
+// Replay the recorded events, at the recorded speed by default, or stop the replay
+static void Replay_Command(int argc, char *argv[])
+{
+    uint16_t speed_percent = (argc > 1) ? (uint16_t)strtol(argv[1], 0, 0) : 100;
+    
+    if ((argc > 1) && (strcmp(argv[1], "stop") == 0)) {
+        Input_Replay_Stop();
+    }
+    else if (!Input_Replay_Play(speed_percent, Input_Event_Millis())) {
+        UART0_Write_String("nothing to replay\r\n");
+    }
+}
 
-    // Initialize SysTick
-    SysTick_Delay_Init();
+// Key a text (with '_' for the spaces) through the audio key path of the Morse decoder
+static void Synthesize_Command(int argc, char *argv[])
+{
+    char text[INPUT_REPLAY_TEXT_SIZE];
+    int32_t wpm = (argc > 1) ? strtol(argv[1], 0, 0) : Morse_Timing.wpm;
+    uint8_t jitter_percent = (argc > 2) ? (uint8_t)strtol(argv[2], 0, 0) : 0;
+    uint8_t started;
+    
+    snprintf(text, sizeof(text), "%s", (argc > 3) ? argv[3] : "PARIS_PARIS");
+    for (char *c = text; *c != '\0'; c++) {
+        if (*c == '_') {
+            *c = ' ';
+        }
+    }
+    
+    // The decoded characters are only checked while the Morse decoder is shown
+    if (App_Framework_Current() != APP_MORSE) {
+        App_Framework_Switch(APP_MORSE);
+    }
+    
+    if (strcmp(argv[0], "sweep") == 0) {
+        started = Input_Replay_Sweep(text, wpm, jitter_percent, Input_Event_Millis());
+    }
+    else {
+        started = Input_Replay_Synthesize(text, wpm, jitter_percent, Input_Event_Millis());
+    }
+    
+    if (!started) {
+        UART0_Write_String("replay not started\r\n");
+    }
+}
 
-    // Initialize the LCD
-    EduBase_LCD_Init();
-    EduBase_LCD_Clear_Display();
-    EduBase_LCD_PrintString("Morse Decoder");
+// Scroll a text (with '_' for the spaces) across the seven-segment display of the Morse decoder,
+// until the next character is decoded
+static void Marquee_Command(int argc, char *argv[])
+{
+    char text[SEVEN_SEGMENT_MARQUEE_SIZE];
+    
+    snprintf(text, sizeof(text), "%s", (argc > 1) ? argv[1] : "");
+    for (char *c = text; *c != '\0'; c++) {
+        if (*c == '_') {
+            *c = ' ';
+        }
+    }
+    
+    Seven_Segment_Marquee_Show(text);
+}
 
-    while (1) {
-        // Monitor time for pauses
-        uint32_t elapsed_time = current_time - last_press_time;
+static void Print_Replay_Result(void)
+{
+    const Input_Replay_Result *result = Input_Replay_Get_Result();
+    
+    UART0_Printf("replay: %lu wpm, %lu events, %lu dropped, %lu ms max lag, %lu/%lu decoded, %lu errors, %lu ms\r\n",
+                 (unsigned long)result->wpm, (unsigned long)result->events, (unsigned long)result->dropped,
+                 (unsigned long)result->max_lag_ms, (unsigned long)result->decoded, (unsigned long)result->expected,
+                 (unsigned long)result->errors, (unsigned long)result->duration_ms);
+}
+
+// Print the latency of each stage from an input edge to its decoded character on the LCD, or clear the histograms
+static void Latency_Command(int argc, char *argv[])
+{
+    Latency_Stats stats;
+    
+    if ((argc > 1) && (strcmp(argv[1], "reset") == 0)) {
+        Latency_Trace_Reset();
+        return;
+    }
+    
+    for (uint8_t stage = 0; Latency_Trace_Stats(stage, &stats); stage++) {
+        UART0_Printf("%-8s %5lu spans, p50 %7lu us, p99 %7lu us, max %7lu us\r\n", Latency_Trace_Stage_Name(stage),
+                     (unsigned long)stats.count, (unsigned long)stats.p50_us, (unsigned long)stats.p99_us,
+                     (unsigned long)stats.max_us);
+    }
+}
 
-        if (elapsed_time > CHAR_PAUSE) {
-            char decoded_char = MorseDecoder_Decode();
-            EduBase_LCD_Clear_Display();
-            EduBase_LCD_PrintChar(decoded_char);
+// Print the priority plan with the worst-case blocking time of each interrupt, or clear the blocking times
+static void Irq_Command(int argc, char *argv[])
+{
+    Interrupt_Report report;
+    char irq[8];
+    
+    if ((argc > 1) && (strcmp(argv[1], "reset") == 0)) {
+        Interrupt_Config_Reset();
+        return;
+    }
+    
+    for (uint8_t source = 0; Interrupt_Config_Read(source, &report); source++) {
+        // The timers handed out by the GPTM driver have no IRQ until they are enabled
+        if (report.irq == INTERRUPT_IRQ_NONE) {
+            strcpy(irq, "-");
         }
+        else {
+            snprintf(irq, sizeof(irq), "%d", (int)report.irq);
+        }
+        
+        UART0_Printf("%-16s irq %3s, level %u.%u, %-3s, blocked %6lu us\r\n", report.name, irq,
+                     (unsigned)report.level, (unsigned)report.sub_priority, report.enabled ? "on" : "off",
+                     (unsigned long)report.blocking_us);
     }
 }
-*/
 
-#include "TM4C123GH6PM.h"
-#include "PMOD_BTN_Interrupt.h"
-#include "SysTick_Delay.h"
-#include "EduBase_LCD.h"
-#include "MorseDecoder.h"
+static const Console_Command console_commands[] = {
+    { "save",      "write the settings to the EEPROM now",  &Save_Command },
+    { "defaults",  "restore the default settings",          &Defaults_Command },
+    { "log",       "[count] print the recent messages",     &Log_Command },
+    { "laps",      "print the stopwatch laps",              &Laps_Command },
+    { "app",       "[name] switch to an application",       &App_Command },
+    { "record",    "[start|stop] record or print the input", &Record_Command },
+    { "replay",    "[speed %|stop] replay the recorded input", &Replay_Command },
+    { "synth",     "[wpm] [jitter %] [text] key a text",     &Synthesize_Command },
+    { "sweep",     "[wpm] [jitter %] [text] find the max wpm", &Synthesize_Command },
+    { "latency",   "[reset] print the input to LCD latency", &Latency_Command },
+    { "marquee",   "[text] scroll a text on the 7-segment", &Marquee_Command },
+    { "irq",       "[reset] print the interrupt priorities", &Irq_Command }
+};
 
-// Define Morse timing thresholds (in ms)
-#define DOT_THRESHOLD 200
-#define DASH_THRESHOLD 600
-#define CHAR_PAUSE 800
-#define WORD_PAUSE 2000
+static const Console_Counter console_counters[] = {
+    { "button_presses",     &button_presses },
+    { "decoded_characters", &decoded_characters },
+    { "input_dropped",      &Input_Events_Dropped },
+    { "glyph_hits",         &LCD_Glyph_Hits },
+    { "glyph_uploads",      &LCD_Glyph_Uploads },
+    { "settings_writes",    &Settings_Writes },
+    { "log_records",        &Flash_Log_Records_Written },
+    { "log_dropped",        &Flash_Log_Dropped },
+    { "audio_blocks",       &Audio_Blocks },
+    { "audio_overruns",     &Audio_Overruns },
+    { "audio_cycles_last",  &Audio_Cycles_Last },
+    { "audio_cycles_max",   &Audio_Cycles_Max },
+    { "audio_wpm",          &Morse_Classifier_WPM },
+    { "dma_errors",         &uDMA_Errors },
+    { "boot_input_us",      &Boot_First_Input_us },
+    { "boot_frame_us",      &Boot_First_Frame_us },
+    { "boot_total_us",      &Boot_Total_us },
+    { "stack_used",         &Stack_Max_Used },
+    { "stack_free",         &Stack_Min_Free },
+    { "stack_overflow",     &Stack_Overflowed },
+    { "app_switches",       &App_Switches },
+    { "app_switch_us",      &App_Switch_us },
+    { "replay_max_wpm",     &Input_Replay_Max_WPM }
+};
 
-// Global variables for timing
-static uint32_t last_press_time = 0;
+// Show the symbols keyed for the current character on the second row,
+// then move the cursor back to the decoded text
+static void Add_Symbol(char symbol, uint32_t timestamp_ms)
+{
+    uint8_t text_address = EduBase_LCD_Get_Address();
+    
+    // The first symbol takes the second row back from the keying speed
+    if (wpm_shown) {
+        LCD_Graphics_Put_String(1, 0, "                ");
+        wpm_shown = 0;
+    }
+    
+    MorseDecoder_AddSymbol(symbol);
+    last_press_time = timestamp_ms;
+    
+    if (symbols_pending < 16) {
+        EduBase_LCD_Set_Cursor(1, symbols_pending);
+        LCD_Glyph_Cache_Write((symbol == '.') ? &LCD_GLYPH_MORSE_DOT : &LCD_GLYPH_MORSE_DASH);
+        EduBase_LCD_Send_Command(SET_DDRAM_ADDR | text_address);
+        symbols_pending++;
+    }
+}
+
+static void Clear_Symbols(void)
+{
+    uint8_t text_address = EduBase_LCD_Get_Address();
+    
+    EduBase_LCD_Set_Cursor(1, 0);
+    for (uint8_t i = 0; i < symbols_pending; i++) {
+        EduBase_LCD_Send_Data(' ');
+    }
+    EduBase_LCD_Send_Command(SET_DDRAM_ADDR | text_address);
+    
+    symbols_pending = 0;
+    audio_symbols = 0;
+}
+
+// Show the keying speed and a bar of it on the second row while the knob is turned,
+// then move the cursor back to the decoded text
+static void Show_WPM(void)
+{
+    char text[8] = "   wpm ";
+    int32_t wpm = Morse_Timing.wpm;
+    uint8_t text_address = EduBase_LCD_Get_Address();
+    
+    if (symbols_pending) {
+        return;
+    }
+    
+    // The row has been written without the renderer since it was last shown
+    if (!wpm_shown) {
+        LCD_Graphics_Invalidate();
+        wpm_shown = 1;
+    }
+    
+    text[0] = (wpm >= 10) ? (char)('0' + (wpm / 10)) : ' ';
+    text[1] = (char)('0' + (wpm % 10));
+    
+    LCD_Graphics_Begin_Frame();
+    LCD_Graphics_Put_String(1, 0, text);
+    // A full bar is the highest speed that the console accepts
+    LCD_Graphics_Bar(1, 7, LCD_COLUMNS - 7, (uint32_t)wpm, 60);
+    EduBase_LCD_Send_Command(SET_DDRAM_ADDR | text_address);
+}
+
+static void Decode_Character(void)
+{
+    char decoded_char = MorseDecoder_Decode();
+    Latency_Trace_Decoded();
+    decoded_characters++;
+    Input_Replay_Check(decoded_char);
+    Clear_Symbols();
+    EduBase_LCD_Send_Data(decoded_char);
+    Latency_Trace_Displayed();
+    Flash_Log_Append(decoded_char, Input_Event_Millis());
+    Seven_Segment_Marquee_Append(decoded_char);
+    
+    // Flash the green LED once for every decoded character
+    LED_Effects_Blink(LED_GREEN, 255, 100, 0, 1);
+}
+
+static void Insert_Space(uint32_t timestamp_ms)
+{
+    Input_Replay_Check(' ');
+    EduBase_LCD_Send_Data(' ');
+    Flash_Log_Append(' ', timestamp_ms);
+    Seven_Segment_Marquee_Append(' ');
+}
 
-// PMOD_BTN interrupt handler
-void PMOD_BTN_Handler(uint8_t pmod_btn_status) 
+// Morse key handler, with the codes of BTN0 to BTN3 of the PMOD BTN
+static void Morse_Key_Handler(const Input_Event *event)
 {
-    uint32_t current_time = SysTick->VAL; // Read the current SysTick value
-    uint32_t elapsed_time = current_time - last_press_time;
+    // Time the path from the key to the character that it ends on the LCD
+    Latency_Trace_Begin(event);
+    
+    if (event->type == INPUT_EVENT_PRESS) {
+        button_presses++;
+    }
     
-    switch (pmod_btn_status) {
-			// BTN0 (PA2) pressed - Dot
+    switch (event->code) {
+        // BTN0 (PA2) pressed - Dot
         case 0x04: 
-				{
-						MorseDecoder_AddSymbol('.');
-           // EduBase_LCD_Clear_Display();
-           // EduBase_LCD_Display_String("Dot added: .");
-           // last_press_time = current_time;
+        {
+            if (event->type == INPUT_EVENT_PRESS) {
+                Add_Symbol('.', event->timestamp_ms);
+                audio_symbols = 0;
+            }
+            break;
+        }
+        
+        // BTN1 (PA3) pressed - Dash
+        case 0x08:
+        {
+            if (event->type == INPUT_EVENT_PRESS) {
+                Add_Symbol('-', event->timestamp_ms);
+                audio_symbols = 0;
+            }
+            break;
+        }
+        
+        // BTN2 (PA4) pressed - Decode Morse, double-click - Insert a space
+        case 0x10:
+        {
+            if (event->type == INPUT_EVENT_PRESS && symbols_pending) {
+                Decode_Character();
+            }
+            else if (event->type == INPUT_EVENT_DOUBLE_CLICK) {
+                Insert_Space(event->timestamp_ms);
+            }
+            break;
+        }
+        
+        // BTN3 (PA5) pressed - Clear
+        case 0x20:
+        {
+            if (event->type == INPUT_EVENT_PRESS) {
+                MorseDecoder_Clear();
+                Flash_Log_End_Message();
+                symbols_pending = 0;
+                audio_symbols = 0;
+                wpm_shown = 0;
+                EduBase_LCD_Clear_Display();
+                LCD_Glyph_Cache_Begin_Frame();
+                Seven_Segment_Marquee_Clear();
+            }
+            break;
+        }
+        
+        default:
+        {
+            break;
+        }
+    }
+}
+
+// Morse decoder input: SW5 to SW2 (PD0 to PD3) key like BTN0 to BTN3 of the PMOD BTN,
+// which shares PA2 to PA5 with the LCD. The knob sets the keying speed and its button inserts a space
+static void Morse_Input(const Input_Event *event)
+{
+    if (event->source == INPUT_SOURCE_EDUBASE_BTN) {
+        Input_Event pmod_event = *event;
+        pmod_event.code = (uint8_t)(event->code << 2);
+        Morse_Key_Handler(&pmod_event);
+    }
+    else if (event->type == INPUT_EVENT_ROTATE) {
+        Console_Set_Parameter("wpm", Morse_Timing.wpm + event->value);
+        Show_WPM();
+    }
+    else if ((event->code == PMOD_ENC_BTN) && (event->type == INPUT_EVENT_RELEASE) &&
+             (event->value < BUTTON_LONG_PRESS_MS)) {
+        // Act on a short click only, since holding the button returns to the launcher
+        Insert_Space(event->timestamp_ms);
+    }
+}
+
+// The decoded text also scrolls across the seven-segment display
+static void Morse_Init(void)
+{
+    MorseDecoder_Clear();
+    symbols_pending = 0;
+    audio_symbols = 0;
+    wpm_shown = 0;
+    EduBase_LCD_Clear_Display();
+    LCD_Glyph_Cache_Begin_Frame();
+    Seven_Segment_Marquee_Clear();
+    Seven_Segment_Marquee_Start(SEVEN_SEGMENT_MARQUEE_STEP_MS);
+}
+
+// Decode the pending symbols once the character pause has elapsed. The Morse classifier
+// ends the characters of the audio input itself, with a gap that adapts to the keying speed
+static void Morse_Run(uint32_t now_ms)
+{
+    if (symbols_pending && !audio_symbols &&
+        (now_ms - last_press_time) > (uint32_t)Morse_Timing.char_pause) {
+        Decode_Character();
+    }
+}
+
+// Commit the decoded text to the message log when another application is started
+static void Morse_Teardown(void)
+{
+    Flash_Log_End_Message();
+    Seven_Segment_Marquee_Stop();
+}
+
+// Audio key event handler: the detected tone keys the Morse classifier
+void Audio_Key_Handler(const Input_Event *event)
+{
+    Latency_Trace_Begin(event);
+    
+    if (event->type == INPUT_EVENT_PRESS) {
+        Morse_Classifier_Key(1, event->timestamp_ms);
+    }
+    else if (event->type == INPUT_EVENT_RELEASE) {
+        Morse_Classifier_Key(0, event->timestamp_ms);
+    }
+}
+
+// Morse classifier handler: the classified audio elements are decoded like the button presses
+static void Audio_Morse_Handler(uint8_t event, uint32_t timestamp_ms)
+{
+    // The other applications do not show the decoded text
+    if (App_Framework_Current() != APP_MORSE) {
+        return;
+    }
+    
+    switch (event) {
+        case MORSE_EVENT_DOT:
+        {
+            Add_Symbol('.', timestamp_ms);
+            audio_symbols = 1;
             break;
-				}
-				
-        case 0x08: // BTN1 (PA3) pressed - Dash
-				{
-            MorseDecoder_AddSymbol('-');
-           // EduBase_LCD_Clear_Display();
-           // EduBase_LCD_Display_String("Dash added: -");
-           // last_press_time = current_time;
+        }
+        
+        case MORSE_EVENT_DASH:
+        {
+            Add_Symbol('-', timestamp_ms);
+            audio_symbols = 1;
             break;
-				}
-				
-        case 0x10: // BTN2 (PA4) pressed - Decode Morse
-				{
-            if (elapsed_time > CHAR_PAUSE) {
-                char decoded_char = MorseDecoder_Decode();
-             //   EduBase_LCD_Clear_Display();
-             // EduBase_LCD_Display_String("Decoded: ");
-                EduBase_LCD_Send_Data(decoded_char);
+        }
+        
+        case MORSE_EVENT_CHARACTER_END:
+        {
+            // The classifier may have corrected the symbols or split them into
+            // several characters, so decode its pattern instead of the keyed symbols
+            MorseDecoder_Clear();
+            for (const char *symbol = Morse_Classifier_Pattern(); *symbol != '\0'; symbol++) {
+                MorseDecoder_AddSymbol(*symbol);
             }
-            //last_press_time = current_time;
+            Decode_Character();
             break;
-				}
-				
-        case 0x20: // BTN3 (PA5) pressed - Clear
-				{
-            EduBase_LCD_Clear_Display();
-         //   EduBase_LCD_Display_String("Cleared");
-          //  last_press_time = current_time;
+        }
+        
+        case MORSE_EVENT_WORD_END:
+        {
+            Insert_Space(timestamp_ms);
             break;
-				}
-				
+        }
+        
         default:
-				{
+        {
             break;
-				}
+        }
+    }
+}
+
+// The launcher lists the other applications. The knob or SW5 selects one, and a short
+// press of the knob's button or SW4 starts it. The knob's button starts it when released,
+// so that holding it to return to the launcher does not start the selection again
+static void Launcher_Draw(void)
+{
+    uint8_t count = App_Framework_Count() - 1;
+    char line[17];
+    
+    EduBase_LCD_Clear_Display();
+    LCD_Glyph_Cache_Begin_Frame();
+    
+    for (uint8_t row = 0; row < 2; row++) {
+        const App *app = App_Framework_App(1 + ((launcher_selection - 1 + row) % count));
+        snprintf(line, sizeof(line), "%c %s", (row == 0) ? '>' : ' ', app->name);
+        EduBase_LCD_Set_Cursor(row, 0);
+        EduBase_LCD_Display_String(line);
+    }
+}
+
+static void Launcher_Input(const Input_Event *event)
+{
+    uint8_t count = App_Framework_Count() - 1;
+    int8_t move = 0;
+    
+    if (event->type == INPUT_EVENT_ROTATE) {
+        move = (event->value > 0) ? 1 : -1;
+    }
+    else if ((event->source == INPUT_SOURCE_EDUBASE_BTN) && (event->code == 0x01) &&
+             (event->type == INPUT_EVENT_PRESS)) {
+        move = 1;
+    }
+    else if (((event->source == INPUT_SOURCE_PMOD_ENC) && (event->code == PMOD_ENC_BTN) &&
+              (event->type == INPUT_EVENT_RELEASE) && (event->value < BUTTON_LONG_PRESS_MS)) ||
+             ((event->source == INPUT_SOURCE_EDUBASE_BTN) && (event->code == 0x02) &&
+              (event->type == INPUT_EVENT_PRESS))) {
+        App_Framework_Switch(launcher_selection);
+        return;
+    }
+    
+    if (move != 0) {
+        launcher_selection = 1 + ((launcher_selection - 1 + count + move) % count);
+        Launcher_Draw();
+    }
+}
+
+static void Stopwatch_App_Init(void)
+{
+    Show_Stopwatch_Laps();
+}
+
+// Multiplex the stopwatch digits, and redraw the laps when one is added or they are reset
+static void Stopwatch_App_Run(uint32_t now_ms)
+{
+    Stopwatch_Refresh(now_ms);
+    
+    if (Stopwatch_Lap_Count() != stopwatch_laps_shown) {
+        Show_Stopwatch_Laps();
+    }
+}
+
+// SW5 and SW4 start/stop the stopwatch and record its laps
+static void Stopwatch_App_Input(const Input_Event *event)
+{
+    if ((event->source == INPUT_SOURCE_EDUBASE_BTN) &&
+        (event->code & (STOPWATCH_START_STOP | STOPWATCH_LAP_RESET))) {
+        Stopwatch_Handler(event);
+    }
+}
+
+// The buzzer toggles at twice the frequency of the note
+static void Notes_Toggle(void)
+{
+    buzzer_level ^= BUZZER_ON;
+    Buzzer_Output(buzzer_level);
+}
+
+static void Notes_Init(void)
+{
+    notes_timer = GPTM_Allocate(0);
+    notes_played = 0;
+}
+
+// BTN0 to BTN3 of the PMOD BTN (or SW5 to SW2) play C4, E4, G4 and C5 while they are held
+static void Notes_Input(const Input_Event *event)
+{
+    const double notes[4] = { C4_NOTE, E4_NOTE, G4_NOTE, C5_NOTE };
+    uint8_t code = event->code;
+    
+    if ((notes_timer < 0) || (event->source == INPUT_SOURCE_PMOD_ENC)) {
+        return;
+    }
+    
+    if (event->source == INPUT_SOURCE_EDUBASE_BTN) {
+        code = (uint8_t)(code << 2);
+    }
+    
+    if (event->type == INPUT_EVENT_PRESS) {
+        uint8_t note = (uint8_t)(31 - __CLZ(code)) - 2;
+        
+        GPTM_Start_Periodic((uint8_t)notes_timer, (uint32_t)(notes[note & 0x03] * 2), &Notes_Toggle, INTERRUPT_TONE);
+        LED_Effects_Blink(LED_RED, 255, 100, 0, 1);
+        notes_played++;
+    }
+    else if (event->type == INPUT_EVENT_RELEASE) {
+        GPTM_Stop((uint8_t)notes_timer);
+        buzzer_level = BUZZER_OFF;
+        Buzzer_Output(buzzer_level);
+    }
+}
+
+// Show the number of notes played, one digit every millisecond
+static void Notes_Run(uint32_t now_ms)
+{
+    static uint32_t last_refresh_ms = 0;
+    static uint8_t digit = 0;
+    uint32_t value = notes_played;
+    
+    if (now_ms == last_refresh_ms) {
+        return;
+    }
+    last_refresh_ms = now_ms;
+    
+    for (uint8_t i = 0; i < digit; i++) {
+        value = value / 10;
+    }
+    
+    Seven_Segment_Display_Digit(digit, number_pattern[value % 10]);
+    digit = (digit + 1) & 0x03;
+}
+
+static void Notes_Teardown(void)
+{
+    if (notes_timer >= 0) {
+        GPTM_Release((uint8_t)notes_timer);
+        notes_timer = -1;
+    }
+}
+
+// Show the position and the target on the first row, and the progress of the move
+// as a bar on the second row. Only the cells that changed are written
+static void Stepper_Draw(void)
+{
+    char line[LCD_COLUMNS + 1];
+    int32_t position = stepper_position;
+    int32_t target = stepper_target;
+    uint32_t length = (uint32_t)labs((long)(target - stepper_move_start));
+    uint32_t remaining = (uint32_t)labs((long)(target - position));
+    
+    LCD_Graphics_Begin_Frame();
+    
+    snprintf(line, sizeof(line), "P%7ld T%6ld", (long)position, (long)target);
+    LCD_Graphics_Put_String(0, 0, line);
+    
+    if (length == 0) {
+        LCD_Graphics_Bar(1, 0, LCD_COLUMNS, 1, 1);
+    }
+    else {
+        LCD_Graphics_Bar(1, 0, LCD_COLUMNS, (remaining < length) ? (length - remaining) : 0, length);
+    }
+}
+
+// Move towards the target by one step every 2 ms, from a timer at the highest level
+// of the priority plan so that the steps are not delayed by the other drivers
+static void Stepper_Step(void)
+{
+    int32_t position = stepper_position;
+    
+    if (position == stepper_target) {
+        return;
+    }
+    
+    int8_t direction = (stepper_target > position) ? 1 : -1;
+    Stepper_Motor_Step(direction);
+    stepper_position = position + direction;
+}
+
+static void Stepper_Init(void)
+{
+    LCD_Graphics_Clear();
+    stepper_move_start = stepper_position;
+    Stepper_Draw();
+    
+    stepper_timer = GPTM_Allocate(0);
+    
+    if (stepper_timer >= 0) {
+        GPTM_Start_Periodic((uint8_t)stepper_timer, 500, &Stepper_Step, INTERRUPT_STEPPER);
     }
 }
 
+// Every detent of the knob moves the target by 1/32 of a turn (64 steps of the 28BYJ-48),
+// and its button sets the current position as zero
+static void Stepper_Input(const Input_Event *event)
+{
+    if (event->type == INPUT_EVENT_ROTATE) {
+        // A new move starts from the current position, and turning the knob
+        // during a move extends it
+        if (stepper_position == stepper_target) {
+            stepper_move_start = stepper_position;
+        }
+        
+        stepper_target += event->value * 64;
+        Stepper_Draw();
+    }
+    else if ((event->code == PMOD_ENC_BTN) && (event->type == INPUT_EVENT_RELEASE) &&
+             (event->value < BUTTON_LONG_PRESS_MS)) {
+        // Act on a short click only, since holding the button returns to the launcher.
+        // The step timer must not move the motor between the two writes
+        uint32_t basepri = Interrupt_Lock(INTERRUPT_LEVEL_STEPPER);
+        int32_t position = stepper_position;
+        stepper_target -= position;
+        stepper_position = 0;
+        Interrupt_Unlock(INTERRUPT_LEVEL_STEPPER, basepri);
+        
+        stepper_move_start -= position;
+        
+        Stepper_Draw();
+    }
+}
+
+// Redraw the moving position every 50 ms
+static void Stepper_Run(uint32_t now_ms)
+{
+    static uint32_t last_draw_ms = 0;
+    static int32_t drawn_position = 0;
+    
+    if (((now_ms - last_draw_ms) < 50) || (stepper_position == drawn_position)) {
+        return;
+    }
+    last_draw_ms = now_ms;
+    drawn_position = stepper_position;
+    
+    Stepper_Draw();
+}
+
+static void Stepper_Teardown(void)
+{
+    if (stepper_timer >= 0) {
+        GPTM_Release((uint8_t)stepper_timer);
+        stepper_timer = -1;
+    }
+}
+
+// Show the angle of the servo, a '*' while it is still moving to it, and a bar of the angle
+static void Servo_Draw(void)
+{
+    char line[LCD_COLUMNS + 1];
+    
+    LCD_Graphics_Begin_Frame();
+    
+    snprintf(line, sizeof(line), "Servo %3u deg %c", (unsigned)servo_angle, Motor_Control_Is_Moving() ? '*' : ' ');
+    LCD_Graphics_Put_String(0, 0, line);
+    LCD_Graphics_Bar(1, 0, LCD_COLUMNS, servo_angle, SERVO_MAX_ANGLE);
+}
+
+static void Servo_Init(void)
+{
+    LCD_Graphics_Clear();
+    Motor_Control_Set_Angle(servo_angle);
+    Servo_Draw();
+}
+
+// Every detent of the knob turns the servo by 5 degrees, at the slew rate of the
+// Motor_Control driver, and a click of its button centers it
+static void Servo_Input(const Input_Event *event)
+{
+    int32_t angle = servo_angle;
+    
+    if (event->type == INPUT_EVENT_ROTATE) {
+        angle += event->value * 5;
+    }
+    else if ((event->code == PMOD_ENC_BTN) && (event->type == INPUT_EVENT_RELEASE) &&
+             (event->value < BUTTON_LONG_PRESS_MS)) {
+        angle = SERVO_MAX_ANGLE / 2;
+    }
+    else {
+        return;
+    }
+    
+    if (angle < 0) {
+        angle = 0;
+    }
+    else if (angle > SERVO_MAX_ANGLE) {
+        angle = SERVO_MAX_ANGLE;
+    }
+    
+    servo_angle = (uint16_t)angle;
+    Motor_Control_Set_Angle(servo_angle);
+    Servo_Draw();
+}
+
+// Redraw every 50 ms, which clears the moving mark once the servo has arrived
+static void Servo_Run(uint32_t now_ms)
+{
+    static uint32_t last_draw_ms = 0;
+    
+    if ((now_ms - last_draw_ms) < 50) {
+        return;
+    }
+    last_draw_ms = now_ms;
+    
+    Servo_Draw();
+}
+
+// Release functions of the peripherals, which leave them idle for the next application
+static void LCD_Release(void)
+{
+    // Let the screen in progress end before the data lines are given away
+    LCD_Stream_Wait();
+}
+
+static void Buzzer_Release(void)
+{
+    Buzzer_Output(BUZZER_OFF);
+}
+
+static void Servo_Acquire(void)
+{
+    Motor_Control_Init(MOTOR_CONTROL_SERVO, 0);
+}
+
+static const App_Peripheral app_peripherals[] = {
+    { "lcd",           APP_PINS_PA2_PA5 | APP_PIN_PC6 | APP_PIN_PE0,  &EduBase_LCD_Ports_Init,    &LCD_Release },
+    { "pmod_btn",      APP_PINS_PA2_PA5,                              &PMOD_BTN_Init,             &PMOD_BTN_Release },
+    { "seven_segment", APP_PIN_PB4 | APP_PIN_PB7 | APP_PIN_PC7,      &Seven_Segment_Display_Init, &Seven_Segment_Display_Blank },
+    { "buzzer",        APP_PIN_PC4,                                   &Buzzer_Init,               &Buzzer_Release },
+    { "leds",          APP_PIN_PF1 | APP_PIN_PF2 | APP_PIN_PF3,       &LED_Effects_Claim_Pins,    &LED_Effects_Release_Pins },
+    { "stepper",       APP_PINS_PB0_PB3 | APP_PIN_PF2 | APP_PIN_PF3,  &Stepper_Motor_Init,        &Stepper_Motor_Release },
+    { "servo",         APP_PIN_PB6,                                   &Servo_Acquire,             &Motor_Control_Release }
+};
+
+static const App apps[] = {
+    { "launcher",  APP_PERIPHERAL(PERIPHERAL_LCD) | APP_PERIPHERAL(PERIPHERAL_LEDS),
+      &Launcher_Draw, 0, &Launcher_Input, 0 },
+    { "morse",     APP_PERIPHERAL(PERIPHERAL_LCD) | APP_PERIPHERAL(PERIPHERAL_SEVEN_SEGMENT) | APP_PERIPHERAL(PERIPHERAL_LEDS),
+      &Morse_Init, &Morse_Run, &Morse_Input, &Morse_Teardown },
+    { "stopwatch", APP_PERIPHERAL(PERIPHERAL_LCD) | APP_PERIPHERAL(PERIPHERAL_SEVEN_SEGMENT) | APP_PERIPHERAL(PERIPHERAL_LEDS),
+      &Stopwatch_App_Init, &Stopwatch_App_Run, &Stopwatch_App_Input, 0 },
+    { "notes",     APP_PERIPHERAL(PERIPHERAL_PMOD_BTN) | APP_PERIPHERAL(PERIPHERAL_BUZZER) |
+                   APP_PERIPHERAL(PERIPHERAL_SEVEN_SEGMENT) | APP_PERIPHERAL(PERIPHERAL_LEDS),
+      &Notes_Init, &Notes_Run, &Notes_Input, &Notes_Teardown },
+    { "stepper",   APP_PERIPHERAL(PERIPHERAL_LCD) | APP_PERIPHERAL(PERIPHERAL_STEPPER),
+      &Stepper_Init, &Stepper_Run, &Stepper_Input, &Stepper_Teardown },
+    { "servo",     APP_PERIPHERAL(PERIPHERAL_LCD) | APP_PERIPHERAL(PERIPHERAL_SERVO),
+      &Servo_Init, &Servo_Run, &Servo_Input, 0 }
+};
+
+// Input handler of the buttons and the knob. Holding the knob's button returns to the launcher
+// from any application, and the other events go to the current application
+static void App_Input_Handler(const Input_Event *event)
+{
+    if ((event->source == INPUT_SOURCE_PMOD_ENC) && (event->code == PMOD_ENC_BTN) &&
+        (event->type == INPUT_EVENT_LONG_PRESS)) {
+        App_Framework_Switch(APP_LAUNCHER);
+        return;
+    }
+    
+    App_Framework_Input(event);
+}
+
+// Initialize the input devices and run the input time base and debouncing every 1 ms from Timer 0A.
+// This task runs first, so that presses are queued within microseconds of the start of the boot
+// The PMOD BTN shares PA2 to PA5 with the LCD, and is only started by the applications that use it
+static uint32_t Input_Boot_Step(uint8_t step)
+{
+    EduBase_Button_Interrupt_Init();
+    PMOD_ENC_Init();
+    Timer_0A_Interrupt_Init(&Input_Event_Tick);
+    
+    Input_Event_Subscribe(INPUT_SOURCE_MASK(INPUT_SOURCE_PMOD_BTN) | INPUT_SOURCE_MASK(INPUT_SOURCE_EDUBASE_BTN) |
+                          INPUT_SOURCE_MASK(INPUT_SOURCE_PMOD_ENC), INPUT_ALL_TYPES, &App_Input_Handler);
+    
+    // Synthetic Morse streams are keyed like the tone detected by the audio input
+    Input_Replay_Init(INPUT_SOURCE_AUDIO, AUDIO_TONE);
+    Latency_Trace_Reset();
+    
+    Boot_Mark_First_Input();
+    return BOOT_STEP_DONE;
+}
+
+// Power up the LCD, then show the splash screen from the background.
+// The stream timer is allocated after Timer 0A has been claimed by the input task
+static uint32_t LCD_Boot_Step(uint8_t step)
+{
+    static uint8_t lcd_ready = 0;
+    
+    if (!lcd_ready) {
+        uint32_t wait_us = EduBase_LCD_Init_Step(step);
+        
+        if (wait_us != BOOT_STEP_DONE) {
+            return wait_us;
+        }
+        
+        lcd_ready = 1;
+        LCD_Glyph_Cache_Init();
+        LCD_Graphics_Init();
+        LCD_Stream_Init();
+        LCD_Stream_Play(&LCD_SCREEN_SPLASH);
+    }
+    
+    if (LCD_Stream_Busy()) {
+        return 100;
+    }
+    
+    Boot_Mark_First_Frame();
+    return BOOT_STEP_DONE;
+}
+
+// Time SW5 and SW4 presses with the free-running wide timer, which keeps running while
+// the stopwatch application is not shown. SW5 and SW4 keep their debounced events
+static uint32_t Stopwatch_Boot_Step(uint8_t step)
+{
+    Seven_Segment_Display_Init();
+    Stopwatch_Init();
+    return BOOT_STEP_DONE;
+}
+
+// Load the saved settings before they are applied, and find the end of the message log
+static uint32_t Storage_Boot_Step(uint8_t step)
+{
+    Settings_Store_Init(settings, sizeof(settings) / sizeof(settings[0]));
+    Flash_Log_Init();
+    return BOOT_STEP_DONE;
+}
+
+// Sample the audio input and decode the detected Morse tone starting from the configured timing thresholds
+static uint32_t Audio_Boot_Step(uint8_t step)
+{
+    Morse_Classifier_Init(&Morse_Timing, &Audio_Morse_Handler);
+    Set_Decoder(audio_decoder);
+    Input_Event_Subscribe(INPUT_SOURCE_MASK(INPUT_SOURCE_AUDIO), INPUT_ALL_TYPES, &Audio_Key_Handler);
+    Audio_Input_Init((uint32_t)audio_tone_hz);
+    return BOOT_STEP_DONE;
+}
+
+// Start the RGB LED effects, with the blue LED breathing while the decoder is idle.
+// The master brightness can be set from the console
+static uint32_t LED_Boot_Step(uint8_t step)
+{
+    PWM_Clock_Init();
+    LED_Effects_Init();
+    Set_LED_Brightness(led_brightness);
+    LED_Effects_Breathe(LED_BLUE, 128, 3000);
+    return BOOT_STEP_DONE;
+}
+
+// Start the serial console on the ICDI virtual COM port
+static uint32_t Console_Boot_Step(uint8_t step)
+{
+    UART0_Init(UART0_BAUD_RATE);
+    Console_Register_Counters(console_counters, sizeof(console_counters) / sizeof(console_counters[0]));
+    Console_Init(console_parameters, sizeof(console_parameters) / sizeof(console_parameters[0]),
+                 console_commands, sizeof(console_commands) / sizeof(console_commands[0]));
+    return BOOT_STEP_DONE;
+}
+
+// Boot tasks, started in this order. The tasks below the storage task use the loaded settings
+static const Boot_Task boot_tasks[] = {
+    { "input",     &Input_Boot_Step },
+    { "lcd",       &LCD_Boot_Step },
+    { "stopwatch", &Stopwatch_Boot_Step },
+    { "storage",   &Storage_Boot_Step },
+    { "audio",     &Audio_Boot_Step },
+    { "leds",      &LED_Boot_Step },
+    { "console",   &Console_Boot_Step }
+};
+
 int main(void) {
-    // Initialize hardware components
+    // Paint the unused stack before any interrupt is enabled, to measure its high-water mark
+    Stack_Monitor_Init();
+    
+    // Select the priority grouping before the drivers enable their interrupts
+    Interrupt_Config_Init();
+    
+    // Start the trace recorder first so that the rest of the boot is timestamped
+    Trace_Recorder_Init();
+    
+    // Initialize hardware components. The tasks run interleaved, so the power-up
+    // waits of the LCD overlap the initialization of the other devices
     SysTick_Delay_Init();
-    EduBase_LCD_Init();
-    PMOD_BTN_Interrupt_Init(&PMOD_BTN_Handler);
+    Boot_Sequencer_Run(boot_tasks, sizeof(boot_tasks) / sizeof(boot_tasks[0]));
     
-    // Display welcome message
-		// EduBase_LCD_Display_String("Morse Decoder Ready");
-    EduBase_LCD_Clear_Display();
+    UART0_Printf("Morse Decoder Ready (input %lu us, frame %lu us, boot %lu us)\r\n",
+                 (unsigned long)Boot_First_Input_us, (unsigned long)Boot_First_Frame_us,
+                 (unsigned long)Boot_Total_us);
     
+    // Start the Morse decoder, which clears the splash screen. The LCD, the seven-segment
+    // display and the LEDs have been initialized by the boot tasks
+    App_Framework_Init(app_peripherals, sizeof(app_peripherals) / sizeof(app_peripherals[0]),
+                       apps, sizeof(apps) / sizeof(apps[0]),
+                       APP_PERIPHERAL(PERIPHERAL_LCD) | APP_PERIPHERAL(PERIPHERAL_SEVEN_SEGMENT) |
+                       APP_PERIPHERAL(PERIPHERAL_LEDS));
+    App_Framework_Switch(APP_MORSE);
+
 
     // Infinite loop
     while (1) {
-        // Idle loop for handling asynchronous events
+        // Inject the recorded or synthetic input events that are due, and report a run once it has ended
+        if (Input_Replay_Process(Input_Event_Millis())) {
+            Print_Replay_Result();
+        }
+        
+        // Deliver the queued input events to their handlers
+        Input_Event_Dispatch();
+        
+        // End the characters and words of the audio input
+        Morse_Classifier_Process(Input_Event_Millis());
+        
+        // Run the current application
+        App_Framework_Run(Input_Event_Millis());
+        
+        // Stream recorded trace events out over SWO in the background
+        Trace_Recorder_Drain(8);
+        
+        // Handle commands received on the serial console
+        Console_Process();
+        
+        // Save the changed settings to the EEPROM in the background
+        Settings_Store_Process(Input_Event_Millis());
+        
+        // Commit the decoded text to the message log in the background
+        Flash_Log_Process(Input_Event_Millis());
+        
+        // Update the stack high-water mark reported by the console
+        Stack_Monitor_Process(Input_Event_Millis());
     }
 }
\ No newline at end of file
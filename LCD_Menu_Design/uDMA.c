@@ -0,0 +1,317 @@
+/**
+ * @file uDMA.c
+ *
+ * @brief Source code for the uDMA driver.
+ *
+ * This file contains the function definitions for the uDMA driver.
+ * It keeps track of the claimed channels, builds the control words of the
+ * transfers, and re-arms the ping-pong transfers when they complete.
+ */
+
+#include "uDMA.h"
+#include "Trace_Recorder.h"
+#include "Interrupt_Config.h"
+
+// XFERMODE field (Bits 2 to 0) of the channel control word
+#define UDMA_MODE_MASK 0x07
+#define UDMA_MODE_STOP 0x00
+#define UDMA_MODE_BASIC 0x01
+#define UDMA_MODE_PING_PONG 0x03
+#define UDMA_MODE_PERIPHERAL_SG 0x06
+#define UDMA_MODE_PERIPHERAL_SG_ALTERNATE 0x07
+
+// Address increment that leaves an address unchanged
+#define UDMA_NO_INCREMENT 0x03
+
+typedef struct
+{
+	void (*callback)(uint8_t channel, uint8_t completed);
+
+	// Set while the channel runs a ping-pong transfer, which is re-armed from these values
+	uint8_t ping_pong;
+	volatile void *source_end[2];
+	volatile void *destination_end[2];
+	uint32_t control;
+} UDMA_Channel_State;
+
+// The µDMA control table must be aligned on a 1024-byte boundary.
+// The primary structures are followed by the alternate structures.
+static UDMA_Control_Structure udma_control_table[2 * UDMA_NUM_CHANNELS] __attribute__((aligned(1024)));
+
+static UDMA_Channel_State udma_channels[UDMA_NUM_CHANNELS];
+
+// Bit mask of the claimed channels
+static uint32_t claimed_channels = 0;
+
+static uint8_t udma_initialized = 0;
+
+volatile uint32_t uDMA_Errors = 0;
+
+void uDMA_Init(void)
+{
+	if (udma_initialized) return;
+
+	// Enable the clock to the µDMA module by setting the
+	// R0 bit (Bit 0) in the RCGCDMA register
+	SYSCTL->RCGCDMA |= 0x01;
+	while ((SYSCTL->PRDMA & 0x01) == 0);
+
+	// Enable the µDMA controller by setting the MASTEN bit in the DMACFG register
+	// and point it to the control table
+	UDMA->CFG = 0x01;
+	UDMA->CTLBASE = (uint32_t)udma_control_table;
+
+	// Enable the bus error interrupt. The completion interrupts of the
+	// channels are signalled on the vectors of their peripherals
+	Interrupt_Config_Enable(INTERRUPT_DMA_ERROR);
+
+	udma_initialized = 1;
+}
+
+uint8_t uDMA_Claim(uint16_t assignment, uint8_t attributes, void (*callback)(uint8_t channel, uint8_t completed))
+{
+	uint8_t channel = assignment & 0x1F;
+	uint32_t encoding = (assignment >> 8) & 0x0F;
+	uint32_t bit = 1UL << channel;
+
+	uint32_t basepri = Interrupt_Lock(INTERRUPT_LEVEL_ALL);
+
+	if (claimed_channels & bit)
+	{
+		Interrupt_Unlock(INTERRUPT_LEVEL_ALL, basepri);
+		return 0;
+	}
+
+	claimed_channels |= bit;
+
+	Interrupt_Unlock(INTERRUPT_LEVEL_ALL, basepri);
+
+	uDMA_Init();
+
+	udma_channels[channel].callback = callback;
+	udma_channels[channel].ping_pong = 0;
+
+	UDMA->ENACLR = bit;
+
+	// Each DMACHMAPn register holds the 4-bit encodings of 8 channels
+	volatile uint32_t *map = &UDMA->CHMAP0 + (channel / 8);
+	uint8_t shift = (channel % 8) * 4;
+	*map = (*map & ~(0x0FUL << shift)) | (encoding << shift);
+
+	// Start with the primary control structure and accept the peripheral requests
+	UDMA->ALTCLR = bit;
+	UDMA->REQMASKCLR = bit;
+
+	if (attributes & UDMA_HIGH_PRIORITY)
+	{
+		UDMA->PRIOSET = bit;
+	}
+	else
+	{
+		UDMA->PRIOCLR = bit;
+	}
+
+	if (attributes & UDMA_BURST_ONLY)
+	{
+		UDMA->USEBURSTSET = bit;
+	}
+	else
+	{
+		UDMA->USEBURSTCLR = bit;
+	}
+
+	return 1;
+}
+
+void uDMA_Release(uint8_t channel)
+{
+	uint32_t bit = 1UL << channel;
+
+	UDMA->ENACLR = bit;
+	UDMA->REQMASKSET = bit;
+
+	udma_channels[channel].callback = 0;
+	udma_channels[channel].ping_pong = 0;
+
+	uint32_t basepri = Interrupt_Lock(INTERRUPT_LEVEL_ALL);
+
+	claimed_channels &= ~bit;
+
+	Interrupt_Unlock(INTERRUPT_LEVEL_ALL, basepri);
+}
+
+static uint32_t uDMA_Control_Word(uint16_t count, uint32_t flags, uint32_t mode)
+{
+	uint32_t size = flags & 0x03;
+	uint32_t source_increment = (flags & UDMA_SOURCE_FIXED) ? UDMA_NO_INCREMENT : size;
+	uint32_t destination_increment = (flags & UDMA_DESTINATION_FIXED) ? UDMA_NO_INCREMENT : size;
+	uint32_t arbitration = (flags >> 4) & 0x0F;
+
+	// DSTINC (Bits 31 to 30), DSTSIZE (Bits 29 to 28), SRCINC (Bits 27 to 26), SRCSIZE (Bits 25 to 24),
+	// ARBSIZE (Bits 17 to 14), XFERSIZE (Bits 13 to 4) and XFERMODE (Bits 2 to 0)
+	return (destination_increment << 30) | (size << 28) | (source_increment << 26) | (size << 24) |
+	       (arbitration << 14) | ((uint32_t)(count - 1) << 4) | mode;
+}
+
+// The µDMA controller uses end pointers (address of the last item)
+static volatile void *uDMA_End(volatile const void *start, uint16_t count, uint32_t flags, uint32_t fixed)
+{
+	if (flags & fixed)
+	{
+		return (volatile void *)start;
+	}
+
+	return (volatile void *)((volatile const uint8_t *)start + ((uint32_t)(count - 1) << (flags & 0x03)));
+}
+
+uint8_t uDMA_Basic(uint8_t channel, volatile const void *source, volatile void *destination, uint16_t count, uint32_t flags)
+{
+	if ((count == 0) || (count > UDMA_MAX_TRANSFER)) return 0;
+
+	uint32_t bit = 1UL << channel;
+	UDMA_Control_Structure *primary = uDMA_Primary(channel);
+
+	udma_channels[channel].ping_pong = 0;
+
+	primary->source_end = uDMA_End(source, count, flags, UDMA_SOURCE_FIXED);
+	primary->destination_end = uDMA_End(destination, count, flags, UDMA_DESTINATION_FIXED);
+	primary->control = uDMA_Control_Word(count, flags, UDMA_MODE_BASIC);
+
+	UDMA->ALTCLR = bit;
+	UDMA->ENASET = bit;
+
+	return 1;
+}
+
+uint8_t uDMA_Ping_Pong(uint8_t channel, volatile const void *source, volatile void *buffer_0,
+                       volatile void *buffer_1, uint16_t count, uint32_t flags)
+{
+	if ((count == 0) || (count > UDMA_MAX_TRANSFER)) return 0;
+
+	uint32_t bit = 1UL << channel;
+	UDMA_Channel_State *state = &udma_channels[channel];
+
+	state->source_end[0] = uDMA_End(source, count, flags, UDMA_SOURCE_FIXED);
+	state->source_end[1] = state->source_end[0];
+	state->destination_end[0] = uDMA_End(buffer_0, count, flags, UDMA_DESTINATION_FIXED);
+	state->destination_end[1] = uDMA_End(buffer_1, count, flags, UDMA_DESTINATION_FIXED);
+	state->control = uDMA_Control_Word(count, flags, UDMA_MODE_PING_PONG);
+	state->ping_pong = 1;
+
+	for (uint8_t i = 0; i < 2; i++)
+	{
+		UDMA_Control_Structure *structure = (i == 0) ? uDMA_Primary(channel) : uDMA_Alternate(channel);
+		structure->source_end = state->source_end[i];
+		structure->destination_end = state->destination_end[i];
+		structure->control = state->control;
+	}
+
+	UDMA->ALTCLR = bit;
+	UDMA->ENASET = bit;
+
+	return 1;
+}
+
+void uDMA_Task(UDMA_Control_Structure *task, volatile const void *source, volatile void *destination,
+               uint16_t count, uint32_t flags)
+{
+	task->source_end = uDMA_End(source, count, flags, UDMA_SOURCE_FIXED);
+	task->destination_end = uDMA_End(destination, count, flags, UDMA_DESTINATION_FIXED);
+	task->control = uDMA_Control_Word(count, flags, UDMA_MODE_PERIPHERAL_SG_ALTERNATE);
+	task->unused = 0;
+}
+
+uint8_t uDMA_Scatter_Gather(uint8_t channel, UDMA_Control_Structure *tasks, uint16_t count)
+{
+	if ((count == 0) || (count > 256)) return 0;
+
+	uint32_t bit = 1UL << channel;
+	UDMA_Control_Structure *primary = uDMA_Primary(channel);
+
+	udma_channels[channel].ping_pong = 0;
+
+	// The last task is a basic transfer, which ends the list
+	tasks[count - 1].control = (tasks[count - 1].control & ~UDMA_MODE_MASK) | UDMA_MODE_BASIC;
+
+	// The primary structure copies each 4-word task into the alternate structure,
+	// in 32-bit words with 4 transfers per arbitration
+	primary->source_end = &tasks[count - 1].unused;
+	primary->destination_end = &uDMA_Alternate(channel)->unused;
+	primary->control = (0x2UL << 30) | (0x2UL << 28) | (0x2UL << 26) | (0x2UL << 24) |
+	                   (0x2UL << 14) | ((uint32_t)((count * 4) - 1) << 4) | UDMA_MODE_PERIPHERAL_SG;
+
+	UDMA->ALTCLR = bit;
+	UDMA->ENASET = bit;
+
+	return 1;
+}
+
+uint8_t uDMA_Interrupt(uint8_t channel)
+{
+	uint32_t bit = 1UL << channel;
+	UDMA_Channel_State *state = &udma_channels[channel];
+
+	if ((UDMA->CHIS & bit) == 0) return 0;
+
+	// Acknowledge the µDMA completion interrupt
+	UDMA->CHIS = bit;
+
+	uint8_t completed = UDMA_PRIMARY;
+
+	if (state->ping_pong)
+	{
+		completed = 0;
+
+		// A completed structure has stopped. Re-arm it while the other one runs
+		for (uint8_t i = 0; i < 2; i++)
+		{
+			UDMA_Control_Structure *structure = (i == 0) ? uDMA_Primary(channel) : uDMA_Alternate(channel);
+
+			if ((structure->control & UDMA_MODE_MASK) == UDMA_MODE_STOP)
+			{
+				structure->source_end = state->source_end[i];
+				structure->destination_end = state->destination_end[i];
+				structure->control = state->control;
+				completed |= (i == 0) ? UDMA_PRIMARY : UDMA_ALTERNATE;
+			}
+		}
+
+		// The channel is disabled when both structures completed, so restart it
+		if (completed == (UDMA_PRIMARY | UDMA_ALTERNATE))
+		{
+			UDMA->ALTCLR = bit;
+			UDMA->ENASET = bit;
+		}
+	}
+
+	if (state->callback != 0)
+	{
+		state->callback(channel, completed);
+	}
+
+	return 1;
+}
+
+UDMA_Control_Structure *uDMA_Primary(uint8_t channel)
+{
+	return &udma_control_table[channel];
+}
+
+UDMA_Control_Structure *uDMA_Alternate(uint8_t channel)
+{
+	return &udma_control_table[UDMA_NUM_CHANNELS + channel];
+}
+
+void UDMAERR_Handler(void)
+{
+	TRACE_ISR_ENTER(UDMAERR_IRQn);
+
+	// Read and clear the ERRCLR bit (Bit 0) of the DMAERRCLR register
+	if (UDMA->ERRCLR & 0x01)
+	{
+		UDMA->ERRCLR = 0x01;
+		uDMA_Errors = uDMA_Errors + 1;
+	}
+
+	TRACE_ISR_EXIT(UDMAERR_IRQn);
+}
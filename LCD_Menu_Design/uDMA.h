@@ -0,0 +1,244 @@
+/**
+ * @file uDMA.h
+ *
+ * @brief Header file for the uDMA driver.
+ *
+ * This file contains the function definitions for the uDMA driver.
+ * It owns the µDMA control table shared by every driver that uses µDMA, assigns the
+ * channels to their peripherals, and starts the transfers.
+ *
+ * The control table holds a primary and an alternate control structure for each
+ * of the 32 channels. A channel is claimed with the peripheral that requests it (see the
+ * UDMA_ASSIGNMENT values), and then runs:
+ *  - Basic transfers      One block, requested by the peripheral
+ *  - Ping-pong transfers  Two buffers filled or emptied in turn. A completed buffer is
+ *                         re-armed by the driver before its callback is called
+ *  - Scatter-gather       A list of tasks, each a block with its own source, destination
+ *                         and size, run in order from a single request by the peripheral
+ *
+ * The completion interrupt of a peripheral channel is signalled on the vector of the
+ * peripheral, so its interrupt service routine calls uDMA_Interrupt to run the callback.
+ *
+ * @note Refer to Table 9-1 (µDMA Channel Assignments) on page 587 of the
+ * TM4C123G Microcontroller Datasheet for the channel encodings.
+ */
+
+#ifndef UDMA_H
+#define UDMA_H
+
+#include "TM4C123GH6PM.h"
+
+// Number of µDMA channels
+#define UDMA_NUM_CHANNELS 32
+
+// Maximum number of items that a single µDMA transfer can move
+#define UDMA_MAX_TRANSFER 1024
+
+// Channel number and encoding of a peripheral request
+#define UDMA_ASSIGNMENT(channel, encoding) (((encoding) << 8) | (channel))
+
+#define UDMA_UART0_RX UDMA_ASSIGNMENT(8, 0)
+#define UDMA_UART0_TX UDMA_ASSIGNMENT(9, 0)
+#define UDMA_SSI0_RX UDMA_ASSIGNMENT(10, 0)
+#define UDMA_SSI0_TX UDMA_ASSIGNMENT(11, 0)
+#define UDMA_SSI2_RX UDMA_ASSIGNMENT(12, 2)
+#define UDMA_SSI2_TX UDMA_ASSIGNMENT(13, 2)
+#define UDMA_ADC0_SS0 UDMA_ASSIGNMENT(14, 0)
+#define UDMA_ADC0_SS3 UDMA_ASSIGNMENT(17, 0)
+#define UDMA_TIMER0A UDMA_ASSIGNMENT(18, 0)
+#define UDMA_TIMER0B UDMA_ASSIGNMENT(19, 0)
+#define UDMA_TIMER1A UDMA_ASSIGNMENT(20, 0)
+#define UDMA_TIMER1B UDMA_ASSIGNMENT(21, 0)
+
+// Channel attributes of uDMA_Claim
+#define UDMA_HIGH_PRIORITY 0x01
+#define UDMA_BURST_ONLY 0x02
+
+// Item size and address increments of a transfer
+#define UDMA_SIZE_8 0x00
+#define UDMA_SIZE_16 0x01
+#define UDMA_SIZE_32 0x02
+#define UDMA_SOURCE_FIXED 0x04
+#define UDMA_DESTINATION_FIXED 0x08
+
+// Number of items moved per arbitration, as a power of two (0 to 10)
+#define UDMA_ARBITRATE(log2_items) ((log2_items) << 4)
+
+// Control structures that completed, as passed to the callbacks
+#define UDMA_PRIMARY 0x01
+#define UDMA_ALTERNATE 0x02
+
+typedef struct
+{
+	volatile void *source_end;
+	volatile void *destination_end;
+	volatile uint32_t control;
+	uint32_t unused;
+} UDMA_Control_Structure;
+
+// Number of transfers stopped by a bus error since reset
+extern volatile uint32_t uDMA_Errors;
+
+/**
+ * @brief Enables the µDMA controller and points it to the control table.
+ *
+ * This function can be called by every driver that uses µDMA. Only the first call
+ * configures the controller.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void uDMA_Init(void);
+
+/**
+ * @brief Claims a channel and assigns it to a peripheral.
+ *
+ * The channel is mapped to the encoding of the assignment, uses its primary control
+ * structure, and accepts both single and burst requests unless UDMA_BURST_ONLY is set.
+ *
+ * @param assignment The channel and encoding of the peripheral (e.g. UDMA_UART0_TX).
+ *
+ * @param attributes UDMA_HIGH_PRIORITY and/or UDMA_BURST_ONLY, or 0.
+ *
+ * @param callback A pointer to the function called when a transfer completes, with the
+ *                 channel and the UDMA_PRIMARY / UDMA_ALTERNATE structures that completed,
+ *                 or 0 if no callback is needed.
+ *
+ * @return 1 if the channel was claimed, or 0 if it is already in use.
+ */
+uint8_t uDMA_Claim(uint16_t assignment, uint8_t attributes, void (*callback)(uint8_t channel, uint8_t completed));
+
+/**
+ * @brief Disables a channel and makes it available again.
+ *
+ * The requests of the peripheral are masked until the channel is claimed again.
+ *
+ * @param channel The µDMA channel number (0 to 31).
+ *
+ * @return None
+ */
+void uDMA_Release(uint8_t channel);
+
+/**
+ * @brief Starts a basic transfer.
+ *
+ * The channel moves the items as the peripheral requests them.
+ *
+ * @param channel A claimed channel.
+ *
+ * @param source A pointer to the first item to read.
+ *
+ * @param destination A pointer to where the first item is written.
+ *
+ * @param count The number of items (1 to UDMA_MAX_TRANSFER).
+ *
+ * @param flags The item size, the fixed addresses and the arbitration size.
+ *
+ * @return 1 if the transfer was started, or 0 if the count is out of range.
+ */
+uint8_t uDMA_Basic(uint8_t channel, volatile const void *source, volatile void *destination, uint16_t count, uint32_t flags);
+
+/**
+ * @brief Starts a continuous ping-pong transfer from a peripheral into two buffers.
+ *
+ * The primary structure fills the first buffer and the alternate structure fills the
+ * second. Each completed structure is re-armed by uDMA_Interrupt before the callback is
+ * called, so the transfer runs until uDMA_Release. If both structures completed, items
+ * were lost and the channel is restarted with the primary structure.
+ *
+ * @param channel A claimed channel.
+ *
+ * @param source A pointer to the peripheral register that is read.
+ *
+ * @param buffer_0 A pointer to the buffer filled by the primary structure.
+ *
+ * @param buffer_1 A pointer to the buffer filled by the alternate structure.
+ *
+ * @param count The number of items of each buffer (1 to UDMA_MAX_TRANSFER).
+ *
+ * @param flags The item size, the fixed addresses and the arbitration size.
+ *
+ * @return 1 if the transfer was started, or 0 if the count is out of range.
+ */
+uint8_t uDMA_Ping_Pong(uint8_t channel, volatile const void *source, volatile void *buffer_0,
+                       volatile void *buffer_1, uint16_t count, uint32_t flags);
+
+/**
+ * @brief Fills in a task of a scatter-gather list.
+ *
+ * @param task A pointer to the task in the list.
+ *
+ * @param source A pointer to the first item to read.
+ *
+ * @param destination A pointer to where the first item is written.
+ *
+ * @param count The number of items (1 to UDMA_MAX_TRANSFER).
+ *
+ * @param flags The item size, the fixed addresses and the arbitration size.
+ *
+ * @return None
+ */
+void uDMA_Task(UDMA_Control_Structure *task, volatile const void *source, volatile void *destination,
+               uint16_t count, uint32_t flags);
+
+/**
+ * @brief Starts a peripheral scatter-gather transfer.
+ *
+ * The primary structure copies each task into the alternate structure, which then moves
+ * the items of the task as the peripheral requests them. The callback is called once
+ * after the last task. The list must stay in memory until then.
+ *
+ * @param channel A claimed channel.
+ *
+ * @param tasks A pointer to the list of tasks filled in by uDMA_Task.
+ *
+ * @param count The number of tasks (1 to 256).
+ *
+ * @return 1 if the transfer was started, or 0 if the count is out of range.
+ */
+uint8_t uDMA_Scatter_Gather(uint8_t channel, UDMA_Control_Structure *tasks, uint16_t count);
+
+/**
+ * @brief Acknowledges a completed transfer and calls the callback of the channel.
+ *
+ * This function is called by the interrupt service routine of the peripheral that
+ * requests the channel.
+ *
+ * @param channel The µDMA channel number (0 to 31).
+ *
+ * @return 1 if the channel had completed a transfer, or 0 otherwise.
+ */
+uint8_t uDMA_Interrupt(uint8_t channel);
+
+/**
+ * @brief Returns the primary control structure of a channel.
+ *
+ * @param channel The µDMA channel number (0 to 31).
+ *
+ * @return A pointer to the control structure.
+ */
+UDMA_Control_Structure *uDMA_Primary(uint8_t channel);
+
+/**
+ * @brief Returns the alternate control structure of a channel.
+ *
+ * @param channel The µDMA channel number (0 to 31).
+ *
+ * @return A pointer to the control structure.
+ */
+UDMA_Control_Structure *uDMA_Alternate(uint8_t channel);
+
+/**
+ * @brief The interrupt service routine (ISR) for µDMA bus errors.
+ *
+ * This function clears the error and counts it in uDMA_Errors. The channel that
+ * caused the error is disabled by the controller.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void UDMAERR_Handler(void);
+
+#endif